@@ -1,4 +1,4 @@
 #
 TEMPLATE = subdirs
 CONFIG   += ordered
-SUBDIRS  += qextserialport qdlt src plugin
+SUBDIRS  += qextserialport qdlt src plugin tests
@@ -13,6 +13,7 @@ echo Setting up environment for DLT Viewer SDK...
 set SDK_DIR=c:\DltViewerSDK
 set PWD=%~dp0
 set MINGW_DIR=C:\MinGW
+if "%ZLIB_DIR%"=="" set ZLIB_DIR=C:\zlib
 set SOURCE_DIR=%PWD%
 set BUILD_DIR=%PWD%build\release
 
@@ -51,6 +52,7 @@ copy %QTDIR%\bin\QtNetwork4.dll %SDK_DIR%
 copy %QTDIR%\bin\QtSql4.dll %SDK_DIR%
 copy %QTDIR%\bin\QtSvg4.dll %SDK_DIR%
 copy %QTDIR%\bin\QtXml4.dll %SDK_DIR%
+if exist %ZLIB_DIR%\bin\zlib1.dll copy %ZLIB_DIR%\bin\zlib1.dll %SDK_DIR%
 
 copy %BUILD_DIR%\dlt_viewer.exe %SDK_DIR%
 copy %BUILD_DIR%\qextserialport.dll %SDK_DIR%
@@ -59,6 +61,7 @@ copy %BUILD_DIR%\qdlt.dll %SDK_DIR%
 copy %BUILD_DIR%\plugins\dltviewerplugin.dll %SDK_DIR%\plugins
 copy %BUILD_DIR%\plugins\nonverboseplugin.dll %SDK_DIR%\plugins
 copy %BUILD_DIR%\plugins\filetransferplugin.dll %SDK_DIR%\plugins
+copy %BUILD_DIR%\plugins\signalplugin.dll %SDK_DIR%\plugins
 
 
 copy %SOURCE_DIR%\ReleaseNotes_Viewer.txt %SDK_DIR%
@@ -89,6 +92,7 @@ copy %SOURCE_DIR%\sdk\dummycontrolplugin.pro %SDK_DIR%\sdk\src\dummycontrolplugi
 
 copy %SOURCE_DIR%\plugin\examples\nonverboseplugin_configuration.xml %SDK_DIR%\plugins\examples
 copy %SOURCE_DIR%\plugin\examples\filetransferplugin_configuration.xml %SDK_DIR%\plugins\examples
+copy %SOURCE_DIR%\plugin\examples\signalplugin_configuration.xml %SDK_DIR%\plugins\examples
 
 echo *************************
 echo * Finish                *
@@ -0,0 +1,24 @@
+TEMPLATE  = app
+TARGET    = dlt-bench
+
+CONFIG   += console
+CONFIG   -= app_bundle
+QT       += network
+
+CONFIG(debug, debug|release) {
+    QMAKE_LIBDIR += ../../debug
+    LIBS += -lqdltd
+}
+else {
+    QMAKE_LIBDIR += ../../release
+    LIBS += -lqdlt
+}
+
+# Defines and Header Directories
+DEFINES  += QT_VIEWER
+
+INCLUDEPATH += ../../qdlt \
+            ../../qextserialport/src
+
+# Project files
+SOURCES += main.cpp
@@ -0,0 +1,629 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file main.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+/* Generate a reproducible synthetic DLT file and measure the throughput of
+   indexing, parsing, filtering, searching, ASCII export and appending through
+   the QDltFile and QDltMsg interfaces. The results can be written as JSON, so
+   the numbers of different builds can be compared.
+
+   Usage: dlt-bench [options]
+     -s size      size of the generated file in MB (default 64)
+     -r seed      seed of the generator (default 1)
+     -m mean      mean payload size in bytes, exponentially distributed (default 80)
+     -M max       maximum payload size in bytes (default 1024)
+     -n percent   share of non-verbose messages (default 20)
+     -e count     number of ECU ids (default 1)
+     -a count     number of application ids (default 20)
+     -c count     number of context ids per application (default 5)
+     -t types     argument types of verbose messages (default strg,uint,sint,floa,bool,rawd)
+     -k file      keep the generated file with this name
+     -i file      use an existing file instead of generating one
+     -o file      write the results as JSON to this file
+     -p           add the profiler counters to the results
+*/
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QStringList>
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "qdlt.h"
+
+extern "C"
+{
+    #include "dlt_common.h"
+}
+
+/* Number of messages written at once by the append benchmark. */
+static const int DLT_BENCH_APPEND_CHUNK = 1000;
+
+/* Settings of the generated corpus. */
+typedef struct
+{
+    qint64 size;
+    quint64 seed;
+    int meanPayload;
+    int maxPayload;
+    int nonVerbose;
+    int ecus;
+    int apids;
+    int ctids;
+    QStringList types;
+} DltBenchCorpus;
+
+/* Result of one benchmark. */
+typedef struct
+{
+    QString name;
+    qint64 nsecs;
+    qint64 messages;
+    qint64 bytes;
+} DltBenchResult;
+
+/* xorshift64* generator, the corpus must not depend on the rand() of the platform */
+class DltBenchRandom
+{
+public:
+    DltBenchRandom(quint64 seed) : state(seed ? seed : 0x9e3779b97f4a7c15ULL) {}
+
+    quint64 next()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545f4914f6cdd1dULL;
+    }
+
+    /* uniform number in [0,max) */
+    int below(int max) { return (int)(next() % (quint64)max); }
+
+    /* uniform number in [0,1) */
+    double real() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+    quint64 state;
+};
+
+static void appendU8(QByteArray &buf,quint8 value)
+{
+    buf.append((char)value);
+}
+
+static void appendU16(QByteArray &buf,quint16 value,bool bigEndian = false)
+{
+    if(bigEndian)
+        value = DLT_SWAP_16(value);
+    buf.append((const char*)&value,sizeof(value));
+}
+
+static void appendU32(QByteArray &buf,quint32 value,bool bigEndian = false)
+{
+    if(bigEndian)
+        value = DLT_SWAP_32(value);
+    buf.append((const char*)&value,sizeof(value));
+}
+
+static void appendId(QByteArray &buf,const QByteArray &id)
+{
+    char data[DLT_ID_SIZE] = {0,0,0,0};
+    memcpy(data,id.constData(),qMin(id.size(),DLT_ID_SIZE));
+    buf.append(data,DLT_ID_SIZE);
+}
+
+/* Words the string arguments are built from, "error" is used by the search benchmark. */
+static const char *dltBenchWords[] = { "init", "start", "stop", "value", "state", "timeout", "received",
+                                       "sent", "buffer", "error", "connected", "request", "response", "done" };
+
+/* Append one verbose argument of the given type. */
+static void appendArgument(QByteArray &payload,const QString &type,DltBenchRandom &random)
+{
+    if(type == "strg")
+    {
+        QByteArray text;
+        int words = 1 + random.below(6);
+        for(int num=0;num<words;num++)
+        {
+            if(num)
+                text += ' ';
+            text += dltBenchWords[random.below(sizeof(dltBenchWords)/sizeof(dltBenchWords[0]))];
+        }
+        appendU32(payload,DLT_TYPE_INFO_STRG);
+        appendU16(payload,text.size()+1);
+        payload += text;
+        appendU8(payload,0);
+    }
+    else if(type == "uint")
+    {
+        appendU32(payload,DLT_TYPE_INFO_UINT | DLT_TYLE_32BIT);
+        appendU32(payload,(quint32)random.next());
+    }
+    else if(type == "sint")
+    {
+        quint64 value = random.next();
+        appendU32(payload,DLT_TYPE_INFO_SINT | DLT_TYLE_64BIT);
+        payload.append((const char*)&value,sizeof(value));
+    }
+    else if(type == "floa")
+    {
+        double value = (random.real() - 0.5) * 1e6;
+        appendU32(payload,DLT_TYPE_INFO_FLOA | DLT_TYLE_64BIT);
+        payload.append((const char*)&value,sizeof(value));
+    }
+    else if(type == "bool")
+    {
+        appendU32(payload,DLT_TYPE_INFO_BOOL | DLT_TYLE_8BIT);
+        appendU8(payload,random.below(2));
+    }
+    else /* rawd */
+    {
+        int size = 1 + random.below(32);
+        appendU32(payload,DLT_TYPE_INFO_RAWD);
+        appendU16(payload,size);
+        for(int num=0;num<size;num++)
+            appendU8(payload,random.below(256));
+    }
+}
+
+/* Append one complete message including storage header. */
+static void appendMessage(QByteArray &buf,const DltBenchCorpus &corpus,DltBenchRandom &random,quint32 number)
+{
+    QByteArray ecuid = QString("E%1").arg(random.below(corpus.ecus)).toAscii();
+    int apid = random.below(corpus.apids);
+    QByteArray apidText = QString("A%1").arg(apid).toAscii();
+    QByteArray ctidText = QString("C%1").arg(apid * corpus.ctids + random.below(corpus.ctids)).toAscii();
+    bool verbose = random.below(100) >= corpus.nonVerbose;
+
+    /* payload size is exponentially distributed, most messages are short */
+    int target = (int)(-log(1.0 - random.real()) * corpus.meanPayload);
+    target = qBound(4,target,corpus.maxPayload);
+
+    QByteArray payload;
+    int arguments = 0;
+    if(verbose)
+    {
+        do
+        {
+            appendArgument(payload,corpus.types[random.below(corpus.types.size())],random);
+            arguments++;
+        }
+        while(payload.size() < target && arguments < 255);
+    }
+    else
+    {
+        appendU32(payload,random.below(1000));
+        for(int num=4;num<target;num++)
+            appendU8(payload,random.below(256));
+    }
+
+    /* storage header, one message every millisecond */
+    buf.append("DLT\x01",4);
+    appendU32(buf,1300000000 + number / 1000);
+    appendU32(buf,(number % 1000) * 1000);
+    appendId(buf,ecuid);
+
+    /* standard header with ECU id, timestamp and extended header */
+    int length = sizeof(DltStandardHeader) + DLT_ID_SIZE + sizeof(quint32) + sizeof(DltExtendedHeader) + payload.size();
+    appendU8(buf,DLT_HTYP_PROTOCOL_VERSION1 | DLT_HTYP_UEH | DLT_HTYP_WEID | DLT_HTYP_WTMS);
+    appendU8(buf,number & 0xff);
+    appendU16(buf,length,true);
+    appendId(buf,ecuid);
+    appendU32(buf,number * 10,true);
+
+    /* extended header, log messages with log level fatal to verbose */
+    quint8 msin = (DLT_TYPE_LOG << DLT_MSIN_MSTP_SHIFT) | ((1 + random.below(6)) << DLT_MSIN_MTIN_SHIFT);
+    if(verbose)
+        msin |= DLT_MSIN_VERB;
+    appendU8(buf,msin);
+    appendU8(buf,verbose ? arguments : 0);
+    appendId(buf,apidText);
+    appendId(buf,ctidText);
+
+    buf += payload;
+}
+
+/* Write the corpus file, returns the number of messages. */
+static qint64 generateCorpus(const QString &filename,const DltBenchCorpus &corpus)
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return -1;
+
+    DltBenchRandom random(corpus.seed);
+    QByteArray buf;
+    qint64 written = 0;
+    quint32 number = 0;
+
+    while(written < corpus.size)
+    {
+        buf.clear();
+        while(buf.size() < 1024 * 1024 && written + buf.size() < corpus.size)
+            appendMessage(buf,corpus,random,number++);
+        if(file.write(buf) != buf.size())
+            return -1;
+        written += buf.size();
+    }
+
+    file.close();
+    return number;
+}
+
+static void printResult(const DltBenchResult &result)
+{
+    double seconds = result.nsecs / 1e9;
+    printf("%-10s %10.3f s %12.0f msg/s %10.1f MB/s\n", qPrintable(result.name), seconds,
+           seconds > 0 ? result.messages / seconds : 0.0,
+           seconds > 0 ? result.bytes / seconds / (1024 * 1024) : 0.0);
+}
+
+static bool benchIndex(const QString &filename,QDltFile &file,DltBenchResult &result)
+{
+    QElapsedTimer timer;
+
+    timer.start();
+    if(!file.open(filename) || !file.createIndex())
+        return false;
+    result.nsecs = timer.nsecsElapsed();
+    result.messages = file.size();
+    result.bytes = QFileInfo(filename).size();
+
+    return true;
+}
+
+static void benchParse(QDltFile &file,DltBenchResult &result)
+{
+    QElapsedTimer timer;
+    QDltMsg msg;
+    QByteArray buf;
+    qint64 arguments = 0;
+
+    result.bytes = 0;
+    timer.start();
+    for(int num=0;num<file.size();num++)
+    {
+        buf = file.getMsg(num);
+        msg.setMsg(buf);
+        arguments += msg.sizeArguments();
+        result.bytes += buf.size();
+    }
+    result.nsecs = timer.nsecsElapsed();
+    result.messages = file.size();
+
+    printf("parse: %lld arguments\n", (long long)arguments);
+}
+
+static void benchFilter(QDltFile &file,const DltBenchCorpus &corpus,DltBenchResult &result)
+{
+    QDltFilter filter;
+    QElapsedTimer timer;
+
+    /* one context filter and one payload filter, like typical viewer filters */
+    filter.ecuid.clear();
+    filter.apid = "A0";
+    filter.ctid = "C0";
+    filter.header.clear();
+    filter.payload.clear();
+    filter.enableFilter = true;
+    filter.enableEcuid = false;
+    filter.enableApid = true;
+    filter.enableCtid = true;
+    filter.enableHeader = false;
+    filter.enablePayload = false;
+    filter.enableCtrlMsgs = false;
+    filter.enableLogLevelMax = false;
+    filter.enableLogLevelMin = false;
+    filter.logLevelMax = 0;
+    filter.logLevelMin = 0;
+    file.addPFilter(filter);
+
+    filter.apid = QString("A%1").arg(corpus.apids - 1);
+    filter.enableCtid = false;
+    filter.payload = "timeout";
+    filter.enablePayload = true;
+    file.addPFilter(filter);
+
+    file.enableFilter(true);
+
+    timer.start();
+    file.createIndexFilter();
+    result.nsecs = timer.nsecsElapsed();
+    result.messages = file.size();
+    result.bytes = 0;
+
+    printf("filter: %d of %d messages\n", file.sizeFilter(), file.size());
+
+    file.enableFilter(false);
+    file.clearFilter();
+    file.createIndexFilter();
+}
+
+static void benchSearch(QDltFile &file,DltBenchResult &result)
+{
+    QElapsedTimer timer;
+    QDltMsg msg;
+    QString text;
+    int found = 0;
+
+    /* search the same way the search dialog does, in the header and payload text */
+    timer.start();
+    for(int num=0;num<file.size();num++)
+    {
+        msg.setMsg(file.getMsg(num));
+        text.clear();
+        msg.toStringHeader(text);
+        text += QLatin1Char(' ');
+        msg.toStringPayload(text);
+        if(text.contains("buffer error",Qt::CaseInsensitive))
+            found++;
+    }
+    result.nsecs = timer.nsecsElapsed();
+    result.messages = file.size();
+    result.bytes = 0;
+
+    printf("search: %d matches\n", found);
+}
+
+static bool benchExport(QDltFile &file,const QString &filename,DltBenchResult &result)
+{
+    QElapsedTimer timer;
+    QDltMsg msg;
+    QString text;
+    QFile out(filename);
+
+    if(!out.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    timer.start();
+    for(int num=0;num<file.size();num++)
+    {
+        msg.setMsg(file.getMsg(num));
+        text.clear();
+        QDlt::appendNumber(text,num);
+        text += QLatin1Char(' ');
+        msg.toStringHeader(text);
+        text += QLatin1Char(' ');
+        msg.toStringPayload(text);
+        text += QLatin1Char('\n');
+        out.write(text.toAscii());
+    }
+    out.close();
+    result.nsecs = timer.nsecsElapsed();
+    result.messages = file.size();
+    result.bytes = QFileInfo(filename).size();
+
+    return true;
+}
+
+static bool benchAppend(QDltFile &source,const QString &filename,DltBenchResult &result)
+{
+    QElapsedTimer timer;
+    QDltFile file;
+    QFile out(filename);
+    QByteArray buf;
+
+    /* the log file grows in chunks and the index is updated, like in live mode */
+    if(!out.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    if(!file.open(filename))
+        return false;
+
+    result.bytes = 0;
+    timer.start();
+    for(int num=0;num<source.size();num+=DLT_BENCH_APPEND_CHUNK)
+    {
+        buf.clear();
+        int end = qMin(num + DLT_BENCH_APPEND_CHUNK,source.size());
+        for(int msg=num;msg<end;msg++)
+            buf += source.getMsg(msg);
+        out.write(buf);
+        out.flush();
+        file.updateIndex();
+        result.bytes += buf.size();
+    }
+    result.nsecs = timer.nsecsElapsed();
+    result.messages = file.size();
+
+    file.close();
+    out.close();
+
+    return result.messages == source.size();
+}
+
+static QByteArray resultsToJson(const DltBenchCorpus &corpus,const QString &filename,const QList<DltBenchResult> &results,bool profiler)
+{
+    QString text;
+
+    text += "{\n  \"corpus\": {\n";
+    text += QString("    \"file\": \"%1\",\n").arg(QFileInfo(filename).fileName());
+    text += QString("    \"bytes\": %1,\n").arg(QFileInfo(filename).size());
+    text += QString("    \"seed\": %1,\n").arg(corpus.seed);
+    text += QString("    \"meanPayload\": %1,\n").arg(corpus.meanPayload);
+    text += QString("    \"maxPayload\": %1,\n").arg(corpus.maxPayload);
+    text += QString("    \"nonVerbosePercent\": %1,\n").arg(corpus.nonVerbose);
+    text += QString("    \"ecus\": %1,\n").arg(corpus.ecus);
+    text += QString("    \"apids\": %1,\n").arg(corpus.apids);
+    text += QString("    \"ctids\": %1,\n").arg(corpus.ctids);
+    text += QString("    \"types\": \"%1\"\n").arg(corpus.types.join(","));
+    text += "  },\n  \"results\": [\n";
+    for(int num=0;num<results.size();num++)
+    {
+        const DltBenchResult &result = results[num];
+        double seconds = result.nsecs / 1e9;
+        text += QString("    { \"name\": \"%1\", \"nsecs\": %2, \"messages\": %3, \"bytes\": %4, "
+                        "\"messagesPerSecond\": %5, \"bytesPerSecond\": %6 }")
+                .arg(result.name).arg(result.nsecs).arg(result.messages).arg(result.bytes)
+                .arg(seconds > 0 ? result.messages / seconds : 0.0,0,'f',0)
+                .arg(seconds > 0 ? result.bytes / seconds : 0.0,0,'f',0);
+        text += (num + 1 < results.size()) ? ",\n" : "\n";
+    }
+    text += "  ]";
+    if(profiler)
+    {
+        text += ",\n  \"profiler\": ";
+        text += QString(QDltProfiler::instance()->toJson()).trimmed();
+    }
+    text += "\n}\n";
+
+    return text.toAscii();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList arguments = app.arguments();
+    DltBenchCorpus corpus;
+    QString keepName, inputName, outputName;
+    bool profiler = false;
+
+    corpus.size = 64 * 1024 * 1024;
+    corpus.seed = 1;
+    corpus.meanPayload = 80;
+    corpus.maxPayload = 1024;
+    corpus.nonVerbose = 20;
+    corpus.ecus = 1;
+    corpus.apids = 20;
+    corpus.ctids = 5;
+    corpus.types = QString("strg,uint,sint,floa,bool,rawd").split(",");
+
+    for(int num=1;num<arguments.size();num++)
+    {
+        QString option = arguments[num];
+        if(option == "-p")
+        {
+            profiler = true;
+            continue;
+        }
+        if(num + 1 >= arguments.size())
+        {
+            printf("Usage: dlt-bench [-s size] [-r seed] [-m mean] [-M max] [-n percent] [-e count] [-a count]\n"
+                   "                 [-c count] [-t types] [-k file] [-i file] [-o file] [-p]\n");
+            return -1;
+        }
+        QString value = arguments[++num];
+        if(option == "-s")
+            corpus.size = value.toLongLong() * 1024 * 1024;
+        else if(option == "-r")
+            corpus.seed = value.toULongLong();
+        else if(option == "-m")
+            corpus.meanPayload = qMax(value.toInt(),4);
+        else if(option == "-M")
+            corpus.maxPayload = qBound(4,value.toInt(),60000);
+        else if(option == "-n")
+            corpus.nonVerbose = qBound(0,value.toInt(),100);
+        else if(option == "-e")
+            corpus.ecus = qMax(value.toInt(),1);
+        else if(option == "-a")
+            corpus.apids = qMax(value.toInt(),1);
+        else if(option == "-c")
+            corpus.ctids = qMax(value.toInt(),1);
+        else if(option == "-t")
+            corpus.types = value.split(",",QString::SkipEmptyParts);
+        else if(option == "-k")
+            keepName = value;
+        else if(option == "-i")
+            inputName = value;
+        else if(option == "-o")
+            outputName = value;
+        else
+        {
+            printf("Unknown option %s\n", qPrintable(option));
+            return -1;
+        }
+    }
+    if(corpus.types.isEmpty())
+        corpus.types << "strg";
+
+    QString tempPath = QDir::tempPath() + "/dlt-bench";
+    QString filename = inputName;
+    if(filename.isEmpty())
+    {
+        filename = keepName.isEmpty() ? tempPath + ".dlt" : keepName;
+        QElapsedTimer timer;
+        timer.start();
+        qint64 messages = generateCorpus(filename,corpus);
+        if(messages < 0)
+        {
+            printf("Cannot write %s\n", qPrintable(filename));
+            return -1;
+        }
+        printf("generated %lld messages in %.3f s\n", (long long)messages, timer.nsecsElapsed() / 1e9);
+    }
+
+    QDltProfiler::instance()->setEnabled(profiler);
+
+    QList<DltBenchResult> results;
+    DltBenchResult result;
+    QDltFile file;
+    bool ok = true;
+
+    result.name = "index";
+    if(!benchIndex(filename,file,result))
+    {
+        printf("Cannot open %s\n", qPrintable(filename));
+        return -1;
+    }
+    results.append(result);
+
+    result.name = "parse";
+    benchParse(file,result);
+    results.append(result);
+
+    result.name = "filter";
+    benchFilter(file,corpus,result);
+    results.append(result);
+
+    result.name = "search";
+    benchSearch(file,result);
+    results.append(result);
+
+    result.name = "export";
+    ok &= benchExport(file,tempPath + ".txt",result);
+    results.append(result);
+    QFile::remove(tempPath + ".txt");
+
+    result.name = "append";
+    ok &= benchAppend(file,tempPath + "-append.dlt",result);
+    results.append(result);
+    QFile::remove(tempPath + "-append.dlt");
+
+    file.close();
+    if(inputName.isEmpty() && keepName.isEmpty())
+        QFile::remove(filename);
+
+    for(int num=0;num<results.size();num++)
+        printResult(results[num]);
+
+    if(!outputName.isEmpty())
+    {
+        QFile out(outputName);
+        if(!out.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+           out.write(resultsToJson(corpus,filename,results,profiler)) < 0)
+        {
+            printf("Cannot write %s\n", qPrintable(outputName));
+            return -1;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
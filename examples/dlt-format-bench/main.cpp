@@ -0,0 +1,338 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file main.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+/* Compare the text output of QDltMsg with the previous QString::arg() based
+   formatting and measure the time of both.
+
+   Usage: dlt-format-bench logfile.dlt [rounds]
+*/
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QTime>
+#include <QStringList>
+
+#include <stdio.h>
+
+#include "qdlt.h"
+
+extern "C"
+{
+    #include "dlt_common.h"
+}
+
+/* previous implementation of QDlt::toAscii */
+static QString legacyToAscii(const QByteArray &bytes, bool ascii = false)
+{
+    QString text;
+    text.reserve(bytes.size()*2);
+
+    for(int num=0;num<bytes.size();num++)
+    {
+        char ch = (bytes.constData())[num];
+        if(ascii) {
+            if( (ch >= ' ') && (ch <= '~') )
+                text += QString(QChar(ch));
+            else
+                text += QString("-");
+        }
+        else {
+            if(num!=0)
+                text += QString(" ");
+            text += QString("%1").arg((unsigned char)ch,2,16,QLatin1Char('0'));
+        }
+    }
+
+    return text;
+}
+
+/* previous implementation of QDltArgument::toString */
+static QString legacyArgument(QDltArgument &argument)
+{
+    QString text;
+    QByteArray data = argument.getData();
+    bool little = (argument.getEndianness() == QDlt::DltEndiannessLittleEndian);
+
+    switch(argument.getTypeInfo()) {
+    case QDltArgument::DltTypeInfoStrg:
+        if(data.size())
+            text += QString("%1").arg(QString(data));
+        break;
+    case QDltArgument::DltTypeInfoBool:
+        if(data.size())
+            text += data.constData()[0] ? QString("true") : QString("false");
+        else
+            text += QString("?");
+        break;
+    case QDltArgument::DltTypeInfoSInt:
+        switch(data.size())
+        {
+        case 1:
+            text += QString("%1").arg((short)(*(char*)(data.constData())));
+            break;
+        case 2:
+            if(little)
+                text += QString("%1").arg((short)(*(short*)(data.constData())));
+            else
+                text += QString("%1").arg(DLT_SWAP_16((short)(*(short*)(data.constData()))));
+            break;
+        case 4:
+            if(little)
+                text += QString("%1").arg((int)(*(int*)(data.constData())));
+            else
+                text += QString("%1").arg(DLT_SWAP_32((int)(*(int*)(data.constData()))));
+            break;
+        case 8:
+            if(little)
+                text += QString("%1").arg((long long)(*(long long*)(data.constData())));
+            else
+                text += QString("%1").arg(DLT_SWAP_64((long long)(*(long long*)(data.constData()))));
+            break;
+        default:
+            text += QString("?");
+        }
+        break;
+    case QDltArgument::DltTypeInfoUInt:
+        switch(data.size())
+        {
+        case 1:
+            text += QString("%1").arg((unsigned short)(*(unsigned char*)(data.constData())));
+            break;
+        case 2:
+            if(little)
+                text += QString("%1").arg((unsigned short)(*(unsigned short*)(data.constData())));
+            else
+                text += QString("%1").arg(DLT_SWAP_16((unsigned short)(*(unsigned short*)(data.constData()))));
+            break;
+        case 4:
+            if(little)
+                text += QString("%1").arg((unsigned int)(*(unsigned int*)(data.constData())));
+            else
+                text += QString("%1").arg(DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData()))));
+            break;
+        case 8:
+            if(little)
+                text += QString("%1").arg((unsigned long long)(*(unsigned long long*)(data.constData())));
+            else
+                text += QString("%1").arg(DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData()))));
+            break;
+        default:
+            text += QString("?");
+        }
+        break;
+    case QDltArgument::DltTypeInfoFloa:
+        switch(data.size())
+        {
+        case 4:
+            if(little)
+                text += QString("%1").arg((double)(*(float*)(data.constData())));
+            else {
+                unsigned int tmp = DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData())));
+                text += QString("%1").arg((double)(*(float*)((void*)&tmp)));
+            }
+            break;
+        case 8:
+            if(little)
+                text += QString("%1").arg((double)(*(double*)(data.constData())));
+            else {
+                unsigned long long tmp = DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData())));
+                text += QString("%1").arg((double)(*(double*)((void*)&tmp)));
+            }
+            break;
+        default:
+            text += QString("?");
+        }
+        break;
+    case QDltArgument::DltTypeInfoRawd:
+        text += legacyToAscii(data);
+        break;
+    default:
+        text += QString("?");
+    }
+
+    return text;
+}
+
+/* previous implementation of QDltMsg::toStringHeader */
+static QString legacyHeader(QDltMsg &msg)
+{
+    QString text;
+    text.reserve(1024);
+
+    text += QString("%1.%2").arg(msg.getTimeString()).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'));
+    text += QString(" %1.%2").arg(msg.getTimestamp()/10000).arg(msg.getTimestamp()%10000,4,10,QLatin1Char('0'));
+    text += QString(" %1").arg(msg.getMessageCounter());
+    text += QString(" %1").arg(msg.getEcuid());
+    text += QString(" %1").arg(msg.getApid());
+    text += QString(" %1").arg(msg.getCtid());
+    text += QString(" %2").arg(msg.getTypeString());
+    text += QString(" %2").arg(msg.getSubtypeString());
+    text += QString(" %2").arg(msg.getModeString());
+    text += QString(" %1").arg(msg.getNumberOfArguments());
+
+    return text;
+}
+
+/* previous implementation of QDltMsg::toStringPayload */
+static QString legacyPayload(QDltMsg &msg)
+{
+    QString text;
+    QDltArgument argument;
+    QByteArray payload = msg.getPayload();
+    QByteArray data;
+
+    text.reserve(1024);
+
+    if((msg.getMode()==QDltMsg::DltModeNonVerbose) && (msg.getType()!=QDltMsg::DltTypeControl) && (msg.getNumberOfArguments() == 0)) {
+        text += QString("[%1] ").arg(msg.getMessageId());
+        data = payload.mid(4,(payload.size()>260)?256:(payload.size()-4));
+        if(!data.isEmpty())
+        {
+            text += legacyToAscii(data, true);
+            text += "|";
+            text += legacyToAscii(data, false);
+        }
+        return text;
+    }
+
+    if(msg.getType()==QDltMsg::DltTypeControl && msg.getSubtype()==QDltMsg::DltControlResponse) {
+        text += QString("[%1 %2] ").arg(msg.getCtrlServiceIdString()).arg(msg.getCtrlReturnTypeString());
+        if(msg.getCtrlServiceId() == 0x13)
+        {
+            data = payload.mid(9,(payload.size()>262)?256:(payload.size()-9));
+            text += legacyToAscii(data,true);
+        }
+        else
+        {
+            data = payload.mid(6,(payload.size()>262)?256:(payload.size()-6));
+            text += legacyToAscii(data);
+        }
+        return text;
+    }
+
+    if(msg.getType()==QDltMsg::DltTypeControl) {
+        text += QString("[%1] ").arg(msg.getCtrlServiceIdString());
+        data = payload.mid(4,(payload.size()>260)?256:(payload.size()-4));
+        text += legacyToAscii(data);
+        return text;
+    }
+
+    for(int num=0;num<msg.sizeArguments();num++) {
+        if(msg.getArgument(num,argument)) {
+            if(num!=0)
+                text += " ";
+            text += legacyArgument(argument);
+        }
+    }
+
+    return text;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList arguments = app.arguments();
+
+    if(arguments.size() < 2)
+    {
+        printf("Usage: dlt-format-bench logfile.dlt [rounds]\n");
+        return -1;
+    }
+
+    int rounds = (arguments.size() > 2) ? arguments.at(2).toInt() : 1;
+    if(rounds < 1)
+        rounds = 1;
+
+    QDltFile file;
+    if(!file.open(arguments.at(1)))
+    {
+        printf("Cannot open %s\n", qPrintable(arguments.at(1)));
+        return -1;
+    }
+    file.createIndex();
+
+    /* parse all messages once, only the formatting is measured */
+    QList<QDltMsg> msgs;
+    for(int num=0;num<file.size();num++)
+    {
+        QDltMsg msg;
+        msg.setMsg(file.getMsg(num));
+        msgs.append(msg);
+    }
+    file.close();
+
+    /* compare output */
+    int differences = 0;
+    QString text;
+    for(int num=0;num<msgs.size();num++)
+    {
+        QDltMsg &msg = msgs[num];
+        QString legacy = legacyHeader(msg) + " " + legacyPayload(msg);
+
+        text.clear();
+        msg.toStringHeader(text);
+        text += QLatin1Char(' ');
+        msg.toStringPayload(text);
+
+        if(text != legacy)
+        {
+            if(differences < 10)
+                printf("Message %d differs:\n  old: %s\n  new: %s\n", num, qPrintable(legacy), qPrintable(text));
+            differences++;
+        }
+    }
+
+    /* measure both implementations */
+    QTime t;
+    qint64 size = 0;
+
+    t.start();
+    for(int round=0;round<rounds;round++)
+    {
+        for(int num=0;num<msgs.size();num++)
+        {
+            QString legacy = legacyHeader(msgs[num]) + " " + legacyPayload(msgs[num]);
+            size += legacy.size();
+        }
+    }
+    int legacyTime = t.elapsed();
+
+    t.start();
+    for(int round=0;round<rounds;round++)
+    {
+        for(int num=0;num<msgs.size();num++)
+        {
+            text.clear();
+            msgs[num].toStringHeader(text);
+            text += QLatin1Char(' ');
+            msgs[num].toStringPayload(text);
+            size -= text.size();
+        }
+    }
+    int fastTime = t.elapsed();
+
+    printf("%d messages, %d rounds\n", msgs.size(), rounds);
+    printf("QString::arg formatting: %d ms\n", legacyTime);
+    printf("buffer formatting:       %d ms\n", fastTime);
+    if(fastTime > 0)
+        printf("speedup:                 %.2f\n", (double)legacyTime/fastTime);
+    printf("%d messages differ\n", differences);
+
+    return (differences || size) ? 1 : 0;
+}
@@ -80,31 +80,22 @@ bool SpeedPlugin::initFile(QDltFile *file)
 
 void SpeedPlugin::updateFile()
 {
-    QByteArray buffer;
+    QDltIdSet ids;
     QDltMsg msg;
     QDltArgument argument;
     if(!dltFile)
         return;
 
+    /* only the speed signals are read and parsed, the other messages are skipped by their header columns */
+    int end = dltFile->size();
+    ids.addContext("SPEE","SIG");
+    QVector<int> indexes = dltFile->findMsgs(ids,msgIndex,end);
+    msgIndex = end;
 
-
-
-   for(;msgIndex<dltFile->size();msgIndex++)
+    for(int num=0;num<indexes.size();num++)
     {
-
-       buffer =  dltFile->getMsg(msgIndex);
-
-       if(buffer.isEmpty())
-           break;
-
-       msg.setMsg(buffer);
-
-        if( (msg.getApid().compare("SPEE") == 0) && (msg.getCtid().compare("SIG") == 0))
-        {
-            if(msg.getArgument(1,argument)) {
-                            form->setSpeedLCD(argument,msg.getTimestamp());
-            }
-
+        if(dltFile->getMsg(indexes[num],msg) && msg.getArgument(1,argument)) {
+            form->setSpeedLCD(argument,msg.getTimestamp());
         }
     }
 }
@@ -21,9 +21,54 @@
 
 #include "dltsystemviewerplugin.h"
 
+/* Number of fields of a stat line needed by the plugin. */
+#define DLT_SYSTEM_FIELDS 16
+
+/* Find the start of the first fields of a stat line separated by single spaces. */
+static int dltSystemFields(const QByteArray &data, int *offsets, int max)
+{
+    const char *text = data.constData();
+    int size = data.size();
+    int count = 0;
+
+    offsets[count++] = 0;
+    for(int pos=0;pos<size && count<max;pos++)
+    {
+        if(text[pos] == 0)
+            break;
+        if(text[pos] == ' ')
+            offsets[count++] = pos + 1;
+    }
+
+    return count;
+}
+
+/* Read the decimal number of a stat line field. */
+static qint64 dltSystemNumber(const QByteArray &data, int offset)
+{
+    const char *text = data.constData();
+    int size = data.size();
+    qint64 value = 0;
+    bool negative = false;
+
+    if(offset < size && text[offset] == '-')
+    {
+        negative = true;
+        offset++;
+    }
+    while(offset < size && text[offset] >= '0' && text[offset] <= '9')
+        value = value * 10 + (text[offset++] - '0');
+
+    return negative ? -value : value;
+}
+
 DltSystemViewerPlugin::DltSystemViewerPlugin()
 {
     dltFile = 0;
+    systemChanged = false;
+    systemUser = 0;
+    systemNice = 0;
+    systemKernel = 0;
 }
 
 DltSystemViewerPlugin::~DltSystemViewerPlugin()
@@ -72,6 +117,7 @@ QStringList DltSystemViewerPlugin::infoConfig()
 QWidget* DltSystemViewerPlugin::initViewer()
 {
     form = new Form();
+    form->setStore(&store);
     return form;
 }
 
@@ -88,7 +134,17 @@ void DltSystemViewerPlugin::initFileStart(QDltFile *file){
 
     dltFile = file;
 
-    counterMessages = dltFile->size();
+    lastValueUser = 0;
+    lastValueNice = 0;
+    lastValueKernel = 0;
+    lastTimeStamp = 0;
+
+    store.mutex()->lock();
+    store.clear();
+    processes.clear();
+    changedProcesses.clear();
+    systemChanged = false;
+    store.mutex()->unlock();
 
     form->deleteAllProccesses();
 
@@ -96,8 +152,6 @@ void DltSystemViewerPlugin::initFileStart(QDltFile *file){
 
 void DltSystemViewerPlugin::initMsg(int index, QDltMsg &msg){
 
-    updateProcesses(index, msg);
-
 }
 void DltSystemViewerPlugin::initMsgDecoded(int index, QDltMsg &msg){
 
@@ -105,6 +159,8 @@ void DltSystemViewerPlugin::initMsgDecoded(int index, QDltMsg &msg){
 
 void DltSystemViewerPlugin::initFileFinish(){
 
+    updateForm();
+
 }
 
 void DltSystemViewerPlugin::updateFileStart(){
@@ -112,51 +168,98 @@ void DltSystemViewerPlugin::updateFileStart(){
 }
 void DltSystemViewerPlugin::updateMsg(int index, QDltMsg &msg){
 
-    if(!dltFile)
-        return;
+}
+
+void DltSystemViewerPlugin::updateMsgDecoded(int index, QDltMsg &msg){
 
-    updateProcesses(index, msg);
+}
+void DltSystemViewerPlugin::updateFileFinish(){
 
-    counterMessages = dltFile->size();
 
 }
 
-void DltSystemViewerPlugin::updateMsgDecoded(int index, QDltMsg &msg){
+void DltSystemViewerPlugin::initMsgRange(int begin, int end)
+{
+    readRange(begin,end);
+}
 
+void DltSystemViewerPlugin::updateMsgRange(int begin, int end)
+{
+    readRange(begin,end);
+    updateForm();
 }
-void DltSystemViewerPlugin::updateFileFinish(){
 
+void DltSystemViewerPlugin::readRange(int begin, int end)
+{
+    QDltIdSet ids;
+    QDltMsg msg;
 
+    if(!dltFile)
+        return;
+
+    /* only the messages of the system monitor are read and parsed */
+    ids.addContext("SYS","PROC");
+    ids.addContext("SYS","STAT");
+    QVector<int> indexes = dltFile->findMsgs(ids,begin,end);
+
+    for(int num=0;num<indexes.size();num++)
+    {
+        if(dltFile->getMsg(indexes[num],msg))
+            updateProcesses(indexes[num],msg);
+    }
+}
+
+void DltSystemViewerPlugin::updateForm()
+{
+    QList<int> pids;
+    QList<ProcessState> states;
+    bool system;
+    qint64 user,nice,kernel;
+
+    /* copy the changes, so the store is not locked while the widgets are updated */
+    store.mutex()->lock();
+    foreach(int pid, changedProcesses)
+    {
+        pids.append(pid);
+        states.append(processes.value(pid));
+    }
+    changedProcesses.clear();
+    system = systemChanged;
+    systemChanged = false;
+    user = systemUser;
+    nice = systemNice;
+    kernel = systemKernel;
+    store.mutex()->unlock();
+
+    for(int num=0;num<pids.size();num++)
+        form->updateProcess(pids[num],states[num].name,states[num].utime,states[num].ktime,states[num].cpu);
+
+    if(system)
+    {
+        form->setUser(QString("%1").arg(user));
+        form->setNice(QString("%1").arg(nice));
+        form->setSystem(QString("%1").arg(kernel));
+    }
+
+    form->updateChart();
 }
 
 
 void DltSystemViewerPlugin::updateProcesses(int index, QDltMsg &msg)
 {
-    QStringList datalist;
     QDltArgument arg;
     int pid,seq;
 
     if(!dltFile)
         return;
 
-
-
-            if(msg.getMode() == QDltMsg::DltModeVerbose)
-            {
-                counterVerboseMessages++;
-            }
-            if(msg.getMode() == QDltMsg::DltModeNonVerbose)
-            {
-                counterNonVerboseMessages++;
-            }
-
         if(msg.getApid()=="SYS" && msg.getCtid()=="PROC") {
             msg.getArgument(0,arg);
             pid = arg.toString().toInt();
             msg.getArgument(1,arg);
             if(arg.toString()=="stat") {
                 msg.getArgument(2,arg);
-                form->addProcesses(pid,arg.toString(),msg);
+                addProcess(pid,arg.getData(),msg.getTimestamp());
             }
         }        
         if(msg.getApid()=="SYS" && msg.getCtid()=="STAT") {
@@ -164,18 +267,90 @@ void DltSystemViewerPlugin::updateProcesses(int index, QDltMsg &msg)
             seq = arg.toString().toInt();
             if(seq==1) {
                 msg.getArgument(1,arg);
-                datalist = arg.toString().split(" ");
-                form->setUser(QString("%1").arg(((datalist.at(2).toInt())-lastValueUser)*10000/(msg.getTimestamp()-lastTimeStamp)));
-                form->setNice(QString("%1").arg(((datalist.at(3).toInt())-lastValueNice)*10000/(msg.getTimestamp()-lastTimeStamp)));
-                form->setSystem(QString("%1").arg(((datalist.at(4).toInt())-lastValueKernel)*10000/(msg.getTimestamp()-lastTimeStamp)));
-                lastValueUser = datalist.at(2).toInt();
-                lastValueNice = datalist.at(3).toInt();;
-                lastValueKernel = datalist.at(4).toInt();;
-                lastTimeStamp = msg.getTimestamp();
+                addSystem(arg.getData(),msg.getTimestamp());
             }
         }
 
 
 }
 
+void DltSystemViewerPlugin::addProcess(int pid, const QByteArray &data, unsigned int timestamp)
+{
+    int fields[DLT_SYSTEM_FIELDS];
+
+    /* fields 13 and 14 of /proc/<pid>/stat are the user and kernel time */
+    if(dltSystemFields(data,fields,DLT_SYSTEM_FIELDS) < 15)
+        return;
+
+    qint64 utime = dltSystemNumber(data,fields[13]);
+    qint64 ktime = dltSystemNumber(data,fields[14]);
+
+    QMutexLocker locker(store.mutex());
+
+    if(!processes.contains(pid))
+    {
+        ProcessState state;
+        state.name = QString::fromLatin1(data.constData() + fields[1],fields[2] - fields[1] - 1);
+        state.utime = utime;
+        state.ktime = ktime;
+        state.cpu = 0;
+        state.lastTimestamp = timestamp;
+        processes.insert(pid,state);
+    }
+    else
+    {
+        ProcessState &state = processes[pid];
+        qint64 elapsed = (qint64)timestamp - state.lastTimestamp;
+        if(elapsed > 0)
+            state.cpu = (utime - state.utime + ktime - state.ktime) * 10000 / elapsed;
+        state.utime = utime;
+        state.ktime = ktime;
+        state.lastTimestamp = timestamp;
+    }
+
+    const ProcessState &state = processes[pid];
+    qint64 values[TimeSeriesStore::ProcessColumns];
+    values[TimeSeriesStore::ProcessCpu] = state.cpu;
+    values[TimeSeriesStore::ProcessUserTime] = state.utime;
+    values[TimeSeriesStore::ProcessKernelTime] = state.ktime;
+    store.process(pid)->append(timestamp,values);
+
+    changedProcesses.insert(pid);
+}
+
+void DltSystemViewerPlugin::addSystem(const QByteArray &data, unsigned int timestamp)
+{
+    int fields[DLT_SYSTEM_FIELDS];
+
+    /* the cpu line of /proc/stat starts with two spaces, fields 2 to 4 are user, nice and system time */
+    if(dltSystemFields(data,fields,DLT_SYSTEM_FIELDS) < 5)
+        return;
+
+    qint64 user = dltSystemNumber(data,fields[2]);
+    qint64 nice = dltSystemNumber(data,fields[3]);
+    qint64 kernel = dltSystemNumber(data,fields[4]);
+    qint64 elapsed = (qint64)timestamp - lastTimeStamp;
+
+    if(elapsed > 0)
+    {
+        QMutexLocker locker(store.mutex());
+
+        systemUser = (user - lastValueUser) * 10000 / elapsed;
+        systemNice = (nice - lastValueNice) * 10000 / elapsed;
+        systemKernel = (kernel - lastValueKernel) * 10000 / elapsed;
+        systemChanged = true;
+
+        qint64 values[TimeSeriesStore::SystemColumns];
+        values[TimeSeriesStore::SystemUser] = systemUser;
+        values[TimeSeriesStore::SystemNice] = systemNice;
+        values[TimeSeriesStore::SystemKernel] = systemKernel;
+        store.system()->append(timestamp,values);
+    }
+
+    lastValueUser = user;
+    lastValueNice = nice;
+    lastValueKernel = kernel;
+    lastTimeStamp = timestamp;
+}
+
 Q_EXPORT_PLUGIN2(dltsystemviewerplugin, DltSystemViewerPlugin);
@@ -21,16 +21,20 @@
 #define DLTSYSTEMVIEWERPLUGIN_H
 
 #include <QObject>
+#include <QHash>
+#include <QSet>
 #include "plugininterface.h"
 #include "form.h"
+#include "timeseries.h"
 
 #define DLT_SYSTEM_VIEWER_PLUGIN_VERSION "1.0.0"
 
-class DltSystemViewerPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface
+class DltSystemViewerPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface, QDltPluginViewerRangeInterface
 {
     Q_OBJECT
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDltPluginViewerInterface)
+    Q_INTERFACES(QDltPluginViewerRangeInterface)
 
 public:
     DltSystemViewerPlugin();
@@ -59,15 +63,16 @@ public:
     void selectedIdxMsg(int index, QDltMsg &msg);
     void selectedIdxMsgDecoded(int index, QDltMsg &msg);
 
+    /* QDltPluginViewerRangeInterface */
+    void initMsgRange(int begin, int end);
+    void updateMsgRange(int begin, int end);
+
     /* internal variables */
     Form *form;
-    int counterMessages;
-    int counterNonVerboseMessages;
-    int counterVerboseMessages;
 
-    int lastValueUser;
-    int lastValueNice;
-    int lastValueKernel;
+    qint64 lastValueUser;
+    qint64 lastValueNice;
+    qint64 lastValueKernel;
     unsigned int lastTimeStamp;
 
     void show(bool value);
@@ -77,6 +82,29 @@ public:
 private:
     QDltFile *dltFile;
     QString errorText;
+
+    typedef struct
+    {
+        QString name;
+        qint64 utime;
+        qint64 ktime;
+        qint64 cpu;
+        unsigned int lastTimestamp;
+    } ProcessState;
+
+    void readRange(int begin, int end);
+    void updateForm();
+    void addProcess(int pid, const QByteArray &data, unsigned int timestamp);
+    void addSystem(const QByteArray &data, unsigned int timestamp);
+
+    /* written by readRange() and read by updateForm(), protected by the mutex of the store */
+    TimeSeriesStore store;
+    QHash<int,ProcessState> processes;
+    QSet<int> changedProcesses;
+    bool systemChanged;
+    qint64 systemUser;
+    qint64 systemNice;
+    qint64 systemKernel;
 };
 
 #endif // DLTSYSTEMVIEWERPLUGIN_H
@@ -7,12 +7,16 @@ TARGET = $$qtLibraryTarget(dltsystemviewerplugin)
 # plugin header files
 HEADERS += \
     dltsystemviewerplugin.h \
-    form.h
+    form.h \
+    timeseries.h \
+    timeserieschart.h
 
 # plugin source files
 SOURCES += \
     dltsystemviewerplugin.cpp \
-    form.cpp
+    form.cpp \
+    timeseries.cpp \
+    timeserieschart.cpp
 
 # plugin forms
 FORMS += \
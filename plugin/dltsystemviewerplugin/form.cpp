@@ -37,6 +37,9 @@ Form::Form(QWidget *parent) :
     ui(new Ui::Form)
 {
     ui->setupUi(this);
+
+    chart = new TimeSeriesChart();
+    ui->tabWidget->addTab(chart,QString("History"));
 }
 
 Form::~Form()
@@ -44,49 +47,55 @@ Form::~Form()
     delete ui;
 }
 
-void Form::addProcesses(int pid, QString data,QDltMsg &msg)
+void Form::updateProcess(int pid, const QString &name, qint64 utime, qint64 ktime, qint64 cpu)
 {
-    QStringList datalist;
-    ProcessItem *widget;
-    int found = 0;
-    int procent = 0;
-
-    datalist = data.split(" ");
-
-    for(int num=0;num<ui->treeWidget->topLevelItemCount();num++) {
-        widget = (ProcessItem*) ui->treeWidget->topLevelItem(num);
-        if(widget->text(0).toInt()==pid) {
-            found = 1;
-            //procent = datalist.at(13).toInt()-widget->text(2).toInt()+datalist.at(14).toInt()-widget->text(3).toInt();
-            procent = ((datalist.at(13).toInt())-widget->text(2).toInt()+datalist.at(14).toInt()-widget->text(3).toInt())*10000/(msg.getTimestamp()-widget->lastTimestamp);///4;
-            widget->setText(2,datalist.at(13));
-            widget->setText(3,datalist.at(14));
-            widget->setText(4,QString("%1").arg(procent));
-            widget->lastTimestamp = msg.getTimestamp();
-            break;
-        }
-    }
+    ProcessItem *widget = items.value(pid);
 
-    if(!found) {
+    if(!widget) {
         widget = new ProcessItem();
         widget->setText(0,QString("%1").arg(pid));
-        widget->setText(1,datalist.at(1));
-        widget->setText(2,datalist.at(13));
-        widget->setText(3,datalist.at(14));
-        widget->setText(4,QString("%1").arg(procent));
+        widget->setText(1,name);
         ui->treeWidget->insertTopLevelItem(0, widget);
+        items.insert(pid,widget);
     }
+
+    widget->setText(2,QString("%1").arg(utime));
+    widget->setText(3,QString("%1").arg(ktime));
+    widget->setText(4,QString("%1").arg(cpu));
 }
 
 void Form::deleteAllProccesses()
 {
+    items.clear();
     ui->treeWidget->clear();
+    chart->setProcess(-1);
 }
 
 
 void Form::on_pushButtonClear_clicked()
 {
-    ui->treeWidget->clear();
+    deleteAllProccesses();
+}
+
+void Form::on_treeWidget_itemSelectionChanged()
+{
+    QList<QTreeWidgetItem *> list = ui->treeWidget->selectedItems();
+
+    /* show the history of the selected process or of the whole system */
+    if(list.count() == 1)
+        chart->setProcess(list.at(0)->text(0).toInt());
+    else
+        chart->setProcess(-1);
+}
+
+void Form::setStore(TimeSeriesStore *store)
+{
+    chart->setStore(store);
+}
+
+void Form::updateChart()
+{
+    chart->update();
 }
 
 void Form::setUser(QString text)
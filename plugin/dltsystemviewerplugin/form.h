@@ -22,8 +22,10 @@
 
 #include <QWidget>
 #include <QTreeWidgetItem>
+#include <QHash>
 
 #include "plugininterface.h"
+#include "timeserieschart.h"
 
 namespace Ui {
     class Form;
@@ -47,7 +49,7 @@ public:
     explicit Form(QWidget *parent = 0);
     ~Form();
 
-    void addProcesses(int pid, QString data,QDltMsg &msg);
+    void updateProcess(int pid, const QString &name, qint64 utime, qint64 ktime, qint64 cpu);
 
     void setUser(QString text);
     void setNice(QString text);
@@ -55,12 +57,20 @@ public:
 
     void deleteAllProccesses();
 
+    void setStore(TimeSeriesStore *store);
+    void updateChart();
+
 private slots:
     void on_pushButtonClear_clicked();
+    void on_treeWidget_itemSelectionChanged();
 
 private:
     Ui::Form *ui;
 
+    /* tree items by process id */
+    QHash<int,ProcessItem*> items;
+    TimeSeriesChart *chart;
+
 };
 
 #endif // FORM_H
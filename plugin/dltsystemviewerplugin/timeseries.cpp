@@ -0,0 +1,247 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file timeseries.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "timeseries.h"
+
+/* Number of rows encoded in one block. */
+static const int TIMESERIES_BLOCK_ROWS = 512;
+
+TimeSeries::TimeSeries(int columns)
+{
+    this->columns = columns;
+    rows = 0;
+    minTime = 0;
+    maxTime = 0;
+}
+
+void TimeSeries::encode(QByteArray &data, qint64 value)
+{
+    /* zigzag encoding keeps small negative deltas small */
+    quint64 zigzag = ((quint64)value << 1) ^ (quint64)(value >> 63);
+
+    while(zigzag >= 0x80)
+    {
+        data.append((char)(zigzag | 0x80));
+        zigzag >>= 7;
+    }
+    data.append((char)zigzag);
+}
+
+qint64 TimeSeries::decode(const char *&pos)
+{
+    quint64 zigzag = 0;
+    int shift = 0;
+    unsigned char byte;
+
+    do
+    {
+        byte = (unsigned char)*pos++;
+        zigzag |= (quint64)(byte & 0x7f) << shift;
+        shift += 7;
+    } while(byte & 0x80);
+
+    return (qint64)(zigzag >> 1) ^ -(qint64)(zigzag & 1);
+}
+
+void TimeSeries::append(qint64 time, const qint64 *values)
+{
+    if(blocks.isEmpty() || blocks.last().rows >= TIMESERIES_BLOCK_ROWS)
+    {
+        Block block;
+        block.rows = 0;
+        block.minTime = time;
+        block.maxTime = time;
+        block.lastTime = 0;
+        block.times.reserve(TIMESERIES_BLOCK_ROWS);
+        block.values.resize(columns);
+        for(int num=0;num<columns;num++)
+        {
+            Column &column = block.values[num];
+            column.min = values[num];
+            column.max = values[num];
+            column.sum = 0;
+            column.last = 0;
+            column.data.reserve(TIMESERIES_BLOCK_ROWS);
+        }
+        blocks.append(block);
+    }
+
+    Block &block = blocks.last();
+
+    /* the first row of a block is encoded as delta to 0 */
+    encode(block.times,time - block.lastTime);
+    block.lastTime = time;
+    block.minTime = qMin(block.minTime,time);
+    block.maxTime = qMax(block.maxTime,time);
+
+    for(int num=0;num<columns;num++)
+    {
+        Column &column = block.values[num];
+        encode(column.data,values[num] - column.last);
+        column.last = values[num];
+        column.min = qMin(column.min,values[num]);
+        column.max = qMax(column.max,values[num]);
+        column.sum += values[num];
+    }
+
+    block.rows++;
+
+    if(rows == 0)
+    {
+        minTime = time;
+        maxTime = time;
+    }
+    else
+    {
+        minTime = qMin(minTime,time);
+        maxTime = qMax(maxTime,time);
+    }
+    rows++;
+}
+
+void TimeSeries::downsample(int column, qint64 begin, qint64 end, int count, QVector<TimeSeriesBucket> &buckets) const
+{
+    TimeSeriesBucket empty;
+    empty.min = 0;
+    empty.max = 0;
+    empty.avg = 0;
+    empty.count = 0;
+
+    buckets.fill(empty,qMax(count,0));
+
+    if(count <= 0 || end <= begin || column < 0 || column >= columns)
+        return;
+
+    double width = (double)(end - begin) / count;
+
+    /* the avg member holds the sum until all rows are added */
+    for(int num=0;num<blocks.size();num++)
+    {
+        const Block &block = blocks[num];
+
+        if(block.maxTime < begin || block.minTime >= end)
+            continue;
+
+        if(block.minTime >= begin && block.maxTime < end)
+        {
+            int first = qMin((int)((block.minTime - begin) / width),count - 1);
+            int last = qMin((int)((block.maxTime - begin) / width),count - 1);
+
+            if(first == last)
+            {
+                /* the whole block falls into one interval, use its summary */
+                const Column &values = block.values[column];
+                TimeSeriesBucket &bucket = buckets[first];
+                bucket.min = bucket.count ? qMin(bucket.min,values.min) : values.min;
+                bucket.max = bucket.count ? qMax(bucket.max,values.max) : values.max;
+                bucket.avg += values.sum;
+                bucket.count += block.rows;
+                continue;
+            }
+        }
+
+        const char *timePos = block.times.constData();
+        const char *valuePos = block.values[column].data.constData();
+        qint64 time = 0;
+        qint64 value = 0;
+
+        for(int row=0;row<block.rows;row++)
+        {
+            time += decode(timePos);
+            value += decode(valuePos);
+
+            if(time < begin || time >= end)
+                continue;
+
+            TimeSeriesBucket &bucket = buckets[qMin((int)((time - begin) / width),count - 1)];
+            bucket.min = bucket.count ? qMin(bucket.min,value) : value;
+            bucket.max = bucket.count ? qMax(bucket.max,value) : value;
+            bucket.avg += value;
+            bucket.count++;
+        }
+    }
+
+    for(int num=0;num<count;num++)
+    {
+        if(buckets[num].count)
+            buckets[num].avg /= buckets[num].count;
+    }
+}
+
+int TimeSeries::memoryUsage() const
+{
+    int size = 0;
+
+    for(int num=0;num<blocks.size();num++)
+    {
+        size += sizeof(Block) + blocks[num].times.size();
+        for(int col=0;col<columns;col++)
+            size += sizeof(Column) + blocks[num].values[col].data.size();
+    }
+
+    return size;
+}
+
+void TimeSeries::clear()
+{
+    blocks.clear();
+    rows = 0;
+    minTime = 0;
+    maxTime = 0;
+}
+
+TimeSeriesStore::TimeSeriesStore() : systemSeries(SystemColumns)
+{
+}
+
+TimeSeriesStore::~TimeSeriesStore()
+{
+    qDeleteAll(processes);
+}
+
+TimeSeries *TimeSeriesStore::process(int pid)
+{
+    TimeSeries *series = processes.value(pid);
+
+    if(!series)
+    {
+        series = new TimeSeries(ProcessColumns);
+        processes.insert(pid,series);
+    }
+
+    return series;
+}
+
+void TimeSeriesStore::clear()
+{
+    qDeleteAll(processes);
+    processes.clear();
+    systemSeries.clear();
+}
+
+int TimeSeriesStore::memoryUsage() const
+{
+    int size = systemSeries.memoryUsage();
+
+    QHash<int,TimeSeries*>::const_iterator it;
+    for(it = processes.constBegin(); it != processes.constEnd(); ++it)
+        size += it.value()->memoryUsage();
+
+    return size;
+}
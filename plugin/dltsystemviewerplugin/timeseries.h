@@ -0,0 +1,157 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file timeseries.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef TIMESERIES_H
+#define TIMESERIES_H
+
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+#include <QMutex>
+
+//! Aggregated samples of one column in one time interval.
+typedef struct
+{
+    qint64 min;
+    qint64 max;
+    double avg;
+    int count;
+} TimeSeriesBucket;
+
+//! Compact storage of samples with several values sharing one time.
+/*!
+  The samples are stored in blocks of a fixed number of rows. Each block stores
+  the time and each value column separately as zigzag varint encoded deltas to
+  the previous row, which needs one or two bytes for slowly changing counters.
+  Each block keeps the time range and the minimum, maximum and sum of each column,
+  so downsampling only decodes blocks spanning more than one display interval.
+*/
+class TimeSeries
+{
+public:
+    TimeSeries(int columns = 1);
+
+    //! Number of value columns of each row.
+    int columnCount() const { return columns; }
+
+    //! Number of rows.
+    int size() const { return rows; }
+
+    //! Smallest time of all rows.
+    qint64 firstTime() const { return minTime; }
+
+    //! Largest time of all rows.
+    qint64 lastTime() const { return maxTime; }
+
+    //! Append a row.
+    /*!
+      The time should increase, but rows with smaller times are accepted.
+      \param time the time of the row
+      \param values one value for each column
+    */
+    void append(qint64 time, const qint64 *values);
+
+    //! Aggregate the values of one column into intervals of equal length.
+    /*!
+      \param column the column to be aggregated
+      \param begin the start of the first interval
+      \param end the end of the last interval
+      \param count number of intervals
+      \param buckets the aggregated intervals, empty intervals have a count of 0
+    */
+    void downsample(int column, qint64 begin, qint64 end, int count, QVector<TimeSeriesBucket> &buckets) const;
+
+    //! Number of bytes used by the encoded rows.
+    int memoryUsage() const;
+
+    //! Remove all rows.
+    void clear();
+
+private:
+    typedef struct
+    {
+        qint64 min;
+        qint64 max;
+        qint64 sum;
+        qint64 last;
+        QByteArray data;
+    } Column;
+
+    typedef struct
+    {
+        int rows;
+        qint64 minTime;
+        qint64 maxTime;
+        qint64 lastTime;
+        QByteArray times;
+        QVector<Column> values;
+    } Block;
+
+    static void encode(QByteArray &data, qint64 value);
+    static qint64 decode(const char *&pos);
+
+    int columns;
+    int rows;
+    qint64 minTime;
+    qint64 maxTime;
+    QVector<Block> blocks;
+};
+
+//! Time series of all processes and of the whole system.
+/*!
+  The series are created on first use. All access must be protected by mutex(),
+  so the series can be read by the widgets while the plugin appends to them.
+*/
+class TimeSeriesStore
+{
+public:
+    //! Columns of the series of a process.
+    typedef enum { ProcessCpu = 0, ProcessUserTime, ProcessKernelTime, ProcessColumns } ProcessColumn;
+
+    //! Columns of the series of the system.
+    typedef enum { SystemUser = 0, SystemNice, SystemKernel, SystemColumns } SystemColumn;
+
+    TimeSeriesStore();
+    ~TimeSeriesStore();
+
+    //! The series of a process, created if it does not exist yet.
+    TimeSeries *process(int pid);
+
+    //! The series of a process or 0 if it does not exist.
+    const TimeSeries *findProcess(int pid) const { return processes.value(pid); }
+
+    //! The series of the system.
+    TimeSeries *system() { return &systemSeries; }
+
+    //! Remove all series.
+    void clear();
+
+    //! Number of bytes used by all series.
+    int memoryUsage() const;
+
+    //! The mutex protecting the series.
+    QMutex *mutex() { return &lock; }
+
+private:
+    QHash<int,TimeSeries*> processes;
+    TimeSeries systemSeries;
+    QMutex lock;
+};
+
+#endif // TIMESERIES_H
@@ -0,0 +1,138 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file timeserieschart.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QPainter>
+#include <QMutexLocker>
+
+#include "timeserieschart.h"
+
+TimeSeriesChart::TimeSeriesChart(QWidget *parent) :
+    QWidget(parent)
+{
+    store = 0;
+    pid = -1;
+
+    setMinimumSize(200,100);
+}
+
+void TimeSeriesChart::setStore(TimeSeriesStore *store)
+{
+    this->store = store;
+    update();
+}
+
+void TimeSeriesChart::setProcess(int pid)
+{
+    this->pid = pid;
+    update();
+}
+
+void TimeSeriesChart::paintEvent(QPaintEvent * /* event */)
+{
+    QPainter painter(this);
+    QRect area = rect().adjusted(50,20,-10,-20);
+    QList<int> columns;
+    QList<QColor> colors;
+    QString title;
+
+    painter.fillRect(rect(),palette().base());
+
+    if(pid < 0)
+    {
+        title = QString("System CPU (%): user, nice, system");
+        columns << TimeSeriesStore::SystemUser << TimeSeriesStore::SystemNice << TimeSeriesStore::SystemKernel;
+        colors << Qt::blue << Qt::darkGreen << Qt::red;
+    }
+    else
+    {
+        title = QString("CPU of process %1 (%)").arg(pid);
+        columns << TimeSeriesStore::ProcessCpu;
+        colors << Qt::blue;
+    }
+
+    painter.setPen(palette().text().color());
+    painter.drawText(QRect(0,0,width(),area.top()),Qt::AlignCenter,title);
+
+    if(!store || area.width() <= 0 || area.height() <= 0)
+        return;
+
+    /* only the aggregated intervals are computed while the store is locked */
+    QVector< QVector<TimeSeriesBucket> > buckets(columns.size());
+    qint64 begin,end;
+    {
+        QMutexLocker locker(store->mutex());
+        const TimeSeries *series = (pid < 0) ? store->system() : store->findProcess(pid);
+
+        if(!series || series->size() == 0)
+        {
+            painter.drawText(area,Qt::AlignCenter,QString("No data"));
+            return;
+        }
+
+        begin = series->firstTime();
+        end = series->lastTime() + 1;
+        for(int num=0;num<columns.size();num++)
+            series->downsample(columns[num],begin,end,area.width(),buckets[num]);
+    }
+
+    qint64 minValue = 0;
+    qint64 maxValue = 100;
+    for(int num=0;num<buckets.size();num++)
+    {
+        for(int x=0;x<buckets[num].size();x++)
+        {
+            if(buckets[num][x].count)
+            {
+                minValue = qMin(minValue,buckets[num][x].min);
+                maxValue = qMax(maxValue,buckets[num][x].max);
+            }
+        }
+    }
+    double scale = (double)area.height() / (maxValue - minValue);
+
+    /* axes and labels, the timestamps are in 0.1 milliseconds */
+    painter.drawRect(area.adjusted(0,0,-1,-1));
+    painter.drawText(QRect(0,area.top(),area.left()-5,20),Qt::AlignRight|Qt::AlignTop,QString("%1").arg(maxValue));
+    painter.drawText(QRect(0,area.bottom()-20,area.left()-5,20),Qt::AlignRight|Qt::AlignBottom,QString("%1").arg(minValue));
+    painter.drawText(QRect(area.left(),area.bottom(),area.width(),20),Qt::AlignLeft|Qt::AlignVCenter,QString("%1 s").arg(begin/10000));
+    painter.drawText(QRect(area.left(),area.bottom(),area.width(),20),Qt::AlignRight|Qt::AlignVCenter,QString("%1 s").arg(end/10000));
+
+    for(int num=0;num<buckets.size();num++)
+    {
+        const QVector<TimeSeriesBucket> &values = buckets[num];
+        QColor range = colors[num];
+        range.setAlpha(64);
+        QPolygonF average;
+
+        painter.setPen(range);
+        for(int x=0;x<values.size();x++)
+        {
+            if(!values[x].count)
+                continue;
+
+            int top = area.bottom() - (int)((values[x].max - minValue) * scale);
+            int bottom = area.bottom() - (int)((values[x].min - minValue) * scale);
+            painter.drawLine(area.left() + x,top,area.left() + x,bottom);
+            average << QPointF(area.left() + x,area.bottom() - (values[x].avg - minValue) * scale);
+        }
+
+        painter.setPen(colors[num]);
+        painter.drawPolyline(average);
+    }
+}
@@ -0,0 +1,55 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file timeserieschart.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef TIMESERIESCHART_H
+#define TIMESERIESCHART_H
+
+#include <QWidget>
+
+#include "timeseries.h"
+
+//! Chart of the CPU load history of a process or of the system.
+/*!
+  Each pixel column shows the minimum and maximum of the samples in its time
+  interval as a vertical bar and the average as a line, so the chart keeps its
+  drawing time independent of the length of the trace.
+*/
+class TimeSeriesChart : public QWidget
+{
+public:
+    TimeSeriesChart(QWidget *parent = 0);
+
+    //! Set the store the series are read from.
+    void setStore(TimeSeriesStore *store);
+
+    //! Show the CPU load of a process.
+    /*!
+      \param pid the process id or -1 to show the CPU load of the system
+    */
+    void setProcess(int pid);
+
+protected:
+    void paintEvent(QPaintEvent *event);
+
+private:
+    TimeSeriesStore *store;
+    int pid;
+};
+
+#endif // TIMESERIESCHART_H
@@ -84,4 +84,27 @@ bool DummyDecoderPlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
     return false;
 }
 
+QList<QDltDecoderClaim> DummyDecoderPlugin::claims()
+{
+    /* The dummy plugin does not decode any message, so it claims none.
+       A real plugin returns e.g. QDltDecoderClaim::context("APP","CON"). */
+    return QList<QDltDecoderClaim>();
+}
+
+void DummyDecoderPlugin::decodeMsgs(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser)
+{
+    for(int num=0;num<msgs.size();num++)
+    {
+        if(isMsg(*msgs[num],triggeredByUser))
+            decoded[num] = decodeMsg(*msgs[num],triggeredByUser);
+    }
+}
+
+QDltPluginThreadSafetyInterface::ThreadSafetyDef DummyDecoderPlugin::threadSafety()
+{
+    /* The dummy plugin keeps no state while decoding, so it may be called concurrently.
+       A plugin using member variables in decodeMsg() returns ThreadSafetySerialized. */
+    return ThreadSafetyReentrant;
+}
+
 Q_EXPORT_PLUGIN2(dummydecoderplugin, DummyDecoderPlugin);
@@ -25,11 +25,13 @@
 
 #define DUMMY_DECODER_PLUGIN_VERSION "1.0.0"
 
-class DummyDecoderPlugin : public QObject, QDLTPluginInterface, QDLTPluginDecoderInterface
+class DummyDecoderPlugin : public QObject, QDLTPluginInterface, QDLTPluginDecoderInterface, QDLTPluginDecoderBatchInterface, QDltPluginThreadSafetyInterface
 {
     Q_OBJECT
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDLTPluginDecoderInterface)
+    Q_INTERFACES(QDLTPluginDecoderBatchInterface)
+    Q_INTERFACES(QDltPluginThreadSafetyInterface)
 
 public:
     DummyDecoderPlugin();
@@ -49,6 +51,13 @@ public:
     bool isMsg(QDltMsg &msg, int triggeredByUser);
     bool decodeMsg(QDltMsg &msg, int triggeredByUser);
 
+    /* QDLTPluginDecoderBatchInterface */
+    QList<QDltDecoderClaim> claims();
+    void decodeMsgs(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser);
+
+    /* QDltPluginThreadSafetyInterface */
+    ThreadSafetyDef threadSafety();
+
 private:
     QString errorText;
 };
@@ -24,6 +24,10 @@
 DummyViewerPlugin::DummyViewerPlugin()
 {
     dltFile = 0;
+    form = 0;
+    counterMessages = 0;
+    counterNonVerboseMessages = 0;
+    counterVerboseMessages = 0;
 }
 
 DummyViewerPlugin::~DummyViewerPlugin()
@@ -81,7 +85,7 @@ void DummyViewerPlugin::updateCounters(int index, QDltMsg &msg)
     if(!dltFile)
         return;
 
-
+    QMutexLocker lock(&mutex);
 
             if(msg.getMode() == QDltMsg::DltModeVerbose)
             {
@@ -91,6 +95,9 @@ void DummyViewerPlugin::updateCounters(int index, QDltMsg &msg)
             {
                 counterNonVerboseMessages++;
             }
+
+            /* the log file is still growing in the GUI thread */
+            counterMessages = qMax(counterMessages,index + 1);
 }
 
 
@@ -115,6 +122,8 @@ void DummyViewerPlugin::initFileStart(QDltFile *file){
 
     form->setMessages(dltFile->size());
 
+    QMutexLocker lock(&mutex);
+
     counterMessages = dltFile->size();
 
     counterNonVerboseMessages = 0;
@@ -131,9 +140,7 @@ void DummyViewerPlugin::initMsgDecoded(int index, QDltMsg &msg){
 }
 
 void DummyViewerPlugin::initFileFinish(){
-    form->setMessages(dltFile->size());
-    form->setVerboseMessages(counterVerboseMessages);
-    form->setNonVerboseMessages(counterNonVerboseMessages);
+    updateViewer();
 }
 
 void DummyViewerPlugin::updateFileStart(){
@@ -145,8 +152,6 @@ void DummyViewerPlugin::updateMsg(int index, QDltMsg &msg){
             return;
 
         updateCounters(index,msg);
-
-        counterMessages = dltFile->size();
 }
 
 void DummyViewerPlugin::updateMsgDecoded(int index, QDltMsg &msg){
@@ -154,7 +159,24 @@ void DummyViewerPlugin::updateMsgDecoded(int index, QDltMsg &msg){
 }
 
 void DummyViewerPlugin::updateFileFinish(){
-    form->setMessages(dltFile->size());
+
+}
+
+int DummyViewerPlugin::queueSize(){
+    return 10000;
+}
+
+int DummyViewerPlugin::updateInterval(){
+    return 200;
+}
+
+void DummyViewerPlugin::updateViewer(){
+    if(!form)
+        return;
+
+    QMutexLocker lock(&mutex);
+
+    form->setMessages(counterMessages);
     form->setVerboseMessages(counterVerboseMessages);
     form->setNonVerboseMessages(counterNonVerboseMessages);
 }
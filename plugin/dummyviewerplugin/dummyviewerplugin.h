@@ -21,16 +21,18 @@
 #define DUMMYVIEWERPLUGIN_H
 
 #include <QObject>
+#include <QMutex>
 #include "plugininterface.h"
 #include "form.h"
 
 #define DUMMY_VIEWER_PLUGIN_VERSION "1.0.0"
 
-class DummyViewerPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface
+class DummyViewerPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface, QDltPluginViewerAsyncInterface
 {
     Q_OBJECT
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDltPluginViewerInterface)
+    Q_INTERFACES(QDltPluginViewerAsyncInterface)
 
 public:
     DummyViewerPlugin();
@@ -59,6 +61,10 @@ public:
     void selectedIdxMsg(int index, QDltMsg &msg);
     void selectedIdxMsgDecoded(int index, QDltMsg &msg);
 
+    /* QDltPluginViewerAsyncInterface */
+    int queueSize();
+    int updateInterval();
+    void updateViewer();
 
     /* internal variables */
     Form *form;
@@ -72,6 +78,9 @@ public:
 private:
     QDltFile *dltFile;
     QString errorText;
+
+    /* the counters are updated in the worker thread and shown in the GUI thread */
+    QMutex mutex;
 };
 
 #endif // DUMMYVIEWERPLUGIN_H
@@ -21,17 +21,24 @@
 #include <iostream>
 #include <fstream>
 #include <QDebug>
+#include <QFileInfo>
 using namespace std;
 
 
 File::File():QTreeWidgetItem()
 {
-
+    dltFile = 0;
+    fileData = 0;
+    spool = 0;
+    spoolError = false;
 }
 
 File::File(QDltFile *qfile,QTreeWidgetItem *parent):QTreeWidgetItem(parent)
 {
     dltFile = qfile;
+    fileData = 0;
+    spool = 0;
+    spoolError = false;
 
     receivedPackages = 0;
     //fileSerialNumber = -1;
@@ -48,7 +55,9 @@ File::File(QDltFile *qfile,QTreeWidgetItem *parent):QTreeWidgetItem(parent)
 
 File::~File()
 {
-
+    /* the spool file is removed together with the item */
+    delete spool;
+    delete fileData;
 }
 
 QString File::getFilename(){
@@ -94,14 +103,13 @@ void File::setFileCreationDate(QString f){
 }
 
 void File::setFileSerialNumber(QString s){
-    fileSerialNumber = s.toInt();
+    fileSerialNumber = s.toUInt();
     this->setText(COLUMN_FILEID, s);
 
 }
 
 void File::setPackages(QString p){
     packages = p.toInt();
-    dltFileIndex = new QList<int>[packages];
     this->setText(COLUMN_PACKAGES, p);
 }
 void File::increaseReceivedPackages(){
@@ -151,10 +159,53 @@ bool File::isComplete(){
     return receivedPackages == packages;
 }
 
-void File::setQFileIndexForPackage(QString packageNumber, int index){
-    int i = packageNumber.toInt();
-    dltFileIndex->insert(i-1,index);
+bool File::addPackage(unsigned int packageNumber, const QByteArray &data){
+
+    if(packageNumber < 1 || packageNumber > packages || (unsigned int)data.size() > buffer){
+        return false;
+    }
+
+    /* one bit for each package, the number of packages is known from the start message */
+    if(receivedMap.size() != (int)packages){
+        receivedMap.resize(packages);
+    }
+    if(receivedMap.testBit(packageNumber-1)){
+        return false;
+    }
+
+    if(!spool){
+        spool = new QTemporaryFile(QDir::tempPath()+"/dlt-viewer-filetransfer-XXXXXX");
+        if(!spool->open()){
+            spoolError = true;
+        }
+    }
+
+    receivedMap.setBit(packageNumber-1);
     increaseReceivedPackages();
+
+    bool ret = writePackage(packageNumber,data);
+
+    if(isComplete()){
+        /* do not keep a handle open for each transferred file */
+        spool->close();
+    }
+
+    return ret;
+}
+
+bool File::writePackage(unsigned int packageNumber, const QByteArray &data){
+
+    if(spoolError){
+        return false;
+    }
+
+    /* all packages but the last one have the buffer size */
+    if(!spool->seek((qint64)(packageNumber-1)*buffer) || spool->write(data) != data.size()){
+        spoolError = true;
+        return false;
+    }
+
+    return true;
 }
 
 
@@ -162,27 +213,28 @@ bool File::saveFile(QString newFile){
 
     //QString newFile = directory.append("/").append(getFilename());
 
+    if(!isComplete() || spoolError){
+        return false;
+    }
+
     if(QFile::exists(newFile)){
         if(!QFile::remove(newFile)){
             return false;
         }
     }
 
-    QByteArray *completeFileData = getFileData();
+    if(!spool){
+        /* transfer without any package */
+        QFile file(newFile);
+        return file.open(QIODevice::WriteOnly) && sizeInBytes == 0;
+    }
 
-    QFile file(newFile);
-    if (!file.open(QIODevice::WriteOnly)){
+    /* the data was already written while the log was read, only copy the spool file */
+    if(!QFile::copy(spool->fileName(),newFile)){
         return false;
     }
 
-    QDataStream stream( &file );
-    int writtenBytes = stream.writeRawData(*completeFileData,completeFileData->size());
-
-    file.close();
-
-    freeFile();
-
-    if((unsigned int)writtenBytes != sizeInBytes){
+    if((unsigned int)QFileInfo(newFile).size() != sizeInBytes){
         return false;
     }
 
@@ -191,21 +243,26 @@ bool File::saveFile(QString newFile){
 
 void File::freeFile(){
     delete fileData;
+    fileData = 0;
 }
 
 QByteArray* File::getFileData(){
-   QDltMsg msg;
-   QByteArray msgBuffer;
-   QDltArgument data;
-
-   fileData = new QByteArray();
-
-    for(unsigned int i=0; i<packages;i++){
-       int qfileIdx = dltFileIndex->value(i);
-       msgBuffer =  dltFile->getMsg(qfileIdx);
-       msg.setMsg(msgBuffer);
-       msg.getArgument(PROTOCOL_FLDA_DATA,data);
-       fileData->append(data.getData());
+
+    if(fileData){
+        /* still loaded, released by freeFile */
+        return fileData;
+    }
+
+    fileData = new QByteArray();
+
+    if(!spool || spoolError){
+        return fileData;
+    }
+
+    QFile file(spool->fileName());
+    if(file.open(QIODevice::ReadOnly)){
+        *fileData = file.readAll();
+        file.close();
     }
 
     return fileData;
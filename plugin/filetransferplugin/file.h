@@ -24,7 +24,8 @@
 #include <QTreeWidgetItem>
 #include <QFile>
 #include <QDir>
-#include <QList>
+#include <QBitArray>
+#include <QTemporaryFile>
 #include "globals.h"
 #include "qdlt.h"
 
@@ -60,7 +61,17 @@ public:
      void errorHappens(QString filename, QString errorCode1, QString errorCode2, QString time);
 
      bool isComplete();
-     void setQFileIndexForPackage(QString packageNumber, int index);
+
+     //! Add the payload of a received package to the file.
+     /*!
+       Each package is written to its position in a temporary spool file while
+       the log is read, so packages received out of order need no memory.
+       Duplicated packages and packages larger than the buffer size are ignored.
+       \param packageNumber number of the package, starting with 1
+       \param data payload of the package
+       \return true if the package was added, false if it was ignored or could not be written
+     */
+     bool addPackage(unsigned int packageNumber, const QByteArray &data);
 
      bool saveFile(QString newFile);
 
@@ -75,9 +86,14 @@ private:
     unsigned int sizeInBytes;
     unsigned int buffer;
 
-    QList<int> *dltFileIndex;
     QDltFile *dltFile;
     QByteArray *fileData;
+
+    QTemporaryFile *spool;
+    QBitArray receivedMap;
+    bool spoolError;
+
+    bool writePackage(unsigned int packageNumber, const QByteArray &data);
 };
 
 #endif // FILE_H
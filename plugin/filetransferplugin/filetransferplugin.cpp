@@ -21,6 +21,24 @@
 #include "filetransferplugin.h"
 #include "file.h"
 #include <QDir>
+#include <QtConcurrentMap>
+
+/* Save one complete file, called in parallel for all files by exportAll. */
+class FileExporter
+{
+public:
+    typedef bool result_type;
+
+    FileExporter(const QString &path) : path(path) {}
+
+    bool operator()(File *file)
+    {
+        return file->saveFile(path+"//"+file->getFilename());
+    }
+
+private:
+    QString path;
+};
 
 FiletransferPlugin::FiletransferPlugin() {
     dltFile = 0;
@@ -140,12 +158,13 @@ void FiletransferPlugin::selectedIdxMsgDecoded(int index, QDltMsg &msg){
 void FiletransferPlugin::initFileStart(QDltFile *file){
     dltFile = file;
 
+    files.clear();
     form->getTreeWidget()->clear();
     form->clearSelectedFiles();
 }
 
 void FiletransferPlugin::initMsg(int index, QDltMsg &msg){
-    updateFiletransfer(index,msg);
+    updateFiletransfer(msg);
 }
 
 void FiletransferPlugin::initMsgDecoded(int index, QDltMsg &msg){
@@ -161,7 +180,7 @@ void FiletransferPlugin::updateFileStart(){
 }
 
 void FiletransferPlugin::updateMsg(int index, QDltMsg &msg){
-    updateFiletransfer(index,msg);
+    updateFiletransfer(msg);
 
 }
 
@@ -173,7 +192,7 @@ void FiletransferPlugin::updateFileFinish(){
 
 }
 
-void FiletransferPlugin::updateFiletransfer(int index, QDltMsg &msg) {
+void FiletransferPlugin::updateFiletransfer(QDltMsg &msg) {
 
     QDltArgument msgFirstArgument;
     QDltArgument msgLastArgument;
@@ -204,7 +223,7 @@ void FiletransferPlugin::updateFiletransfer(int index, QDltMsg &msg) {
             msg.getArgument(PROTOCOL_FLDA_ENDFLAG,msgLastArgument);
             if(msgLastArgument.toString().compare(config.getFldaTag()) == 0)
             {
-                doFLDA(index,&msg);
+                doFLDA(&msg);
             }
             return;
         }
@@ -262,39 +281,41 @@ void FiletransferPlugin::doFLST(QDltMsg *msg){
     msg->getArgument(PROTOCOL_FLST_BUFFERSIZE,argument);
     file->setBuffersize(argument.toString());
 
-    QList<QTreeWidgetItem *> result = form->getTreeWidget()->findItems(file->getFileSerialNumber(),Qt::MatchExactly | Qt::MatchRecursive,COLUMN_FILEID);
+    /* the files are found by the serial number as it is sent in FLDA and FLFI */
+    File *previous = files.value(file->text(COLUMN_FILEID));
 
-    if(result.isEmpty()){
-        form->getTreeWidget()->addTopLevelItem(file);
-    }
-    else
+    if(previous)
     {
-      int index = form->getTreeWidget()->indexOfTopLevelItem(result.at(0));
-      form->getTreeWidget()->takeTopLevelItem(index);
-      form->getTreeWidget()->addTopLevelItem(file);
+      /* a new transfer with the same serial number replaces the old one */
+      int index = form->getTreeWidget()->indexOfTopLevelItem(previous);
+      delete form->getTreeWidget()->takeTopLevelItem(index);
     }
+    form->getTreeWidget()->addTopLevelItem(file);
+    files.insert(file->text(COLUMN_FILEID),file);
 
 }
 
-void FiletransferPlugin::doFLDA(int index,QDltMsg *msg){
+void FiletransferPlugin::doFLDA(QDltMsg *msg){
     QDltArgument argument;
     msg->getArgument(PROTOCOL_FLDA_FILEID,argument);
 
-    QList<QTreeWidgetItem *> result = form->getTreeWidget()->findItems(argument.toString(),Qt::MatchExactly | Qt::MatchRecursive,COLUMN_FILEID);
+    File *file = files.value(argument.toString());
 
-    if(result.isEmpty())
+    if(!file)
     {
         //Transfer for this file started before sending FLST
     }
     else
     {
-        File *file = (File*)result.at(0);
         if(!file->isComplete())
         {
             QDltArgument packageNumber;
             msg->getArgument(PROTOCOL_FLDA_PACKAGENR,packageNumber);
 
-            file->setQFileIndexForPackage(packageNumber.toString(),index);
+            QDltArgument data;
+            msg->getArgument(PROTOCOL_FLDA_DATA,data);
+
+            file->addPackage(packageNumber.toString().toUInt(),data.getData());
         }
     }
 }
@@ -303,15 +324,14 @@ void FiletransferPlugin::doFLFI(QDltMsg *msg){
     QDltArgument argument;
     msg->getArgument(PROTOCOL_FLFI_FILEID,argument);
 
-    QList<QTreeWidgetItem *> result = form->getTreeWidget()->findItems(argument.toString(),Qt::MatchExactly | Qt::MatchRecursive,COLUMN_FILEID);
+    File *file = files.value(argument.toString());
 
-    if(result.isEmpty())
+    if(!file)
     {
         //Transfer for this file started before sending FLST
     }
     else
     {
-        File *file = (File*)result.at(0);
         if(file->isComplete())
         {
             file->setComplete();
@@ -341,6 +361,8 @@ void FiletransferPlugin::doFLER(QDltMsg *msg){
     else
     {
        file = (File*)result.at(0);
+       if(files.value(file->text(COLUMN_FILEID)) == file)
+           files.remove(file->text(COLUMN_FILEID));
        int index = form->getTreeWidget()->indexOfTopLevelItem(result.at(0));
        form->getTreeWidget()->takeTopLevelItem(index);
        form->getTreeWidget()->addTopLevelItem(file);
@@ -381,21 +403,34 @@ bool FiletransferPlugin::exportAll(QString path)
         errorText = "No filetransfer files in the loaded DLT file.";
         return false;
     }
+
+    /* the last transfer of a file name wins, as when the files are saved one after the other */
+    QMap<QString,File*> exports;
     while (*it) {
         File *tmp = dynamic_cast<File*>(*it);
         if (tmp != NULL && tmp->isComplete()) {
-            QString absolutePath = path+"//"+tmp->getFilename();
-            if(!tmp->saveFile(absolutePath) ){
-                ret = false;
-                errorText += ", " + tmp->getFilenameOnTarget();
-            }
-            else
-            {
-                qDebug() << "Exported: " << absolutePath;
-            }
+            exports.insert(tmp->getFilename(),tmp);
         }
         ++it;
-        QApplication::processEvents();
+    }
+
+    /* the files are already spooled to disk, copy them in parallel */
+    QList<File*> list = exports.values();
+    QFuture<bool> future = QtConcurrent::mapped(list,FileExporter(path));
+    future.waitForFinished();
+
+    for(int num=0;num<list.size();num++)
+    {
+        QString absolutePath = path+"//"+list[num]->getFilename();
+        if(!future.resultAt(num))
+        {
+            ret = false;
+            errorText += ", " + list[num]->getFilenameOnTarget();
+        }
+        else
+        {
+            qDebug() << "Exported: " << absolutePath;
+        }
     }
     return ret;
 }
@@ -21,6 +21,7 @@
 #define DLTVIEWERPLUGIN_H
 
 #include <QObject>
+#include <QHash>
 #include "plugininterface.h"
 #include "form.h"
 #include "globals.h"
@@ -62,7 +63,7 @@ public:
     void selectedIdxMsg(int index, QDltMsg &msg);
     void selectedIdxMsgDecoded(int index, QDltMsg &msg);
 
-    void updateFiletransfer(int index, QDltMsg &msg);
+    void updateFiletransfer(QDltMsg &msg);
     void show(bool value);
 
     /* QDltPluginCommandInterface */
@@ -74,8 +75,11 @@ private:
     QDltFile *dltFile;
     QString errorText;
 
+    /* transfers by the file serial number argument of FLST, looked up for each data package */
+    QHash<QString,File*> files;
+
     void doFLST(QDltMsg *msg);
-    void doFLDA(int index, QDltMsg *msg);
+    void doFLDA(QDltMsg *msg);
     void doFLFI(QDltMsg *msg);
     void doFLIF(QDltMsg *msg);
     void doFLER(QDltMsg *msg);
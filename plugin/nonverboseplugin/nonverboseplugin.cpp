@@ -21,6 +21,10 @@
 
 #include "nonverboseplugin.h"
 
+/* Identification of the binary cache of the FIBEX catalogue. */
+#define NON_VERBOSE_CACHE_MAGIC 0x4e564346
+#define NON_VERBOSE_CACHE_VERSION 1
+
 extern char *message_type[];
 extern const char *log_info[];
 extern const char *trace_type[];
@@ -54,22 +58,98 @@ QString NonverbosePlugin::error()
 
 bool NonverbosePlugin::loadConfig(QString filename)
 {
+    QWriteLocker locker(&catalogueLock);
+
     /* remove all stored items */
+    clearCatalogue();
+
+    /* a directory contains several FIBEX files merged into one catalogue */
+    QStringList files;
+    QFileInfo info(filename);
+    if(info.isDir())
+    {
+        QDir dir(filename);
+        foreach(QString name, dir.entryList(QStringList() << "*.xml", QDir::Files, QDir::Name))
+            files.append(dir.absoluteFilePath(name));
+    }
+    else
+    {
+        files.append(filename);
+    }
+
+    QByteArray key = cacheKey(files);
+    if(key.isEmpty())
+        return false;
+
+    QString warning_text;
+    QString error_text;
+    QString cacheName = cacheFileName(key);
+
+    if(!loadCache(cacheName, warning_text))
+    {
+        clearCatalogue();
+        warning_text.clear();
+
+        foreach(QString name, files)
+        {
+            if(!parseFibex(name, warning_text, error_text))
+                return false;
+        }
+
+        /* create PDU Ref links */
+        foreach(DltFibexFrame *frame, framemap)
+        {
+            foreach(DltFibexPduRef *ref, frame->pdureflist)
+                ref->ref = pdumap.value(ref->id);
+        }
+
+        /* a file with XML errors is parsed again next time, so the error is shown again */
+        if(error_text.isEmpty())
+            saveCache(cacheName, warning_text);
+    }
+
+    createPlans();
+
+    /* the GUI thread may decode messages while a message box is shown */
+    locker.unlock();
+
+    if (error_text.length()){
+        QMessageBox::warning(0, QString("XML Parser error"),
+                             error_text);
+    }
+
+    if (warning_text.length()){
+        warning_text.chop(2); // remove last ", "
+        QMessageBox::warning(0, QString("Duplicated FRAMES ignored:"),
+                              warning_text);
+    }
+
+    return true;
+}
+
+void NonverbosePlugin::clearCatalogue()
+{
     foreach(DltFibexPdu *pdu, pdumap)
         delete pdu;
     pdumap.clear();
 
     foreach(DltFibexFrame *frame, framemap)
+    {
+        qDeleteAll(frame->pdureflist);
         delete frame;
+    }
     framemap.clear();
+    planmap.clear();
+}
 
+bool NonverbosePlugin::parseFibex(const QString &filename, QString &warning_text, QString &error_text)
+{
     QFile file(filename);
     if (!file.open(QFile::ReadOnly | QFile::Text))
     {
              return false;
     }
 
-    QString warning_text;
     DltFibexPdu *pdu = 0;
     DltFibexFrame *frame = 0;
 
@@ -79,20 +159,20 @@ bool NonverbosePlugin::loadConfig(QString filename)
 
           if(xml.isStartElement())
           {
-              if(xml.name() == QString("PDU"))
+              if(xml.name() == QLatin1String("PDU"))
               {
                   if(!pdu)
                   {
                     pdu = new DltFibexPdu();
-                    pdu->id = xml.attributes().value(QString("ID")).toString();
+                    pdu->id = xml.attributes().value(QLatin1String("ID")).toString();
                   }
               }
-              if(xml.name() == QString("DESC"))
+              if(xml.name() == QLatin1String("DESC"))
               {
                   if(pdu)
                       pdu->description = xml.readElementText();
               }
-              if(xml.name() == QString("BYTE-LENGTH"))
+              if(xml.name() == QLatin1String("BYTE-LENGTH"))
               {
                   if(frame)
                       frame->byteLength = xml.readElementText().toInt();
@@ -100,11 +180,11 @@ bool NonverbosePlugin::loadConfig(QString filename)
                       pdu->byteLength = xml.readElementText().toInt();
 
               }
-              if(xml.name() == QString("SIGNAL-INSTANCE"))
+              if(xml.name() == QLatin1String("SIGNAL-INSTANCE"))
               {
                   // nothing todo
               }
-              if(xml.name() == QString("SIGNAL-REF"))
+              if(xml.name() == QLatin1String("SIGNAL-REF"))
               {
                   if(pdu)
                   {
@@ -190,36 +270,36 @@ bool NonverbosePlugin::loadConfig(QString filename)
                       }
                   }
               }
-              if(xml.name() == QString("FRAME"))
+              if(xml.name() == QLatin1String("FRAME"))
               {
                   if(!frame)
                   {
                     frame = new DltFibexFrame();
-                    frame->id = xml.attributes().value(QString("ID")).toString();
+                    frame->id = xml.attributes().value(QLatin1String("ID")).toString();
                   }
               }
-              if(xml.name() == QString("MANUFACTURER-EXTENSION"))
+              if(xml.name() == QLatin1String("MANUFACTURER-EXTENSION"))
               {
                   // nothing todo
               }
-              if(xml.name() == QString("MESSAGE_TYPE"))
+              if(xml.name() == QLatin1String("MESSAGE_TYPE"))
               {
                   if(frame)
                   {
                       QString text = xml.readElementText();
-                      if (text == QString("DLT_TYPE_LOG"))
+                      if (text == QLatin1String("DLT_TYPE_LOG"))
                       {
                             frame->messageType = DLT_TYPE_LOG;
                       }
-                      else if (text == QString("DLT_TYPE_APP_TRACE"))
+                      else if (text == QLatin1String("DLT_TYPE_APP_TRACE"))
                       {
                           frame->messageType = DLT_TYPE_APP_TRACE;
                       }
-                      else if (text == QString("DLT_TYPE_NW_TRACE"))
+                      else if (text == QLatin1String("DLT_TYPE_NW_TRACE"))
                       {
                           frame->messageType = DLT_TYPE_NW_TRACE;
                       }
-                      else if (text == QString("DLT_TYPE_CONTROL"))
+                      else if (text == QLatin1String("DLT_TYPE_CONTROL"))
                       {
                           frame->messageType = DLT_TYPE_CONTROL;
                       }
@@ -229,40 +309,40 @@ bool NonverbosePlugin::loadConfig(QString filename)
                       }
                   }
               }
-              if(xml.name() == QString("MESSAGE_INFO"))
+              if(xml.name() == QLatin1String("MESSAGE_INFO"))
               {
                   if(frame)
                   {
                       QString text = xml.readElementText();
-                      if (text == QString("DLT_LOG_DEFAULT"))
+                      if (text == QLatin1String("DLT_LOG_DEFAULT"))
                       {
                           frame->messageInfo = DLT_LOG_DEFAULT;
                       }
-                      else if (text == QString("DLT_LOG_OFF"))
+                      else if (text == QLatin1String("DLT_LOG_OFF"))
                       {
                           frame->messageInfo = DLT_LOG_OFF;
                       }
-                      else if (text == QString("DLT_LOG_FATAL"))
+                      else if (text == QLatin1String("DLT_LOG_FATAL"))
                       {
                           frame->messageInfo = DLT_LOG_FATAL;
                       }
-                      else if (text == QString("DLT_LOG_ERROR"))
+                      else if (text == QLatin1String("DLT_LOG_ERROR"))
                       {
                           frame->messageInfo = DLT_LOG_ERROR;
                       }
-                      else if (text == QString("DLT_LOG_WARN"))
+                      else if (text == QLatin1String("DLT_LOG_WARN"))
                       {
                           frame->messageInfo = DLT_LOG_WARN;
                       }
-                      else if (text == QString("DLT_LOG_INFO"))
+                      else if (text == QLatin1String("DLT_LOG_INFO"))
                       {
                           frame->messageInfo = DLT_LOG_INFO;
                       }
-                      else if (text == QString("DLT_LOG_DEBUG"))
+                      else if (text == QLatin1String("DLT_LOG_DEBUG"))
                       {
                           frame->messageInfo = DLT_LOG_DEBUG;
                       }
-                      else if (text == QString("DLT_LOG_VERBOSE"))
+                      else if (text == QLatin1String("DLT_LOG_VERBOSE"))
                       {
                           frame->messageInfo = DLT_LOG_VERBOSE;
                       }
@@ -272,29 +352,29 @@ bool NonverbosePlugin::loadConfig(QString filename)
                       }
                   }
               }
-              if(xml.name() == QString("APPLICATION_ID"))
+              if(xml.name() == QLatin1String("APPLICATION_ID"))
               {
                   if(frame)
                   {
                       frame->appid = xml.readElementText();
                   }
               }
-              if(xml.name() == QString("CONTEXT_ID"))
+              if(xml.name() == QLatin1String("CONTEXT_ID"))
               {
                   if(frame)
                   {
                       frame->ctid = xml.readElementText();
                   }
               }
-              if(xml.name() == QString("PDU-INSTANCE"))
+              if(xml.name() == QLatin1String("PDU-INSTANCE"))
               {
               }
-              if(xml.name() == QString("PDU-REF"))
+              if(xml.name() == QLatin1String("PDU-REF"))
               {
                   if(frame)
                   {
                       DltFibexPduRef *ref = new DltFibexPduRef();
-                      ref->id = xml.attributes().value(QString("ID-REF")).toString();
+                      ref->id = xml.attributes().value(QLatin1String("ID-REF")).toString();
                       frame->pdureflist.append(ref);
                       frame->pduRefCounter++;
                   }
@@ -302,33 +382,36 @@ bool NonverbosePlugin::loadConfig(QString filename)
           }
           if(xml.isEndElement())
           {
-              if(xml.name() == QString("PDU"))
+              if(xml.name() == QLatin1String("PDU"))
               {
                   if(pdu)
                   {
+                      /* a PDU defined again replaces the PDU before */
+                      delete pdumap.value(pdu->id);
                       pdumap[pdu->id] = pdu;
                       pdu = 0;
                   }
               }
-              if(xml.name() == QString("DESC"))
+              if(xml.name() == QLatin1String("DESC"))
               {
               }
-              if(xml.name() == QString("BYTE-LENGTH"))
+              if(xml.name() == QLatin1String("BYTE-LENGTH"))
               {
               }
-              if(xml.name() == QString("SIGNAL-INSTANCE"))
+              if(xml.name() == QLatin1String("SIGNAL-INSTANCE"))
               {
               }
-              if(xml.name() == QString("SIGNAL-REF"))
+              if(xml.name() == QLatin1String("SIGNAL-REF"))
               {
               }
-              if(xml.name() == QString("FRAME"))
+              if(xml.name() == QLatin1String("FRAME"))
               {
                   if(frame)
                   {
                       if (framemap.contains(frame->id)){
                           // we don't add another instance but add a warning msgbox.
                           warning_text+=frame->id + ", ";
+                          qDeleteAll(frame->pdureflist);
                           delete frame;
                       }else{
                         framemap[frame->id] = frame;
@@ -336,60 +419,229 @@ bool NonverbosePlugin::loadConfig(QString filename)
                       frame = 0;
                   }
               }
-              if(xml.name() == QString("MANUFACTURER-EXTENSION"))
+              if(xml.name() == QLatin1String("MANUFACTURER-EXTENSION"))
               {
               }
-              if(xml.name() == QString("MESSAGE_TYPE"))
+              if(xml.name() == QLatin1String("MESSAGE_TYPE"))
               {
               }
-              if(xml.name() == QString("MESSAGE_INFO"))
+              if(xml.name() == QLatin1String("MESSAGE_INFO"))
               {
               }
-              if(xml.name() == QString("APPLICATION_ID"))
+              if(xml.name() == QLatin1String("APPLICATION_ID"))
               {
               }
-              if(xml.name() == QString("CONTEXT_ID"))
+              if(xml.name() == QLatin1String("CONTEXT_ID"))
               {
               }
-              if(xml.name() == QString("PDU-INSTANCE"))
+              if(xml.name() == QLatin1String("PDU-INSTANCE"))
               {
               }
-              if(xml.name() == QString("PDU-REF"))
+              if(xml.name() == QLatin1String("PDU-REF"))
               {
               }
 
           }
     }
     if (xml.hasError()) {
-        QMessageBox::warning(0, QString("XML Parser error"),
-                             xml.errorString());
+        error_text += filename + ": " + xml.errorString() + "\n";
     }
 
     file.close();
 
-    if (warning_text.length()){
-        warning_text.chop(2); // remove last ", "
-        QMessageBox::warning(0, QString("Duplicated FRAMES ignored:"),
-                              warning_text);
+    delete pdu;
+    if(frame)
+        qDeleteAll(frame->pdureflist);
+    delete frame;
+
+    return true;
+}
+
+QByteArray NonverbosePlugin::cacheKey(const QStringList &files)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+
+    /* the key changes with the content of any source file and with the cache format */
+    hash.addData(QByteArray::number(NON_VERBOSE_CACHE_VERSION));
+    foreach(QString name, files)
+    {
+        QFile file(name);
+        if(!file.open(QFile::ReadOnly))
+            return QByteArray();
+
+        hash.addData(name.toUtf8());
+        while(!file.atEnd())
+            hash.addData(file.read(1024*1024));
     }
 
-    /* create PDU Ref links */
+    return hash.result().toHex();
+}
+
+QString NonverbosePlugin::cacheFileName(const QByteArray &key)
+{
+    QString path = QDesktopServices::storageLocation(QDesktopServices::CacheLocation);
+    if(path.isEmpty())
+        path = QDir::tempPath();
+
+    return QDir(path).absoluteFilePath(QString("nonverboseplugin/%1.cache").arg(QString(key)));
+}
+
+bool NonverbosePlugin::loadCache(const QString &filename, QString &warning_text)
+{
+    QFile file(filename);
+    if(!file.open(QFile::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_6);
+
+    quint32 magic, version, count;
+    stream >> magic >> version;
+    if(magic != NON_VERBOSE_CACHE_MAGIC || version != NON_VERBOSE_CACHE_VERSION)
+        return false;
+
+    stream >> warning_text;
+
+    stream >> count;
+    for(quint32 num=0;num<count && stream.status() == QDataStream::Ok;num++)
+    {
+        DltFibexPdu *pdu = new DltFibexPdu();
+        stream >> pdu->id >> pdu->description >> pdu->byteLength >> pdu->typeInfo;
+        pdumap[pdu->id] = pdu;
+    }
+
+    stream >> count;
+    for(quint32 num=0;num<count && stream.status() == QDataStream::Ok;num++)
+    {
+        DltFibexFrame *frame = new DltFibexFrame();
+        QStringList refs;
+        qint8 messageInfo;
+        stream >> frame->id >> frame->byteLength >> frame->messageType >> messageInfo;
+        stream >> frame->appid >> frame->ctid >> refs;
+        frame->messageInfo = messageInfo;
+        foreach(QString id, refs)
+        {
+            DltFibexPduRef *ref = new DltFibexPduRef();
+            ref->id = id;
+            ref->ref = pdumap.value(id);
+            frame->pdureflist.append(ref);
+        }
+        frame->pduRefCounter = refs.size();
+        framemap[frame->id] = frame;
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+void NonverbosePlugin::saveCache(const QString &filename, const QString &warning_text)
+{
+    QDir().mkpath(QFileInfo(filename).absolutePath());
+
+    /* written to a temporary file first, an aborted write never leaves a broken cache */
+    QFile file(filename + ".tmp");
+    if(!file.open(QFile::WriteOnly | QFile::Truncate))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_6);
+
+    stream << (quint32)NON_VERBOSE_CACHE_MAGIC << (quint32)NON_VERBOSE_CACHE_VERSION;
+    stream << warning_text;
+
+    stream << (quint32)pdumap.size();
+    foreach(DltFibexPdu *pdu, pdumap)
+        stream << pdu->id << pdu->description << pdu->byteLength << pdu->typeInfo;
+
+    stream << (quint32)framemap.size();
     foreach(DltFibexFrame *frame, framemap)
     {
+        QStringList refs;
+        foreach(DltFibexPduRef *ref, frame->pdureflist)
+            refs.append(ref->id);
+        stream << frame->id << frame->byteLength << frame->messageType << (qint8)frame->messageInfo;
+        stream << frame->appid << frame->ctid << refs;
+    }
+
+    file.close();
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        file.remove();
+        return;
+    }
+
+    QFile::remove(filename);
+    file.rename(filename);
+}
+
+void NonverbosePlugin::createPlans()
+{
+    foreach(DltFibexFrame *frame, framemap)
+    {
+        /* only frames with the id of a message id are ever used */
+        bool ok;
+        uint32_t id = frame->id.mid(3).toUInt(&ok);
+        if(!ok || !frame->id.startsWith("ID_") || QString("ID_%1").arg(id) != frame->id)
+            continue;
+
+        DltFibexPlan plan;
+        int offset = 4;
+
+        plan.frame = frame;
         foreach(DltFibexPduRef *ref, frame->pdureflist)
         {
-            foreach(DltFibexPdu *pdu, pdumap)
+            DltFibexPdu *pdu = ref->ref;
+            if(!pdu)
+                continue;
+
+            DltFibexPlanArgument argument;
+            argument.offset = offset;
+            if(!pdu->description.isEmpty())
             {
-                if(pdu->id == ref->id)
+                /* constant text, no payload is used */
+                argument.typeInfo = QDltArgument::DltTypeInfoStrg;
+                argument.description = pdu->description.toAscii();
+            }
+            else
+            {
+                argument.typeInfo = (QDltArgument::DltTypeInfoDef)(pdu->typeInfo);
+                if( (pdu->typeInfo == QDltArgument::DltTypeInfoStrg) || (pdu->typeInfo == QDltArgument::DltTypeInfoRawd))
                 {
-                    ref->ref = pdu;
-                    break;
+                    argument.byteLength = -1;
+                    offset = -1;
+                }
+                else
+                {
+                    argument.byteLength = pdu->byteLength;
+                    if(offset >= 0)
+                        offset += pdu->byteLength;
                 }
             }
+            plan.arguments.append(argument);
         }
+
+        planmap[id] = plan;
     }
+}
 
-    return true;
+const DltFibexPlan *NonverbosePlugin::findPlan(QDltMsg &msg)
+{
+    if((msg.getMode() != QDltMsg::DltModeNonVerbose))
+    {
+        /* message is not a non-verbose message */
+        return 0;
+    }
+    if((msg.getType() == QDltMsg::DltTypeControl))
+    {
+        /* message is a control message */
+        return 0;
+    }
+
+    QHash<uint32_t, DltFibexPlan>::const_iterator plan = planmap.constFind(msg.getMessageId());
+    if(plan == planmap.constEnd())
+        return 0;
+
+    return &plan.value();
 }
 
 bool NonverbosePlugin::saveConfig(QString /*filename*/)
@@ -427,42 +679,29 @@ bool NonverbosePlugin::isMsg(QDltMsg &msg, int triggeredByUser)
 {
     Q_UNUSED(triggeredByUser)
 
-    if((msg.getMode() != QDltMsg::DltModeNonVerbose))
-    {
-        /* message is not a non-verbose message */
-        return false;
-    }
-    if((msg.getType() == QDltMsg::DltTypeControl))
-    {
-        /* message is a control message */
-        return false;
-    }
+    QReadLocker locker(&catalogueLock);
 
-    QString idtext = QString("ID_%1").arg(msg.getMessageId());
-    return framemap.contains(idtext);
+    return findPlan(msg) != 0;
 }
 
 bool NonverbosePlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
 {
     Q_UNUSED(triggeredByUser)
-    int offset = 4;
 
-    if((msg.getMode() != QDltMsg::DltModeNonVerbose))
-    {
-        /* message is not a non-verbose message */
-        return false;
-    }
-    if((msg.getType() == QDltMsg::DltTypeControl))
-    {
-        /* message is a control message */
-        return false;
-    }
+    QReadLocker locker(&catalogueLock);
+
+    return decodeMsgUnlocked(msg);
+}
 
-    QString idtext = QString("ID_%1").arg(msg.getMessageId());
-    if(!framemap.contains(idtext))
+bool NonverbosePlugin::decodeMsgUnlocked(QDltMsg &msg)
+{
+    int offset = 4;
+
+    const DltFibexPlan *plan = findPlan(msg);
+    if(!plan)
         return false;
 
-    DltFibexFrame *frame = framemap[idtext];
+    DltFibexFrame *frame = plan->frame;
 
     /* set message data */
     msg.setApid(frame->appid);
@@ -471,53 +710,75 @@ bool NonverbosePlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
     msg.setType((QDltMsg::DltTypeDef)(frame->messageType));
     msg.setSubtype(frame->messageInfo);
     QByteArray payload = msg.getPayload();
+    QDlt::DltEndiannessDef endianness = msg.getEndianness();
 
-    /* Look for all PDUs for this message */
-    for (int i=0;i < frame->pdureflist.size();i++)
+    /* Fill the arguments as planned when the configuration was loaded */
+    for (int i=0;i < plan->arguments.size();i++)
     {
+        const DltFibexPlanArgument &planArgument = plan->arguments[i];
         QDltArgument argument;
-        QByteArray data;
-        unsigned short length;
-        DltFibexPdu *pdu = frame->pdureflist[i]->ref;
-        if(pdu)
-        {
-            if(!pdu->description.isEmpty()) {
-                argument.setTypeInfo(QDltArgument::DltTypeInfoStrg);
-                argument.setEndianness(msg.getEndianness());
-                argument.setOffsetPayload(offset);
-                data.append(pdu->description);
-                argument.setData(data);
-            }
-            else {
-                argument.setTypeInfo((QDltArgument::DltTypeInfoDef)(pdu->typeInfo));
-                argument.setEndianness(msg.getEndianness());
-                argument.setOffsetPayload(offset);
 
-                if( (pdu->typeInfo == QDltArgument::DltTypeInfoStrg) || (pdu->typeInfo == QDltArgument::DltTypeInfoRawd))
-                {
-                    if((unsigned int)payload.size()<(offset+sizeof(unsigned short)))
-                        break;
-                    if(argument.getEndianness() == QDltMsg::DltEndiannessLittleEndian)
-                        length = *((unsigned short*) (payload.constData()+offset));
-                    else
-                        length = DLT_SWAP_16(*((unsigned short*) (payload.constData()+offset)));
-                    offset += sizeof(unsigned short);
-                    argument.setData(payload.mid(offset,length));
-                    offset += length;
-                }
-                else
-                {
-                    argument.setData(payload.mid(offset,pdu->byteLength));
-                    offset += pdu->byteLength;
-                }
+        if(planArgument.offset >= 0)
+            offset = planArgument.offset;
 
-            }
+        argument.setTypeInfo(planArgument.typeInfo);
+        argument.setEndianness(endianness);
+        argument.setOffsetPayload(offset);
 
-            msg.addArgument(argument);
+        if(!planArgument.description.isEmpty())
+        {
+            argument.setData(planArgument.description);
+        }
+        else if(planArgument.byteLength < 0)
+        {
+            unsigned short length;
+
+            if(payload.size() < offset+(int)sizeof(unsigned short))
+                break;
+            memcpy(&length,payload.constData()+offset,sizeof(unsigned short));
+            if(endianness != QDltMsg::DltEndiannessLittleEndian)
+                length = DLT_SWAP_16(length);
+            offset += sizeof(unsigned short);
+            argument.setData(payload.mid(offset,length));
+            offset += length;
+        }
+        else
+        {
+            argument.setData(payload.mid(offset,planArgument.byteLength));
+            offset += planArgument.byteLength;
         }
+
+        msg.addArgument(argument);
     }
 
     return true;
 }
 
+QList<QDltDecoderClaim> NonverbosePlugin::claims()
+{
+    QList<QDltDecoderClaim> list;
+
+    /* only non-verbose messages with the id of a frame are passed to the plugin */
+    foreach(uint32_t id, planmap.keys())
+        list.append(QDltDecoderClaim::nonVerboseId(id));
+
+    return list;
+}
+
+void NonverbosePlugin::decodeMsgs(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser)
+{
+    Q_UNUSED(triggeredByUser)
+
+    QReadLocker locker(&catalogueLock);
+
+    for(int num=0;num<msgs.size();num++)
+        decoded[num] = decodeMsgUnlocked(*msgs[num]);
+}
+
+QDltPluginThreadSafetyInterface::ThreadSafetyDef NonverbosePlugin::threadSafety()
+{
+    /* The decode plans are only read while decoding, so the plugin may be called concurrently. */
+    return ThreadSafetyReentrant;
+}
+
 Q_EXPORT_PLUGIN2(nonverboseplugin, NonverbosePlugin);
@@ -22,6 +22,7 @@
 
 #include <QObject>
 #include <QHash>
+#include <QReadWriteLock>
 #include "nonverboseplugin.h"
 #include "plugininterface.h"
 
@@ -69,11 +70,39 @@ public:
         uint32_t pduRefCounter;
 };
 
-class NonverbosePlugin : public QObject, QDLTPluginInterface, QDLTPluginDecoderInterface
+/**
+ * One argument of a precompiled decode plan.
+ */
+class DltFibexPlanArgument
+{
+public:
+    DltFibexPlanArgument() { typeInfo=QDltArgument::DltTypeInfoUnknown;byteLength=0;offset=-1; }
+
+        QDltArgument::DltTypeInfoDef typeInfo;
+        int32_t byteLength;   /* -1 if the argument starts with a 16 bit length */
+        int32_t offset;       /* fixed offset in the payload, -1 if behind an argument with variable length */
+        QByteArray description;
+};
+
+/**
+ * The decode plan of a frame, created when the configuration is loaded.
+ */
+class DltFibexPlan
+{
+public:
+    DltFibexPlan() { frame=0; }
+
+        DltFibexFrame *frame;
+        QVector<DltFibexPlanArgument> arguments;
+};
+
+class NonverbosePlugin : public QObject, QDLTPluginInterface, QDLTPluginDecoderInterface, QDLTPluginDecoderBatchInterface, QDltPluginThreadSafetyInterface
 {
     Q_OBJECT
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDLTPluginDecoderInterface)
+    Q_INTERFACES(QDLTPluginDecoderBatchInterface)
+    Q_INTERFACES(QDltPluginThreadSafetyInterface)
 
 public:
     /* QDLTPluginInterface interface */
@@ -90,9 +119,33 @@ public:
     bool isMsg(QDltMsg &msg, int triggeredByUser);
     bool decodeMsg(QDltMsg &msg, int triggeredByUser);
 
+    /* QDLTPluginDecoderBatchInterface */
+    QList<QDltDecoderClaim> claims();
+    void decodeMsgs(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser);
+
+    /* QDltPluginThreadSafetyInterface */
+    ThreadSafetyDef threadSafety();
+
     /* Faster lookup */
     QHash<QString, DltFibexPdu *> pdumap;
     QHash<QString, DltFibexFrame *> framemap;
+
+    /* Decode plans by message id */
+    QHash<uint32_t, DltFibexPlan> planmap;
+
+private:
+    /* the catalogue is only changed by loadConfig() while no message is decoded */
+    QReadWriteLock catalogueLock;
+
+    void clearCatalogue();
+    bool parseFibex(const QString &filename, QString &warning_text, QString &error_text);
+    QByteArray cacheKey(const QStringList &files);
+    QString cacheFileName(const QByteArray &key);
+    bool loadCache(const QString &filename, QString &warning_text);
+    void saveCache(const QString &filename, const QString &warning_text);
+    void createPlans();
+    const DltFibexPlan *findPlan(QDltMsg &msg);
+    bool decodeMsgUnlocked(QDltMsg &msg);
 };
 
 #endif // NONVERBOSEPLUGIN_H
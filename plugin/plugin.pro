@@ -2,4 +2,4 @@
 TEMPLATE = subdirs
 CONFIG   += ordered
 
-SUBDIRS  +=  dltviewerplugin nonverboseplugin filetransferplugin dltsystemviewerplugin dummycontrolplugin dummyviewerplugin dummycommandplugin dummydecoderplugin
+SUBDIRS  +=  dltviewerplugin nonverboseplugin filetransferplugin dltsystemviewerplugin dummycontrolplugin dummyviewerplugin dummycommandplugin dummydecoderplugin signalplugin
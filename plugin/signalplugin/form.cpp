@@ -0,0 +1,111 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file form.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "form.h"
+#include "ui_form.h"
+
+/* Colors of the plotted signals. */
+static const Qt::GlobalColor signalColors[] = { Qt::blue, Qt::red, Qt::darkGreen, Qt::magenta, Qt::darkCyan, Qt::darkYellow, Qt::black };
+
+Form::Form(QWidget *parent) :
+    QWidget(parent),
+    ui(new Ui::Form)
+{
+    ui->setupUi(this);
+
+    definitions = 0;
+    series = 0;
+
+    plot = new SignalPlot();
+    ui->gridLayout->addWidget(plot,2,0,1,2);
+    ui->gridLayout->setRowStretch(2,3);
+}
+
+Form::~Form()
+{
+    delete ui;
+}
+
+void Form::setSignals(const QList<SignalDefinition> *definitions, const QList<SignalSeries> *series)
+{
+    this->definitions = definitions;
+    this->series = series;
+
+    ui->treeWidget->blockSignals(true);
+    ui->treeWidget->clear();
+    for(int num=0;num<definitions->size();num++)
+    {
+        QTreeWidgetItem *item = new QTreeWidgetItem();
+        item->setText(0,definitions->at(num).name);
+        item->setText(1,definitions->at(num).toString());
+        item->setTextColor(0,signalColors[num % (sizeof(signalColors) / sizeof(signalColors[0]))]);
+        item->setCheckState(0,Qt::Checked);
+        ui->treeWidget->addTopLevelItem(item);
+    }
+    ui->treeWidget->blockSignals(false);
+
+    updatePlot();
+    updateSignals();
+}
+
+void Form::updateSignals()
+{
+    if(!series)
+        return;
+
+    ui->treeWidget->blockSignals(true);
+    for(int num=0;num<series->size() && num<ui->treeWidget->topLevelItemCount();num++)
+    {
+        const SignalSeries &current = series->at(num);
+        QTreeWidgetItem *item = ui->treeWidget->topLevelItem(num);
+        item->setText(2,QString("%1").arg(current.size()));
+        item->setText(3,current.size() ? QString::number(current.value(current.size() - 1),'g',10) : QString());
+    }
+    ui->treeWidget->blockSignals(false);
+
+    plot->dataChanged();
+}
+
+void Form::updatePlot()
+{
+    QList<const SignalSeries*> list;
+    QList<QColor> colors;
+
+    for(int num=0;series && num<series->size() && num<ui->treeWidget->topLevelItemCount();num++)
+    {
+        if(ui->treeWidget->topLevelItem(num)->checkState(0) == Qt::Checked)
+        {
+            list.append(&series->at(num));
+            colors.append(signalColors[num % (sizeof(signalColors) / sizeof(signalColors[0]))]);
+        }
+    }
+
+    plot->setSeries(list,colors);
+}
+
+void Form::on_comboBoxMode_currentIndexChanged(int index)
+{
+    plot->setMode(index == 1 ? SignalPlot::DownsampleLttb : SignalPlot::DownsampleMinMax);
+}
+
+void Form::on_treeWidget_itemChanged(QTreeWidgetItem * /* item */, int column)
+{
+    if(column == 0)
+        updatePlot();
+}
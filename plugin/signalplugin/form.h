@@ -0,0 +1,61 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file form.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef FORM_H
+#define FORM_H
+
+#include <QWidget>
+#include <QTreeWidgetItem>
+
+#include "signalseries.h"
+#include "signalplot.h"
+
+namespace Ui {
+    class Form;
+}
+
+class Form : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit Form(QWidget *parent = 0);
+    ~Form();
+
+    //! Show a new list of signals, all signals are plotted.
+    void setSignals(const QList<SignalDefinition> *definitions, const QList<SignalSeries> *series);
+
+    //! Show the samples added to the series.
+    void updateSignals();
+
+private slots:
+    void on_comboBoxMode_currentIndexChanged(int index);
+    void on_treeWidget_itemChanged(QTreeWidgetItem *item, int column);
+
+private:
+    Ui::Form *ui;
+
+    SignalPlot *plot;
+    const QList<SignalDefinition> *definitions;
+    const QList<SignalSeries> *series;
+
+    void updatePlot();
+};
+
+#endif // FORM_H
@@ -0,0 +1,250 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file signalplot.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QPainter>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QDateTime>
+
+#include "signalplot.h"
+
+SignalPlot::SignalPlot(QWidget *parent) :
+    QWidget(parent)
+{
+    mode = DownsampleMinMax;
+    zoomed = false;
+    viewStart = 0;
+    viewStop = 0;
+    dragX = 0;
+    pointsValid = false;
+    pointsStart = 0;
+    pointsStop = 0;
+    pointsWidth = 0;
+    samples = 0;
+
+    setMinimumSize(200,100);
+}
+
+void SignalPlot::setSeries(const QList<const SignalSeries*> &series, const QList<QColor> &colors)
+{
+    this->series = series;
+    this->colors = colors;
+    pointsValid = false;
+    update();
+}
+
+void SignalPlot::setMode(DownsampleMode mode)
+{
+    this->mode = mode;
+    pointsValid = false;
+    update();
+}
+
+void SignalPlot::dataChanged()
+{
+    pointsValid = false;
+    update();
+}
+
+QRect SignalPlot::plotArea() const
+{
+    return rect().adjusted(60,20,-10,-20);
+}
+
+bool SignalPlot::dataRange(qint64 &start, qint64 &stop) const
+{
+    bool found = false;
+
+    for(int num=0;num<series.size();num++)
+    {
+        const SignalSeries *current = series[num];
+        if(current->size() == 0)
+            continue;
+
+        if(!found || current->time(0) < start)
+            start = current->time(0);
+        if(!found || current->time(current->size() - 1) >= stop)
+            stop = current->time(current->size() - 1) + 1;
+        found = true;
+    }
+
+    return found;
+}
+
+void SignalPlot::updatePoints(const QRect &area)
+{
+    points.clear();
+    samples = 0;
+
+    for(int num=0;num<series.size();num++)
+    {
+        const SignalSeries *current = series[num];
+        QVector<QPointF> reduced;
+
+        /* one sample on each side of the range, so the lines leave the plot */
+        int begin = qMax(current->lowerBound(viewStart) - 1,0);
+        int end = qMin(current->lowerBound(viewStop) + 1,current->size());
+
+        if(mode == DownsampleLttb)
+            current->downsampleLttb(begin,end,area.width() * 2,reduced);
+        else
+            current->downsampleMinMax(begin,end,viewStart,viewStop,area.width(),reduced);
+
+        points.append(reduced);
+        samples += qMax(end - begin,0);
+    }
+
+    pointsValid = true;
+    pointsStart = viewStart;
+    pointsStop = viewStop;
+    pointsWidth = area.width();
+}
+
+void SignalPlot::paintEvent(QPaintEvent * /* event */)
+{
+    QPainter painter(this);
+    QRect area = plotArea();
+
+    painter.fillRect(rect(),palette().base());
+    painter.setPen(palette().text().color());
+
+    if(area.width() <= 0 || area.height() <= 0)
+        return;
+
+    if(!zoomed)
+    {
+        qint64 start,stop;
+        if(!dataRange(start,stop))
+        {
+            painter.drawText(area,Qt::AlignCenter,QString("No samples"));
+            return;
+        }
+        viewStart = start;
+        viewStop = stop;
+    }
+
+    if(!pointsValid || pointsStart != viewStart || pointsStop != viewStop || pointsWidth != area.width())
+        updatePoints(area);
+
+    /* the value axis is scaled to the visible points */
+    double minValue = 0;
+    double maxValue = 0;
+    bool found = false;
+    for(int num=0;num<points.size();num++)
+    {
+        for(int point=0;point<points[num].size();point++)
+        {
+            double value = points[num][point].y();
+            if(!found || value < minValue)
+                minValue = value;
+            if(!found || value > maxValue)
+                maxValue = value;
+            found = true;
+        }
+    }
+    if(maxValue <= minValue)
+    {
+        minValue -= 1;
+        maxValue += 1;
+    }
+
+    double scaleX = (double)area.width() / (viewStop - viewStart);
+    double scaleY = (double)area.height() / (maxValue - minValue);
+    int drawn = 0;
+
+    painter.drawRect(area.adjusted(0,0,-1,-1));
+    painter.drawText(QRect(0,area.top(),area.left()-5,20),Qt::AlignRight|Qt::AlignTop,QString::number(maxValue,'g',6));
+    painter.drawText(QRect(0,area.bottom()-20,area.left()-5,20),Qt::AlignRight|Qt::AlignBottom,QString::number(minValue,'g',6));
+
+    QDateTime start = QDateTime::fromTime_t(viewStart / 1000000);
+    QDateTime stop = QDateTime::fromTime_t(viewStop / 1000000);
+    painter.drawText(QRect(area.left(),area.bottom(),area.width(),20),Qt::AlignLeft|Qt::AlignVCenter,
+                     QString("%1.%2").arg(start.toString("yyyy-MM-dd hh:mm:ss")).arg((viewStart / 1000) % 1000,3,10,QLatin1Char('0')));
+    painter.drawText(QRect(area.left(),area.bottom(),area.width(),20),Qt::AlignRight|Qt::AlignVCenter,
+                     QString("%1.%2").arg(stop.toString("hh:mm:ss")).arg((viewStop / 1000) % 1000,3,10,QLatin1Char('0')));
+
+    painter.setClipRect(area);
+    for(int num=0;num<points.size();num++)
+    {
+        QPolygonF line;
+        line.reserve(points[num].size());
+        for(int point=0;point<points[num].size();point++)
+        {
+            const QPointF &sample = points[num][point];
+            line << QPointF(area.left() + (sample.x() - viewStart) * scaleX,
+                            area.bottom() - (sample.y() - minValue) * scaleY);
+        }
+        painter.setPen(colors.value(num,Qt::black));
+        painter.drawPolyline(line);
+        drawn += line.size();
+    }
+    painter.setClipping(false);
+
+    painter.setPen(palette().text().color());
+    painter.drawText(QRect(area.left(),0,area.width(),area.top()),Qt::AlignLeft|Qt::AlignVCenter,
+                     QString("%1 of %2 samples drawn").arg(drawn).arg(samples));
+}
+
+void SignalPlot::wheelEvent(QWheelEvent *event)
+{
+    QRect area = plotArea();
+
+    if(area.width() <= 0 || viewStop <= viewStart)
+        return;
+
+    /* zoom around the time below the mouse */
+    double factor = (event->delta() > 0) ? 0.8 : 1.25;
+    qint64 pivot = viewStart + (qint64)((double)(event->x() - area.left()) * (viewStop - viewStart) / area.width());
+    qint64 start = pivot - (qint64)((pivot - viewStart) * factor);
+    qint64 stop = pivot + (qint64)((viewStop - pivot) * factor);
+
+    if(stop - start < 10)
+        return;
+
+    viewStart = start;
+    viewStop = stop;
+    zoomed = true;
+    update();
+}
+
+void SignalPlot::mousePressEvent(QMouseEvent *event)
+{
+    dragX = event->x();
+}
+
+void SignalPlot::mouseMoveEvent(QMouseEvent *event)
+{
+    QRect area = plotArea();
+
+    if(!(event->buttons() & Qt::LeftButton) || area.width() <= 0)
+        return;
+
+    qint64 shift = (qint64)((double)(dragX - event->x()) * (viewStop - viewStart) / area.width());
+    viewStart += shift;
+    viewStop += shift;
+    dragX = event->x();
+    zoomed = true;
+    update();
+}
+
+void SignalPlot::mouseDoubleClickEvent(QMouseEvent * /* event */)
+{
+    zoomed = false;
+    update();
+}
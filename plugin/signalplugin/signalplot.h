@@ -0,0 +1,87 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file signalplot.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef SIGNALPLOT_H
+#define SIGNALPLOT_H
+
+#include <QWidget>
+#include <QList>
+#include <QColor>
+
+#include "signalseries.h"
+
+//! Plot of several signals over the storage time.
+/*!
+  Only the samples of the visible time range are reduced to a few points per
+  pixel column, so series with millions of samples are drawn quickly. The reduced
+  points are cached until the data, the range or the size changes.
+  The mouse wheel zooms, dragging moves the range and a double click shows all samples.
+*/
+class SignalPlot : public QWidget
+{
+public:
+    //! The algorithm used to reduce the samples.
+    typedef enum { DownsampleMinMax = 0, DownsampleLttb } DownsampleMode;
+
+    SignalPlot(QWidget *parent = 0);
+
+    //! Set the series to be drawn.
+    void setSeries(const QList<const SignalSeries*> &series, const QList<QColor> &colors);
+
+    //! Set the algorithm used to reduce the samples.
+    void setMode(DownsampleMode mode);
+
+    //! The samples of the series changed.
+    /*!
+      If all samples are shown, the range follows new samples.
+    */
+    void dataChanged();
+
+protected:
+    void paintEvent(QPaintEvent *event);
+    void wheelEvent(QWheelEvent *event);
+    void mousePressEvent(QMouseEvent *event);
+    void mouseMoveEvent(QMouseEvent *event);
+    void mouseDoubleClickEvent(QMouseEvent *event);
+
+private:
+    QRect plotArea() const;
+    bool dataRange(qint64 &start, qint64 &stop) const;
+    void updatePoints(const QRect &area);
+
+    QList<const SignalSeries*> series;
+    QList<QColor> colors;
+    DownsampleMode mode;
+
+    /* visible range in microseconds, all samples are shown if not zoomed */
+    bool zoomed;
+    qint64 viewStart;
+    qint64 viewStop;
+    int dragX;
+
+    /* reduced points of each series and the state they were computed for */
+    QList< QVector<QPointF> > points;
+    bool pointsValid;
+    qint64 pointsStart;
+    qint64 pointsStop;
+    int pointsWidth;
+    int samples;
+};
+
+#endif // SIGNALPLOT_H
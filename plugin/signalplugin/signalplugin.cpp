@@ -0,0 +1,339 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file signalplugin.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QtGui>
+#include <QtConcurrentMap>
+#include <QXmlStreamReader>
+
+#include "signalplugin.h"
+
+/* Number of messages parsed by one worker job. */
+#define SIGNAL_EXTRACT_CHUNK 4096
+
+SignalExtractor::SignalExtractor(QDltFile *file, const QList<SignalDefinition> *definitions)
+{
+    this->file = file;
+    this->definitions = definitions;
+}
+
+QVector<SignalSample> SignalExtractor::operator()(const QVector<int> &indexes)
+{
+    QVector<SignalSample> samples;
+    QDltMsg msg;
+
+    for(int num=0;num<indexes.size();num++)
+    {
+        /* the file access is serialized by QDltFile, only the parsing runs in parallel */
+        if(!msg.setMsg(file->getMsg(indexes[num])))
+            continue;
+
+        qint64 time = (qint64)msg.getTime() * 1000000 + msg.getMicroseconds();
+
+        for(int def=0;def<definitions->size();def++)
+        {
+            const SignalDefinition &definition = definitions->at(def);
+            SignalSample sample;
+
+            if(definition.matches(msg) && definition.value(msg,sample.value))
+            {
+                sample.definition = def;
+                sample.time = time;
+                samples.append(sample);
+            }
+        }
+    }
+
+    return samples;
+}
+
+SignalPlugin::SignalPlugin()
+{
+    dltFile = 0;
+    form = 0;
+}
+
+SignalPlugin::~SignalPlugin()
+{
+
+}
+
+QString SignalPlugin::name()
+{
+    return QString("Signal Plugin");
+}
+
+QString SignalPlugin::pluginVersion(){
+    return SIGNAL_PLUGIN_VERSION;
+}
+
+QString SignalPlugin::pluginInterfaceVersion(){
+    return PLUGIN_INTERFACE_VERSION;
+}
+
+QString SignalPlugin::description()
+{
+    return QString("Plot numeric signals of verbose and non verbose messages.");
+}
+
+QString SignalPlugin::error()
+{
+    return errorText;
+}
+
+bool SignalPlugin::loadConfig(QString filename)
+{
+    QList<SignalDefinition> loaded;
+
+    errorText.clear();
+
+    if(!filename.isEmpty())
+    {
+        QFile file(filename);
+        if(!file.open(QFile::ReadOnly | QFile::Text))
+        {
+            errorText = "Cannot open " + filename;
+            return false;
+        }
+
+        SignalDefinition definition;
+        bool inSignal = false;
+
+        QXmlStreamReader xml(&file);
+        while(!xml.atEnd())
+        {
+            xml.readNext();
+
+            if(xml.isStartElement())
+            {
+                if(xml.name() == QString("signal"))
+                {
+                    definition = SignalDefinition();
+                    inSignal = true;
+                }
+                else if(inSignal)
+                {
+                    if(xml.name() == QString("name"))
+                        definition.name = xml.readElementText();
+                    else if(xml.name() == QString("ecuid"))
+                        definition.ecuid = xml.readElementText();
+                    else if(xml.name() == QString("apid"))
+                        definition.apid = xml.readElementText();
+                    else if(xml.name() == QString("ctid"))
+                        definition.ctid = xml.readElementText();
+                    else if(xml.name() == QString("argument"))
+                        definition.argument = xml.readElementText().toInt();
+                    else if(xml.name() == QString("messageid"))
+                        definition.messageId = xml.readElementText().toLongLong();
+                    else if(xml.name() == QString("offset"))
+                        definition.offset = xml.readElementText().toInt();
+                    else if(xml.name() == QString("type"))
+                    {
+                        QString type = xml.readElementText();
+                        if(!definition.setType(type))
+                            errorText = QString("Unknown type %1 of signal %2").arg(type).arg(definition.name);
+                    }
+                }
+            }
+
+            if(xml.isEndElement() && xml.name() == QString("signal"))
+            {
+                inSignal = false;
+                if(definition.name.isEmpty())
+                    definition.name = QString("Signal %1").arg(loaded.size() + 1);
+                if(definition.argument < 0 && definition.messageId < 0)
+                    errorText = QString("Signal %1 has neither argument nor message id").arg(definition.name);
+                else
+                    loaded.append(definition);
+            }
+        }
+
+        if(xml.hasError())
+            errorText = QString("Error in %1 line %2: %3").arg(filename).arg(xml.lineNumber()).arg(xml.errorString());
+    }
+
+    definitions = loaded;
+    resetSignals();
+
+    /* the file is not reloaded when the configuration changes */
+    if(dltFile)
+        extract(0,dltFile->size());
+
+    return errorText.isEmpty();
+}
+
+bool SignalPlugin::saveConfig(QString /* filename */)
+{
+    return true;
+}
+
+QStringList SignalPlugin::infoConfig()
+{
+    QStringList list;
+
+    for(int num=0;num<definitions.size();num++)
+        list.append(definitions[num].name + ": " + definitions[num].toString());
+
+    return list;
+}
+
+QWidget* SignalPlugin::initViewer()
+{
+    form = new Form();
+    form->setSignals(&definitions,&series);
+    return form;
+}
+
+void SignalPlugin::selectedIdxMsg(int /* index */, QDltMsg &/* msg */) {
+
+}
+
+void SignalPlugin::selectedIdxMsgDecoded(int /* index */, QDltMsg &/* msg */){
+
+}
+
+void SignalPlugin::initFileStart(QDltFile *file){
+
+    dltFile = file;
+
+    for(int num=0;num<series.size();num++)
+        series[num].clear();
+
+    if(form)
+        form->updateSignals();
+}
+
+void SignalPlugin::initMsg(int /* index */, QDltMsg &/* msg */){
+
+}
+
+void SignalPlugin::initMsgDecoded(int /* index */, QDltMsg &/* msg */){
+
+}
+
+void SignalPlugin::initFileFinish(){
+
+}
+
+void SignalPlugin::updateFileStart(){
+
+}
+
+void SignalPlugin::updateMsg(int /* index */, QDltMsg &/* msg */){
+
+}
+
+void SignalPlugin::updateMsgDecoded(int /* index */, QDltMsg &/* msg */){
+
+}
+
+void SignalPlugin::updateFileFinish(){
+
+}
+
+void SignalPlugin::initMsgRange(int begin, int end)
+{
+    extract(begin,end);
+}
+
+void SignalPlugin::updateMsgRange(int begin, int end)
+{
+    extract(begin,end);
+}
+
+void SignalPlugin::resetSignals()
+{
+    series.clear();
+    for(int num=0;num<definitions.size();num++)
+        series.append(SignalSeries());
+
+    if(form)
+        form->setSignals(&definitions,&series);
+}
+
+void SignalPlugin::extract(int begin, int end)
+{
+    QVector<int> indexes;
+    QDltIdSet ids;
+    bool all = false;
+
+    if(!dltFile || definitions.isEmpty() || begin >= end)
+        return;
+
+    /* only the messages of the configured applications and contexts are read */
+    for(int num=0;num<definitions.size();num++)
+    {
+        const SignalDefinition &definition = definitions[num];
+        if(definition.apid.isEmpty())
+            all = true;
+        else if(definition.ctid.isEmpty())
+            ids.addApid(definition.apid);
+        else
+            ids.addContext(definition.apid,definition.ctid);
+    }
+
+    if(all)
+    {
+        indexes.reserve(end - begin);
+        for(int num=begin;num<end;num++)
+            indexes.append(num);
+    }
+    else
+    {
+        indexes = dltFile->findMsgs(ids,begin,end);
+    }
+
+    QList< QVector<int> > chunks;
+    for(int pos=0;pos<indexes.size();pos+=SIGNAL_EXTRACT_CHUNK)
+        chunks.append(indexes.mid(pos,SIGNAL_EXTRACT_CHUNK));
+
+    SignalExtractor extractor(dltFile,&definitions);
+    QList< QVector<SignalSample> > results;
+
+    if(chunks.size() == 1)
+    {
+        /* few new messages during live capture */
+        results.append(extractor(chunks[0]));
+    }
+    else if(chunks.size() > 1)
+    {
+        QFuture< QVector<SignalSample> > future = QtConcurrent::mapped(chunks,extractor);
+        future.waitForFinished();
+        results = future.results();
+    }
+
+    /* the results are in the order of the messages, not always in the order of time */
+    QVector<int> sizes(series.size());
+    for(int num=0;num<series.size();num++)
+        sizes[num] = series[num].size();
+
+    for(int num=0;num<results.size();num++)
+    {
+        const QVector<SignalSample> &samples = results[num];
+        for(int sample=0;sample<samples.size();sample++)
+            series[samples[sample].definition].append(samples[sample].time,samples[sample].value);
+    }
+
+    for(int num=0;num<series.size();num++)
+        series[num].sort(sizes[num]);
+
+    if(form)
+        form->updateSignals();
+}
+
+Q_EXPORT_PLUGIN2(signalplugin, SignalPlugin);
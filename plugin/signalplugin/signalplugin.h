@@ -0,0 +1,111 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file signalplugin.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef SIGNALPLUGIN_H
+#define SIGNALPLUGIN_H
+
+#include <QObject>
+#include "plugininterface.h"
+#include "form.h"
+#include "signalseries.h"
+
+#define SIGNAL_PLUGIN_VERSION "1.0.0"
+
+//! Value of a signal found in one message.
+typedef struct
+{
+    int definition;
+    qint64 time;
+    double value;
+} SignalSample;
+
+//! Extract the signals of a list of messages, called in parallel for parts of the log file.
+class SignalExtractor
+{
+public:
+    typedef QVector<SignalSample> result_type;
+
+    SignalExtractor(QDltFile *file, const QList<SignalDefinition> *definitions);
+
+    QVector<SignalSample> operator()(const QVector<int> &indexes);
+
+private:
+    QDltFile *file;
+    const QList<SignalDefinition> *definitions;
+};
+
+//! Plot numeric signals extracted from verbose and non verbose messages.
+/*!
+  The signals are defined in the configuration file of the plugin. The messages
+  are read with the range interface, only the messages of the configured
+  applications and contexts are read and parsed in parallel.
+*/
+class SignalPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface, QDltPluginViewerRangeInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(QDLTPluginInterface)
+    Q_INTERFACES(QDltPluginViewerInterface)
+    Q_INTERFACES(QDltPluginViewerRangeInterface)
+
+public:
+    SignalPlugin();
+    ~SignalPlugin();
+
+    /* QDLTPluginInterface interface */
+    QString name();
+    QString pluginVersion();
+    QString pluginInterfaceVersion();
+    QString description();
+    QString error();
+    bool loadConfig(QString filename);
+    bool saveConfig(QString filename);
+    QStringList infoConfig();
+
+    /* QDltPluginViewerInterface */
+    QWidget* initViewer();
+    void initFileStart(QDltFile *file);
+    void initFileFinish();
+    void initMsg(int index, QDltMsg &msg);
+    void initMsgDecoded(int index, QDltMsg &msg);
+    void updateFileStart();
+    void updateMsg(int index, QDltMsg &msg);
+    void updateMsgDecoded(int index, QDltMsg &msg);
+    void updateFileFinish();
+    void selectedIdxMsg(int index, QDltMsg &msg);
+    void selectedIdxMsgDecoded(int index, QDltMsg &msg);
+
+    /* QDltPluginViewerRangeInterface */
+    void initMsgRange(int begin, int end);
+    void updateMsgRange(int begin, int end);
+
+    /* internal variables */
+    Form *form;
+
+private:
+    QDltFile *dltFile;
+    QString errorText;
+
+    QList<SignalDefinition> definitions;
+    QList<SignalSeries> series;
+
+    void resetSignals();
+    void extract(int begin, int end);
+};
+
+#endif // SIGNALPLUGIN_H
@@ -0,0 +1,23 @@
+# include global settings for all DLT Viewer Plugins
+include( ../plugin.pri )
+
+# target name
+TARGET = $$qtLibraryTarget(signalplugin)
+
+# plugin header files
+HEADERS += \
+    signalplugin.h \
+    signalseries.h \
+    signalplot.h \
+    form.h
+
+# plugin source files
+SOURCES += \
+    signalplugin.cpp \
+    signalseries.cpp \
+    signalplot.cpp \
+    form.cpp
+
+# plugin forms
+FORMS += \
+    form.ui
@@ -0,0 +1,339 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file signalseries.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <QPair>
+
+#include "signalseries.h"
+
+/* Convert the bytes of a numeric value. */
+static bool signalNumber(const char *data, int size, QDltArgument::DltTypeInfoDef type, bool bigEndian, double &value)
+{
+    quint64 raw = 0;
+
+    if(type == QDltArgument::DltTypeInfoStrg)
+    {
+        bool ok;
+        value = QString::fromLatin1(data,qstrnlen(data,size)).trimmed().toDouble(&ok);
+        return ok;
+    }
+
+    if(size != 1 && size != 2 && size != 4 && size != 8)
+        return false;
+
+    for(int num=0;num<size;num++)
+        raw = (raw << 8) | (unsigned char)data[bigEndian ? num : size - 1 - num];
+
+    switch(type)
+    {
+    case QDltArgument::DltTypeInfoBool:
+    case QDltArgument::DltTypeInfoUInt:
+        value = (double)raw;
+        return true;
+    case QDltArgument::DltTypeInfoSInt:
+        if(size < 8 && (raw & ((quint64)1 << (size * 8 - 1))))
+            raw |= ~(quint64)0 << (size * 8);
+        value = (double)(qint64)raw;
+        return true;
+    case QDltArgument::DltTypeInfoFloa:
+        if(size == 4)
+        {
+            quint32 bits = (quint32)raw;
+            float number;
+            memcpy(&number,&bits,sizeof(number));
+            value = number;
+            return true;
+        }
+        if(size == 8)
+        {
+            double number;
+            memcpy(&number,&raw,sizeof(number));
+            value = number;
+            return true;
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+
+SignalDefinition::SignalDefinition()
+{
+    argument = -1;
+    messageId = -1;
+    offset = 0;
+    type = QDltArgument::DltTypeInfoUInt;
+    size = 4;
+}
+
+bool SignalDefinition::setType(const QString &text)
+{
+    QString lower = text.trimmed().toLower();
+
+    if(lower.startsWith("uint"))
+        type = QDltArgument::DltTypeInfoUInt;
+    else if(lower.startsWith("sint"))
+        type = QDltArgument::DltTypeInfoSInt;
+    else if(lower.startsWith("float"))
+        type = QDltArgument::DltTypeInfoFloa;
+    else
+        return false;
+
+    int bits = lower.mid(lower.indexOf(QRegExp("[0-9]"))).toInt();
+    if(bits != 8 && bits != 16 && bits != 32 && bits != 64)
+        return false;
+    if(type == QDltArgument::DltTypeInfoFloa && bits < 32)
+        return false;
+
+    size = bits / 8;
+    return true;
+}
+
+QString SignalDefinition::toString() const
+{
+    QString text = QString("%1 %2 %3").arg(ecuid.isEmpty() ? QString("*") : ecuid)
+                                      .arg(apid.isEmpty() ? QString("*") : apid)
+                                      .arg(ctid.isEmpty() ? QString("*") : ctid);
+
+    if(messageId >= 0)
+        text += QString(" id %1 offset %2").arg(messageId).arg(offset);
+    else
+        text += QString(" argument %1").arg(argument);
+
+    return text;
+}
+
+bool SignalDefinition::matches(QDltMsg &msg) const
+{
+    if(!ecuid.isEmpty() && msg.getEcuid() != ecuid)
+        return false;
+    if(!apid.isEmpty() && msg.getApid() != apid)
+        return false;
+    if(!ctid.isEmpty() && msg.getCtid() != ctid)
+        return false;
+
+    if(messageId >= 0)
+        return msg.getMode() == QDltMsg::DltModeNonVerbose && (qint64)msg.getMessageId() == messageId;
+
+    return msg.getMode() == QDltMsg::DltModeVerbose && argument >= 0;
+}
+
+bool SignalDefinition::value(QDltMsg &msg, double &value) const
+{
+    if(messageId >= 0)
+    {
+        /* the value follows the message id in the payload */
+        QByteArray payload = msg.getPayload();
+        int position = 4 + offset;
+
+        if(offset < 0 || position + size > payload.size())
+            return false;
+
+        return signalNumber(payload.constData() + position,size,type,msg.getEndianness() == QDlt::DltEndiannessBigEndian,value);
+    }
+
+    QDltArgument arg;
+    if(!msg.getArgument(argument,arg))
+        return false;
+
+    QByteArray data = arg.getData();
+    return signalNumber(data.constData(),data.size(),arg.getTypeInfo(),arg.getEndianness() == QDlt::DltEndiannessBigEndian,value);
+}
+
+SignalSeries::SignalSeries()
+{
+}
+
+void SignalSeries::append(qint64 time, double value)
+{
+    times.append(time);
+    values.append(value);
+}
+
+/* Compare two samples only by time, so sorting and merging keeps the order of equal times. */
+static bool signalSampleLess(const QPair<qint64,double> &sample1, const QPair<qint64,double> &sample2)
+{
+    return sample1.first < sample2.first;
+}
+
+void SignalSeries::sort(int from)
+{
+    int num;
+
+    from = qBound(0,from,times.size());
+
+    /* usually the samples are already in order */
+    for(num=qMax(from,1);num<times.size();num++)
+        if(times[num] < times[num - 1])
+            break;
+    if(num >= times.size())
+        return;
+
+    QVector< QPair<qint64,double> > added;
+    added.reserve(times.size() - from);
+    for(num=from;num<times.size();num++)
+        added.append(qMakePair(times[num],values[num]));
+    std::stable_sort(added.begin(),added.end(),signalSampleLess);
+
+    /* only the sorted samples later than the first new sample are merged */
+    int start = std::upper_bound(times.constBegin(),times.constBegin() + from,added[0].first) - times.constBegin();
+    QVector< QPair<qint64,double> > sorted;
+    sorted.reserve(from - start);
+    for(num=start;num<from;num++)
+        sorted.append(qMakePair(times[num],values[num]));
+
+    QVector< QPair<qint64,double> > merged(sorted.size() + added.size());
+    std::merge(sorted.constBegin(),sorted.constEnd(),added.constBegin(),added.constEnd(),merged.begin(),signalSampleLess);
+
+    for(num=0;num<merged.size();num++)
+    {
+        times[start + num] = merged[num].first;
+        values[start + num] = merged[num].second;
+    }
+}
+
+int SignalSeries::lowerBound(qint64 time) const
+{
+    return qLowerBound(times.constBegin(),times.constEnd(),time) - times.constBegin();
+}
+
+void SignalSeries::downsampleMinMax(int begin, int end, qint64 start, qint64 stop, int count, QVector<QPointF> &points) const
+{
+    points.clear();
+
+    if(begin >= end || count <= 0 || stop <= start)
+        return;
+
+    double width = (double)(stop - start) / count;
+    int bucket = -1;
+    int minIndex = begin;
+    int maxIndex = begin;
+
+    for(int num=begin;num<=end;num++)
+    {
+        int current = -1;
+        if(num < end)
+            current = qBound(0,(int)((times[num] - start) / width),count - 1);
+
+        if(current != bucket || num == end)
+        {
+            /* emit the extremes of the finished interval in sample order */
+            if(bucket >= 0)
+            {
+                int first = qMin(minIndex,maxIndex);
+                int last = qMax(minIndex,maxIndex);
+                points.append(QPointF(times[first],values[first]));
+                if(last != first)
+                    points.append(QPointF(times[last],values[last]));
+            }
+            if(num == end)
+                break;
+            bucket = current;
+            minIndex = num;
+            maxIndex = num;
+        }
+        else
+        {
+            if(values[num] < values[minIndex])
+                minIndex = num;
+            if(values[num] > values[maxIndex])
+                maxIndex = num;
+        }
+    }
+}
+
+void SignalSeries::downsampleLttb(int begin, int end, int threshold, QVector<QPointF> &points) const
+{
+    int count = end - begin;
+
+    points.clear();
+
+    if(count <= 0)
+        return;
+
+    if(threshold >= count || threshold < 3)
+    {
+        for(int num=begin;num<end;num++)
+            points.append(QPointF(times[num],values[num]));
+        return;
+    }
+
+    /* the first and the last sample are kept, the others are split into threshold-2 buckets */
+    double every = (double)(count - 2) / (threshold - 2);
+    int selected = begin;
+
+    points.reserve(threshold);
+    points.append(QPointF(times[selected],values[selected]));
+
+    for(int bucket=0;bucket<threshold-2;bucket++)
+    {
+        /* average of the next bucket */
+        int avgBegin = begin + (int)floor((bucket + 1) * every) + 1;
+        int avgEnd = qMin(begin + (int)floor((bucket + 2) * every) + 1,end);
+        double avgTime = 0;
+        double avgValue = 0;
+        for(int num=avgBegin;num<avgEnd;num++)
+        {
+            avgTime += times[num];
+            avgValue += values[num];
+        }
+        if(avgEnd > avgBegin)
+        {
+            avgTime /= avgEnd - avgBegin;
+            avgValue /= avgEnd - avgBegin;
+        }
+        else
+        {
+            avgTime = times[end - 1];
+            avgValue = values[end - 1];
+        }
+
+        /* the sample of the bucket forming the largest triangle with the previous selected sample */
+        int rangeBegin = begin + (int)floor(bucket * every) + 1;
+        int rangeEnd = qMin(begin + (int)floor((bucket + 1) * every) + 1,end - 1);
+        double selectedTime = times[selected];
+        double selectedValue = values[selected];
+        double maxArea = -1;
+        int next = rangeBegin;
+
+        for(int num=rangeBegin;num<rangeEnd;num++)
+        {
+            double area = fabs((selectedTime - avgTime) * (values[num] - selectedValue) -
+                               (selectedTime - times[num]) * (avgValue - selectedValue));
+            if(area > maxArea)
+            {
+                maxArea = area;
+                next = num;
+            }
+        }
+
+        points.append(QPointF(times[next],values[next]));
+        selected = next;
+    }
+
+    points.append(QPointF(times[end - 1],values[end - 1]));
+}
+
+void SignalSeries::clear()
+{
+    times.clear();
+    values.clear();
+}
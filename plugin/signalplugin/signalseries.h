@@ -0,0 +1,145 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file signalseries.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef SIGNALSERIES_H
+#define SIGNALSERIES_H
+
+#include <QString>
+#include <QVector>
+#include <QPointF>
+
+#include "qdlt.h"
+
+//! Definition of a numeric signal extracted from DLT messages.
+/*!
+  Empty ids match all messages. A verbose signal is the value of one argument,
+  a non verbose signal is read from the payload of the messages with the message id.
+*/
+class SignalDefinition
+{
+public:
+    SignalDefinition();
+
+    QString name;
+    QString ecuid;
+    QString apid;
+    QString ctid;
+
+    //! Argument of a verbose message, -1 if not used.
+    int argument;
+
+    //! Message id of a non verbose message, -1 for verbose signals.
+    qint64 messageId;
+
+    //! Offset of the value behind the message id of a non verbose message.
+    int offset;
+
+    //! Type and size of the value of a non verbose message.
+    QDltArgument::DltTypeInfoDef type;
+    int size;
+
+    //! Set type and size of a non verbose value.
+    /*!
+      \param text one of uint8, sint8, uint16, sint16, uint32, sint32, uint64, sint64, float32, float64
+      \return true if the type is known
+    */
+    bool setType(const QString &text);
+
+    //! Description of the definition shown to the user.
+    QString toString() const;
+
+    //! Check if a message contains the signal.
+    bool matches(QDltMsg &msg) const;
+
+    //! Get the value of the signal from a message matched with matches().
+    /*!
+      \param msg the message
+      \param value the value of the signal
+      \return false if the message does not contain a numeric value
+    */
+    bool value(QDltMsg &msg, double &value) const;
+};
+
+//! The samples of one signal stored as separate time and value columns.
+/*!
+  The times are storage times in microseconds. Messages are added in the order
+  of the log file, which may be out of time order, e.g. after appending files or
+  clock jumps. After adding samples sort() must be called, so the samples are always
+  ordered by time. For display the samples of a time range are reduced with
+  downsampleMinMax() or downsampleLttb().
+*/
+class SignalSeries
+{
+public:
+    SignalSeries();
+
+    //! Add a sample.
+    void append(qint64 time, double value);
+
+    //! Order the samples added since the last call by time.
+    /*!
+      The new samples are sorted and merged into the samples already sorted.
+      Samples with the same time keep the order in which they were added.
+      \param from number of the first sample added since the last call
+    */
+    void sort(int from);
+
+    //! Number of samples.
+    int size() const { return times.size(); }
+
+    //! Time of a sample.
+    qint64 time(int index) const { return times[index]; }
+
+    //! Value of a sample.
+    double value(int index) const { return values[index]; }
+
+    //! Number of the first sample not before a time.
+    int lowerBound(qint64 time) const;
+
+    //! Reduce the samples to the minimum and the maximum of each interval.
+    /*!
+      The points are returned in the order of the samples, so extremes are never lost.
+      \param begin number of the first sample
+      \param end number behind the last sample
+      \param start the start of the first interval
+      \param stop the end of the last interval
+      \param count number of intervals, usually the width of the plot in pixels
+      \param points the reduced samples, x is the time in microseconds
+    */
+    void downsampleMinMax(int begin, int end, qint64 start, qint64 stop, int count, QVector<QPointF> &points) const;
+
+    //! Reduce the samples with the largest triangle three buckets algorithm.
+    /*!
+      Keeps the visual shape of the signal with a given number of points.
+      \param begin number of the first sample
+      \param end number behind the last sample
+      \param threshold number of points returned
+      \param points the reduced samples, x is the time in microseconds
+    */
+    void downsampleLttb(int begin, int end, int threshold, QVector<QPointF> &points) const;
+
+    //! Remove all samples.
+    void clear();
+
+private:
+    QVector<qint64> times;
+    QVector<double> values;
+};
+
+#endif // SIGNALSERIES_H
@@ -21,14 +21,23 @@
 
 #include <QTextStream>
 #include <QFile>
+#include <QDataStream>
+#include <QScopedPointer>
 #include <QtDebug>
 #include <QThread>
 #include <QtConcurrentRun>
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <queue>
+#include <vector>
+#include <functional>
 
 #include <qextserialport.h>
 #include <QTcpSocket>
 #include "qdlt.h"
 
+#include <zlib.h>
+
 extern "C"
 {
     #include "dlt_common.h"
@@ -48,9 +57,25 @@ const char *qDltCtrlServiceId[] = {"","set_log_level","set_trace_status","get_lo
                              "get_local_time","use_ecu_id","use_session_id","use_timestamp","use_extended_header","set_default_log_level","set_default_trace_status",
                              "get_software_version","message_buffer_overflow"};
 const char *qDltCtrlReturnType [] = {"ok","not_supported","error","3","4","5","6","7","no_matching_context_id"};
+const char qDltHexDigits[] = "0123456789abcdef";
 
 #define DLT_MAX_MESSAGE_LEN 1024*64
 
+/* Read integers from message buffers, which are not aligned. */
+static inline quint16 qDltRead16(const char *data,bool bigEndian)
+{
+    quint16 value;
+    memcpy(&value,data,sizeof(value));
+    return bigEndian ? DLT_SWAP_16(value) : value;
+}
+
+static inline quint32 qDltRead32(const char *data,bool bigEndian)
+{
+    quint32 value;
+    memcpy(&value,data,sizeof(value));
+    return bigEndian ? DLT_SWAP_32(value) : value;
+}
+
 QDlt::QDlt()
 {
 
@@ -168,26 +193,243 @@ QString QDlt::toAsciiTable(QByteArray &bytes, bool withLineNumber, bool withBina
 QString QDlt::toAscii(QByteArray &bytes, bool ascii)
 {
     QString text;
-    text.reserve(bytes.size()*2);
+    text.reserve(bytes.size()*3);
 
-    /* create text to show */
-    for(int num=0;num<bytes.size();num++)
-    {
-        char ch = (bytes.constData())[num];
-        if(ascii) {
+    appendAscii(text,bytes,ascii);
+
+    return text;
+}
+
+void QDlt::appendAscii(QString &text,const QByteArray &bytes,bool ascii)
+{
+    const char *data = bytes.constData();
+    int size = bytes.size();
+    int pos = text.size();
+
+    if(size == 0)
+        return;
+
+    /* write the characters directly into the string, no temporary strings are created */
+    if(ascii) {
+        text.resize(pos+size);
+        QChar *out = text.data()+pos;
+        for(int num=0;num<size;num++)
+        {
+            char ch = data[num];
             if( (ch >= ' ') && (ch <= '~') )
-                text += QString(QChar(ch));
+                out[num] = QLatin1Char(ch);
             else
-                text += QString("-");
+                out[num] = QLatin1Char('-');
         }
-        else {
+    }
+    else {
+        text.resize(pos+size*3-1);
+        QChar *out = text.data()+pos;
+        for(int num=0;num<size;num++)
+        {
+            unsigned char ch = data[num];
             if(num!=0)
-                text += QString(" ");
-            text += QString("%1").arg((unsigned char)ch,2,16,QLatin1Char('0'));
+                *out++ = QLatin1Char(' ');
+            *out++ = QLatin1Char(qDltHexDigits[ch>>4]);
+            *out++ = QLatin1Char(qDltHexDigits[ch&0x0f]);
         }
     }
+}
 
-    return text;
+void QDlt::appendNumber(QString &text,qulonglong value,int width)
+{
+    char buffer[24];
+    int pos = sizeof(buffer);
+
+    if(width > 20)
+        width = 20;
+
+    do {
+        buffer[--pos] = '0' + (char)(value%10);
+        value /= 10;
+    } while(value);
+
+    while((int)sizeof(buffer)-pos < width)
+        buffer[--pos] = '0';
+
+    int size = text.size();
+    text.resize(size+(int)sizeof(buffer)-pos);
+    QChar *out = text.data()+size;
+    while(pos < (int)sizeof(buffer))
+        *out++ = QLatin1Char(buffer[pos++]);
+}
+
+void QDlt::appendSignedNumber(QString &text,qlonglong value)
+{
+    if(value < 0) {
+        text += QLatin1Char('-');
+        appendNumber(text,0-(qulonglong)value);
+    }
+    else {
+        appendNumber(text,(qulonglong)value);
+    }
+}
+
+quint32 QDlt::idToNumber(const QString &id)
+{
+    char chars[DLT_ID_SIZE] = {0,0,0,0};
+    quint32 number;
+
+    QByteArray bytes = id.toLatin1();
+    memcpy(chars,bytes.constData(),qMin(bytes.size(),DLT_ID_SIZE));
+    memcpy(&number,chars,DLT_ID_SIZE);
+
+    return number;
+}
+
+QString QDlt::numberToId(quint32 number)
+{
+    char chars[DLT_ID_SIZE];
+
+    memcpy(chars,&number,DLT_ID_SIZE);
+
+    /* shorter ids are filled with zeros, as in the header */
+    return QString::fromLatin1(chars,qstrnlen(chars,DLT_ID_SIZE));
+}
+
+bool QDltProfiler::enabled = false;
+
+/* Number of histogram buckets, one for each power of two nanoseconds. */
+static const int QDLT_PROFILER_BUCKETS = 40;
+
+QDltProfiler::QDltProfiler()
+{
+    started.start();
+}
+
+QDltProfiler *QDltProfiler::instance()
+{
+    static QDltProfiler profiler;
+
+    return &profiler;
+}
+
+void QDltProfiler::setEnabled(bool state)
+{
+    enabled = state;
+}
+
+void QDltProfiler::add(const QString &name, qint64 nsecs, qint64 items)
+{
+    int bucket = 0;
+
+    while(bucket < QDLT_PROFILER_BUCKETS - 1 && (nsecs >> (bucket + 1)) > 0)
+        bucket++;
+
+    QMutexLocker locker(&mutex);
+
+    QMap<QString,Counter>::iterator it = counters.find(name);
+    if(it == counters.end()) {
+        Counter counter;
+        counter.name = name;
+        counter.calls = 0;
+        counter.items = 0;
+        counter.total = 0;
+        counter.min = nsecs;
+        counter.max = nsecs;
+        counter.histogram.fill(0,QDLT_PROFILER_BUCKETS);
+        it = counters.insert(name,counter);
+    }
+
+    Counter &counter = it.value();
+    counter.calls++;
+    counter.items += items;
+    counter.total += nsecs;
+    counter.min = qMin(counter.min,nsecs);
+    counter.max = qMax(counter.max,nsecs);
+    counter.histogram[bucket]++;
+}
+
+void QDltProfiler::clear()
+{
+    QMutexLocker locker(&mutex);
+
+    counters.clear();
+    started.restart();
+}
+
+QList<QDltProfiler::Counter> QDltProfiler::getCounters()
+{
+    QMutexLocker locker(&mutex);
+
+    return counters.values();
+}
+
+qint64 QDltProfiler::getElapsed()
+{
+    QMutexLocker locker(&mutex);
+
+    return started.elapsed();
+}
+
+qint64 QDltProfiler::getPercentile(const Counter &counter, double fraction)
+{
+    qint64 limit = (qint64)(counter.calls * fraction);
+    qint64 count = 0;
+
+    for(int bucket=0;bucket<counter.histogram.size();bucket++) {
+        count += counter.histogram[bucket];
+        if(count > limit || count == counter.calls)
+            return qMin((qint64)2 << bucket,counter.max);
+    }
+
+    return counter.max;
+}
+
+QByteArray QDltProfiler::toJson()
+{
+    QList<Counter> list = getCounters();
+    QString text;
+
+    text += "{\n  \"elapsed_ms\": ";
+    QDlt::appendNumber(text,getElapsed());
+    text += ",\n  \"counters\": [";
+    for(int num=0;num<list.size();num++) {
+        const Counter &counter = list[num];
+        QString name = counter.name;
+        name.replace("\\","\\\\").replace("\"","\\\"");
+
+        text += (num ? ",\n" : "\n");
+        text += "    { \"name\": \"" + name + "\"";
+        text += ", \"calls\": ";
+        QDlt::appendNumber(text,counter.calls);
+        text += ", \"items\": ";
+        QDlt::appendNumber(text,counter.items);
+        text += ", \"total_ns\": ";
+        QDlt::appendNumber(text,counter.total);
+        text += ", \"min_ns\": ";
+        QDlt::appendNumber(text,counter.min);
+        text += ", \"max_ns\": ";
+        QDlt::appendNumber(text,counter.max);
+        text += ", \"p50_ns\": ";
+        QDlt::appendNumber(text,getPercentile(counter,0.5));
+        text += ", \"p99_ns\": ";
+        QDlt::appendNumber(text,getPercentile(counter,0.99));
+
+        /* only the used buckets, each with its upper bound */
+        text += ", \"histogram\": [";
+        bool first = true;
+        for(int bucket=0;bucket<counter.histogram.size();bucket++) {
+            if(!counter.histogram[bucket])
+                continue;
+            text += (first ? "" : ", ");
+            text += "{ \"le_ns\": ";
+            QDlt::appendNumber(text,(qint64)2 << bucket);
+            text += ", \"count\": ";
+            QDlt::appendNumber(text,counter.histogram[bucket]);
+            text += " }";
+            first = false;
+        }
+        text += "] }";
+    }
+    text += "\n  ]\n}\n";
+
+    return text.toUtf8();
 }
 
 QDltArgument::QDltArgument()
@@ -233,7 +475,7 @@ QDltArgument::DltTypeInfoDef QDltArgument::getTypeInfo()
 
 QString QDltArgument::getTypeInfoString()
 {
-    if(typeInfo<0)
+    if(typeInfo<0 || typeInfo>DltTypeInfoTrai)
         return QString("");
 
     return QString(qDltTypeInfo[typeInfo]);
@@ -243,6 +485,7 @@ bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndia
 {
     unsigned int dltType;
     unsigned short length=0,length2=0,length3=0;
+    bool bigEndian;
 
     /* clear old data */
     clear();
@@ -252,14 +495,12 @@ bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndia
 
     /* store new endianess */
     endianness = _endianess;
+    bigEndian = (endianness != DltEndiannessLittleEndian);
 
     /* get type info */
     if((unsigned int)payload.size()<(offset+sizeof(unsigned int)))
         return false;
-    if(endianness == DltEndiannessLittleEndian)
-        dltType = *((unsigned int*) (payload.constData()+offset));
-    else
-        dltType = DLT_SWAP_32((*((unsigned int*) (payload.constData()+offset))));
+    dltType = qDltRead32(payload.constData()+offset,bigEndian);
     offset += sizeof(unsigned int);
 
     if (dltType& DLT_TYPE_INFO_STRG)
@@ -301,10 +542,7 @@ bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndia
     {
         if((unsigned int)payload.size()<(offset+sizeof(unsigned short)))
             return false;
-        if(endianness == DltEndiannessLittleEndian)
-            length = *((unsigned short*) (payload.constData()+offset));
-        else
-            length = DLT_SWAP_16((*((unsigned short*) (payload.constData()+offset))));
+        length = qDltRead16(payload.constData()+offset,bigEndian);
 
         offset += sizeof(unsigned short);
     }
@@ -314,21 +552,17 @@ bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndia
     {
         if((unsigned int)payload.size()<(offset+sizeof(unsigned short)))
             return false;
-        if(endianness == DltEndiannessLittleEndian)
-            length2 = *((unsigned short*) (payload.constData()+offset));
-        else
-            length2 = DLT_SWAP_16((*((unsigned short*) (payload.constData()+offset))));
+        length2 = qDltRead16(payload.constData()+offset,bigEndian);
         offset += sizeof(unsigned short);
         if(typeInfo == DltTypeInfoSInt || typeInfo == DltTypeInfoUInt || typeInfo == DltTypeInfoFloa)
         {
             if((unsigned int)payload.size()<(offset+sizeof(unsigned short)))
                 return false;
-            if(endianness == DltEndiannessLittleEndian)
-                length3 = *((unsigned short*) (payload.constData()+offset));
-            else
-                length3 = DLT_SWAP_16((*((unsigned short*) (payload.constData()+offset))));
+            length3 = qDltRead16(payload.constData()+offset,bigEndian);
             offset += sizeof(unsigned short);
         }
+        if((unsigned int)payload.size()<(offset+length2+length3))
+            return false;
         name = QString(payload.mid(offset,length2));
         offset += length2;
         if(typeInfo == DltTypeInfoSInt || typeInfo == DltTypeInfoUInt || typeInfo == DltTypeInfoFloa)
@@ -353,92 +587,34 @@ bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndia
         data = payload.mid(offset,length);
         offset += length;
     }
-    else if(typeInfo == DltTypeInfoBool)
-    {
-        data = payload.mid(offset,1);
-        offset += 1;
-    }
-    else if(typeInfo == DltTypeInfoSInt || typeInfo == DltTypeInfoUInt)
-    {
-        switch (dltType & DLT_TYPE_INFO_TYLE)
-        {
-            case DLT_TYLE_8BIT:
-            {
-                data = payload.mid(offset,1);
-                offset += 1;
-                break;
-            }
-            case DLT_TYLE_16BIT:
-            {
-                data = payload.mid(offset,2);
-                offset += 2;
-                break;
-            }
-            case DLT_TYLE_32BIT:
-            {
-                data = payload.mid(offset,4);
-                offset += 4;
-                break;
-            }
-            case DLT_TYLE_64BIT:
-            {
-                data = payload.mid(offset,8);
-                offset += 8;
-                break;
-            }
-            case DLT_TYLE_128BIT:
-            {
-                data = payload.mid(offset,16);
-                offset += 16;
-                break;
-            }
-            default:
-            {
-                return false;
-            }
-        }
-
-    }
-    else if(typeInfo == DltTypeInfoFloa)
+    else
     {
-        switch(dltType & DLT_TYPE_INFO_TYLE)
+        /* boolean, integer and float values have a fixed size */
+        unsigned int size;
+        switch((typeInfo == DltTypeInfoBool) ? DLT_TYLE_8BIT : (dltType & DLT_TYPE_INFO_TYLE))
         {
-            case DLT_TYLE_8BIT:
-            {
-                data = payload.mid(offset,1);
-                offset += 1;
-                break;
-            }
-            case DLT_TYLE_16BIT:
-             {
-                data = payload.mid(offset,2);
-                offset += 2;
-                break;
-            }
-            case DLT_TYLE_32BIT:
-            {
-                data = payload.mid(offset,4);
-                offset += 4;
-                break;
-            }
-            case DLT_TYLE_64BIT:
-            {
-                data = payload.mid(offset,8);
-                offset += 8;
-                break;
-            }
-            case DLT_TYLE_128BIT:
-            {
-                data = payload.mid(offset,16);
-                offset += 16;
-                break;
-            }
-            default:
-            {
-                return false;
-            }
+        case DLT_TYLE_8BIT:
+            size = 1;
+            break;
+        case DLT_TYLE_16BIT:
+            size = 2;
+            break;
+        case DLT_TYLE_32BIT:
+            size = 4;
+            break;
+        case DLT_TYLE_64BIT:
+            size = 8;
+            break;
+        case DLT_TYLE_128BIT:
+            size = 16;
+            break;
+        default:
+            return false;
         }
-
+        if((unsigned int)payload.size()<(offset+size))
+            return false;
+        data = payload.mid(offset,size);
+        offset += size;
     }
 
     return true;
@@ -448,6 +624,10 @@ bool QDltArgument::getArgument(QByteArray &payload, bool verboseMode)
 {
     unsigned int dltType = 0;
 
+    /* the data is stored in the byte order of the message it was read from,
+       the type info and the length are written in the same byte order */
+    bool bigEndian = (endianness == DltEndiannessBigEndian);
+
     /* add the type info in verbose mode */
     if(verboseMode) {
         switch(typeInfo) {
@@ -477,7 +657,7 @@ bool QDltArgument::getArgument(QByteArray &payload, bool verboseMode)
         default:
             return false;
         }
-        if((typeInfo == DLT_TYPE_INFO_SINT) || (typeInfo == DLT_TYPE_INFO_UINT) || (typeInfo == DLT_TYPE_INFO_FLOA)) {
+        if((typeInfo == DltTypeInfoSInt) || (typeInfo == DltTypeInfoUInt) || (typeInfo == DltTypeInfoFloa)) {
             switch(data.size())
             {
             case 1:
@@ -499,12 +679,19 @@ bool QDltArgument::getArgument(QByteArray &payload, bool verboseMode)
                 return false;
             }
         }
+        if(bigEndian)
+            dltType = DLT_SWAP_32(dltType);
         payload += QByteArray((const char*)&dltType,sizeof(unsigned int));
     }
 
     /* add the string or raw data size to the payload */
-    if((typeInfo == DLT_TYPE_INFO_RAWD) || (typeInfo == DLT_TYPE_INFO_STRG)) {
-        payload += QByteArray((const char*)&dltType,sizeof(unsigned int));
+    if((typeInfo == DltTypeInfoRawd) || (typeInfo == DltTypeInfoStrg)) {
+        if(data.size() > 0xffff)
+            return false;
+        unsigned short length = data.size();
+        if(bigEndian)
+            length = DLT_SWAP_16(length);
+        payload += QByteArray((const char*)&length,sizeof(unsigned short));
     }
 
     /* add the value to the payload */
@@ -529,55 +716,65 @@ QString QDltArgument::toString(bool binary)
     QString text;
     text.reserve(1024);
 
+    toString(text,binary);
+
+    return text;
+}
+
+void QDltArgument::toString(QString &text,bool binary)
+{
     if(binary) {
-        return toAscii(data);
+        appendAscii(text,data);
+        return;
     }
 
+    /* the numbers are written with the types the byte swap macros return,
+       so the output is the same as with QString::arg() */
     switch(getTypeInfo()) {
     case DltTypeInfoUnknown:
-        text += QString("?");
+        text += QLatin1Char('?');
         break;
     case DltTypeInfoStrg:
         if(data.size()) {
-            text += QString("%1").arg(QString(getData()));
+            text += QString(getData());
         }
         break;
     case DltTypeInfoBool:
         if(data.size()) {
             if(data.constData()[0])
-                text += QString("true");
+                text += QLatin1String("true");
             else
-                text += QString("false");
+                text += QLatin1String("false");
         }
         else
-            text += QString("?");
+            text += QLatin1Char('?');
         break;
     case DltTypeInfoSInt:
         switch(data.size())
         {
         case 1:
-            text += QString("%1").arg((short)(*(char*)(data.constData())));
+            appendSignedNumber(text,(short)(*(char*)(data.constData())));
             break;
         case 2:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((short)(*(short*)(data.constData())));
+                appendSignedNumber(text,(short)(*(short*)(data.constData())));
             else
-                text += QString("%1").arg(DLT_SWAP_16((short)(*(short*)(data.constData()))));
+                appendSignedNumber(text,DLT_SWAP_16((short)(*(short*)(data.constData()))));
             break;
         case 4:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((int)(*(int*)(data.constData())));
+                appendSignedNumber(text,(int)(*(int*)(data.constData())));
             else
-                text += QString("%1").arg(DLT_SWAP_32((int)(*(int*)(data.constData()))));
+                appendNumber(text,DLT_SWAP_32((int)(*(int*)(data.constData()))));
             break;
         case 8:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((long long)(*(long long*)(data.constData())));
+                appendSignedNumber(text,(long long)(*(long long*)(data.constData())));
             else
-                text += QString("%1").arg(DLT_SWAP_64((long long)(*(long long*)(data.constData()))));
+                appendNumber(text,DLT_SWAP_64((long long)(*(long long*)(data.constData()))));
             break;
         default:
-            text += QString("?");
+            text += QLatin1Char('?');
         }
 
         break;
@@ -585,28 +782,28 @@ QString QDltArgument::toString(bool binary)
         switch(data.size())
         {
         case 1:
-            text += QString("%1").arg((unsigned short)(*(unsigned char*)(data.constData())));
+            appendNumber(text,(unsigned short)(*(unsigned char*)(data.constData())));
             break;
         case 2:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((unsigned short)(*(unsigned short*)(data.constData())));
+                appendNumber(text,(unsigned short)(*(unsigned short*)(data.constData())));
             else
-                text += QString("%1").arg(DLT_SWAP_16((unsigned short)(*(unsigned short*)(data.constData()))));
+                appendNumber(text,DLT_SWAP_16((unsigned short)(*(unsigned short*)(data.constData()))));
             break;
         case 4:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((unsigned int)(*(unsigned int*)(data.constData())));
+                appendNumber(text,(unsigned int)(*(unsigned int*)(data.constData())));
             else
-                text += QString("%1").arg(DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData()))));
+                appendNumber(text,DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData()))));
             break;
         case 8:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((unsigned long long)(*(unsigned long long*)(data.constData())));
+                appendNumber(text,(unsigned long long)(*(unsigned long long*)(data.constData())));
             else
-                text += QString("%1").arg(DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData()))));
+                appendNumber(text,DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData()))));
             break;
         default:
-            text += QString("?");
+            text += QLatin1Char('?');
         }
 
         break;
@@ -615,38 +812,36 @@ QString QDltArgument::toString(bool binary)
         {
         case 4:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((double)(*(float*)(data.constData())));
+                text += QString::number((double)(*(float*)(data.constData())));
             else
             {
                 unsigned int tmp;
                 tmp = DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData())));
-                text += QString("%1").arg((double)(*(float*)((void*)&tmp)));
+                text += QString::number((double)(*(float*)((void*)&tmp)));
             }
             break;
         case 8:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((double)(*(double*)(data.constData())));
+                text += QString::number((double)(*(double*)(data.constData())));
             else {
-                unsigned int tmp;
+                unsigned long long tmp;
                 tmp = DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData())));
-                text += QString("%1").arg((double)(*(double*)((void*)&tmp)));
+                text += QString::number((double)(*(double*)((void*)&tmp)));
             }
             break;
         default:
-            text += QString("?");
+            text += QLatin1Char('?');
         }
         break;
     case DltTypeInfoRawd:
-        text += toAscii(data);
+        appendAscii(text,data);
         break;
     case DltTypeInfoTrai:
-        text += QString("?");
+        text += QLatin1Char('?');
         break;
     default:
-        text += QString("?");
+        text += QLatin1Char('?');
     }
-
-    return text;
 }
 
 QVariant QDltArgument::getValue()
@@ -886,7 +1081,15 @@ QString QDltMsg::getTimeString()
 {
     char strtime[256];
     struct tm *time_tm;
+#ifdef Q_OS_WIN
+    /* localtime uses thread local storage on Windows */
     time_tm = localtime(&time);
+#else
+    /* messages are formatted in several threads during export */
+    struct tm time_buf;
+    time_tm = localtime_r(&time,&time_buf);
+#endif
+    strtime[0] = 0;
     if(time_tm)
         strftime(strtime, 256, "%Y/%m/%d %H:%M:%S", time_tm);
     return QString(strtime);
@@ -920,6 +1123,7 @@ QString QDltMsg::getGmTimeWithOffsetString(qlonglong offset, bool dst)
 
 bool QDltMsg::setMsg(QByteArray buf, bool withStorageHeader)
 {
+    QDltProfilerScope profile("Parsing");
     unsigned int offset;
     QDltArgument argument;
     const DltStorageHeader *storageheader = 0;
@@ -949,12 +1153,12 @@ bool QDltMsg::setMsg(QByteArray buf, bool withStorageHeader)
     /* calculate complete size of headers */
     extra_size = DLT_STANDARD_HEADER_EXTRA_SIZE(standardheader->htyp)+(DLT_IS_HTYP_UEH(standardheader->htyp) ? sizeof(DltExtendedHeader) : 0);
     headersize = sizeStorageHeader + sizeof(DltStandardHeader) + extra_size;
-    datasize =  DLT_SWAP_16(standardheader->len) - (headersize - sizeStorageHeader);
 
-    /* check header length */
-    if (buf.size()  < (int)(headersize)) {
+    /* check header length, the length field must at least cover the headers */
+    if (buf.size()  < (int)(headersize) || DLT_SWAP_16(standardheader->len) < (headersize - sizeStorageHeader)) {
         return false;
     }
+    datasize =  DLT_SWAP_16(standardheader->len) - (headersize - sizeStorageHeader);
 
     /* store payload size */
     payloadSize = datasize;
@@ -1071,7 +1275,7 @@ bool QDltMsg::setMsg(QByteArray buf, bool withStorageHeader)
 
     /* extract session id */
     if (DLT_IS_HTYP_WSID(standardheader->htyp)) {
-        sessionid = headerextra.tmsp;
+        sessionid = headerextra.seid;
     }
 
     /* extract message counter */
@@ -1093,20 +1297,12 @@ bool QDltMsg::setMsg(QByteArray buf, bool withStorageHeader)
     /* set messageid if non verbose and no extended header */
     if(!DLT_IS_HTYP_UEH(standardheader->htyp) && payload.size()>=4) {
         /* message id is always in big endian format */
-        if(endianness == DltEndiannessLittleEndian) {
-            messageId = (*((unsigned int*) payload.constData()));
-        }
-        else {
-            messageId = DLT_SWAP_32((*((unsigned int*) payload.constData())));
-        }
+        messageId = qDltRead32(payload.constData(),endianness == DltEndiannessBigEndian);
     }
 
     /* set service id if message of type control */
     if((type == DltTypeControl) && payload.size()>=4) {
-        if(endianness == DltEndiannessLittleEndian)
-            ctrlServiceId = *((unsigned int*) payload.constData());
-        else
-            ctrlServiceId = DLT_SWAP_32(*((unsigned int*) payload.constData()));
+        ctrlServiceId = qDltRead32(payload.constData(),endianness == DltEndiannessBigEndian);
     }
 
     /* set return type if message of type control response */
@@ -1138,6 +1334,9 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
 
     /* empty return buffer */
     buf.clear();
+    memset(&storageheader,0,sizeof(storageheader));
+    memset(&headerextra,0,sizeof(headerextra));
+    memset(&extendedheader,0,sizeof(extendedheader));
 
     /* prepare payload */
     payload.clear();
@@ -1273,186 +1472,1327 @@ QString QDltMsg::toStringHeader()
     QString text;
     text.reserve(1024);
 
-    text += QString("%1.%2").arg(getTimeString()).arg(getMicroseconds(),6,10,QLatin1Char('0'));
-    text += QString(" %1.%2").arg(getTimestamp()/10000).arg(getTimestamp()%10000,4,10,QLatin1Char('0'));
-    text += QString(" %1").arg(getMessageCounter());
-    text += QString(" %1").arg(getEcuid());
-    text += QString(" %1").arg(getApid());
-    text += QString(" %1").arg(getCtid());
-    text += QString(" %2").arg(getTypeString());
-    text += QString(" %2").arg(getSubtypeString());
-    text += QString(" %2").arg(getModeString());
-    text += QString(" %1").arg(getNumberOfArguments());
+    toStringHeader(text);
 
     return text;
 }
 
+void QDltMsg::toStringHeader(QString &text)
+{
+    text += getTimeString();
+    text += QLatin1Char('.');
+    appendNumber(text,getMicroseconds(),6);
+    text += QLatin1Char(' ');
+    appendNumber(text,getTimestamp()/10000);
+    text += QLatin1Char('.');
+    appendNumber(text,getTimestamp()%10000,4);
+    text += QLatin1Char(' ');
+    appendNumber(text,getMessageCounter());
+    text += QLatin1Char(' ');
+    text += getEcuid();
+    text += QLatin1Char(' ');
+    text += getApid();
+    text += QLatin1Char(' ');
+    text += getCtid();
+    text += QLatin1Char(' ');
+    text += getTypeString();
+    text += QLatin1Char(' ');
+    text += getSubtypeString();
+    text += QLatin1Char(' ');
+    text += getModeString();
+    text += QLatin1Char(' ');
+    appendNumber(text,getNumberOfArguments());
+}
+
 QString QDltMsg::toStringPayload()
 {
     QString text;
+    text.reserve(1024);
+
+    toStringPayload(text);
+
+    return text;
+}
+
+void QDltMsg::toStringPayload(QString &text)
+{
     QDltArgument argument;
     QByteArray data;
 
-    text.reserve(1024);
-
     if((getMode()==QDltMsg::DltModeNonVerbose) && (getType()!=QDltMsg::DltTypeControl) && (getNumberOfArguments() == 0)) {
-        text += QString("[%1] ").arg(getMessageId());
+        text += QLatin1Char('[');
+        appendNumber(text,getMessageId());
+        text += QLatin1String("] ");
         data = payload.mid(4,(payload.size()>260)?256:(payload.size()-4));
         //text += toAscii(data);
         //text += toAsciiTable(data,false,false,true,8,64,false);
         if(!data.isEmpty())
         {
-            text += toAscii(data, true);
-            text += "|";
-            text += toAscii(data, false);
+            appendAscii(text,data,true);
+            text += QLatin1Char('|');
+            appendAscii(text,data,false);
         }
-        return text;
+        return;
     }
 
     if( getType()==QDltMsg::DltTypeControl && getSubtype()==QDltMsg::DltControlResponse) {
-        text += QString("[%1 %2] ").arg(getCtrlServiceIdString()).arg(getCtrlReturnTypeString());
+        text += QLatin1Char('[');
+        text += getCtrlServiceIdString();
+        text += QLatin1Char(' ');
+        text += getCtrlReturnTypeString();
+        text += QLatin1String("] ");
 
         // ServiceID of Get ECU Software Version
         if(getCtrlServiceId() == 0x13)
         {
             // Skip the ServiceID, Status and Lenght bytes and start from the String containing the ECU Software Version
             data = payload.mid(9,(payload.size()>262)?256:(payload.size()-9));
-            text += toAscii(data,true);
+            appendAscii(text,data,true);
         }
         else
         {
             data = payload.mid(6,(payload.size()>262)?256:(payload.size()-6));
-            text += toAscii(data);
+            appendAscii(text,data);
         }
 
-        return text;
+        return;
     }
 
     if( getType()==QDltMsg::DltTypeControl) {
-        text += QString("[%1] ").arg(getCtrlServiceIdString());
+        text += QLatin1Char('[');
+        text += getCtrlServiceIdString();
+        text += QLatin1String("] ");
         data = payload.mid(4,(payload.size()>260)?256:(payload.size()-4));
-        text += toAscii(data);
+        appendAscii(text,data);
 
-        return text;
+        return;
     }
 
     for(int num=0;num<arguments.size();num++) {
         if(getArgument(num,argument)) {
             if(num!=0) {
-                text += " ";
+                text += QLatin1Char(' ');
             }
-            text += argument.toString();
+            argument.toString(text);
         }
 
     }
-
-    return text;
 }
 
-QDltFile::QDltFile()
+/* Compare positions in indexAll by their sort key, equal keys keep the file order. */
+class QDltTimeKeyLess
 {
-    filterFlag = false;
-}
+public:
+    QDltTimeKeyLess(const qint64 *_keys) : keys(_keys) {}
 
-QDltFile::~QDltFile()
-{
-    if(infile.isOpen()) {
-        infile.close();
+    bool operator()(int a,int b) const
+    {
+        return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
     }
-}
 
-void QDltFile::setDltIndex(QList<unsigned long> &_indexAll){
-    indexAll = _indexAll;
-}
+private:
+    const qint64 *keys;
+};
 
-int QDltFile::size()
+/* Part of the time index which is sorted or merged by one thread. */
+typedef struct
 {
-    return indexAll.size();
+    int *data;
+    const qint64 *keys;
+    int begin;
+    int middle;
+    int end;
+} QDltTimeSortRange;
+
+static void qDltTimeSortRange(QDltTimeSortRange &range)
+{
+    std::sort(range.data+range.begin,range.data+range.end,QDltTimeKeyLess(range.keys));
 }
 
-int QDltFile::sizeFilter()
+static void qDltTimeMergeRange(QDltTimeSortRange &range)
 {
-    if(filterFlag)
-        return indexFilter.size();
-    else
-        return indexAll.size();
+    std::inplace_merge(range.data+range.begin,range.data+range.middle,range.data+range.end,QDltTimeKeyLess(range.keys));
 }
 
-bool QDltFile::open(QString _filename) {
+/* Get the sort key from the beginning of a DLT message including storage header. */
+static qint64 qDltTimeKey(const char *data,int size,QDltFile::DltSortDef mode,qint64 lastKey)
+{
+    const DltStorageHeader *storageheader;
+    const DltStandardHeader *standardheader;
+    uint32_t tmsp;
+    int offset;
 
-    qDebug() << "Open file" << _filename << "started";
+    if(size < (int)(sizeof(DltStorageHeader)+sizeof(DltStandardHeader)))
+        return lastKey;
 
-    /* check if file is already opened */
-    if(infile.isOpen()) {
-        qWarning() << "infile.isOpen: file is already open";
-        infile.close();
-    }
+    storageheader = (const DltStorageHeader*) data;
+    if(mode == QDltFile::DltSortStorageTime)
+        return (qint64)storageheader->seconds * 1000000 + storageheader->microseconds;
 
-    /* set new filename */
-    infile.setFileName(_filename);
+    /* messages without timestamp keep their place behind the message before */
+    standardheader = (const DltStandardHeader*) (data + sizeof(DltStorageHeader));
+    if(!DLT_IS_HTYP_WTMS(standardheader->htyp))
+        return lastKey;
 
-    /* open the log file read only */
-    if(infile.open(QIODevice::ReadOnly)==false) {
-        /* open file failed */
-        qWarning() << "open of file" << _filename << "failed";
-        return false;
-    }
+    offset = sizeof(DltStorageHeader) + sizeof(DltStandardHeader)
+            + (DLT_IS_HTYP_WEID(standardheader->htyp) ? DLT_SIZE_WEID : 0)
+            + (DLT_IS_HTYP_WSID(standardheader->htyp) ? DLT_SIZE_WSID : 0);
+    if(size < offset + DLT_SIZE_WTMS)
+        return lastKey;
 
-    qDebug() << "Open file" << _filename << "finished";
+    memcpy(&tmsp,data+offset,DLT_SIZE_WTMS);
 
-    return true;
+    return (qint64)DLT_BETOH_32(tmsp);
 }
 
-void QDltFile::clearIndex()
+/* Header values of a DLT message, read without parsing the message. */
+typedef struct
 {
-    indexAll.clear();
-}
-
-bool QDltFile::createIndex()
+    quint32 ecuid;
+    quint32 apid;
+    quint32 ctid;
+    quint32 msin;
+    int payloadOffset;
+    int payloadSize;
+} QDltHeaderValues;
+
+/* Get the header values from the beginning of a DLT message including storage header. */
+static bool qDltHeaderValues(const char *data,int size,QDltHeaderValues &values)
 {
-    bool ret = false;
-
-    qDebug() << "Create index started";
+    const DltStandardHeader *standardheader;
+    const DltExtendedHeader *extendedheader;
+    quint16 len;
+    int offset;
 
-    /* check if file is already opened */
-    if(!infile.isOpen()) {
-        /* return empty buffer */
-        qDebug() << "createIndex: Infile is not open";
-        return ret;
-    }
+    if(size < (int)(sizeof(DltStorageHeader)+sizeof(DltStandardHeader)))
+        return false;
 
-    clearIndex();
+    standardheader = (const DltStandardHeader*) (data + sizeof(DltStorageHeader));
+    offset = sizeof(DltStorageHeader) + sizeof(DltStandardHeader);
 
-    /* Example to use QtConcurrent to call updateIndex in sepearte Thread*/
-    //QFuture<bool> f = QtConcurrent::run(this, &QDltFile::updateIndex);
-    //f.waitForFinished();
+    /* the ECU id of the standard header is used, if available */
+    memcpy(&values.ecuid,((const DltStorageHeader*) data)->ecu,DLT_ID_SIZE);
+    if(DLT_IS_HTYP_WEID(standardheader->htyp)) {
+        if(size < offset + DLT_SIZE_WEID)
+            return false;
+        memcpy(&values.ecuid,data+offset,DLT_ID_SIZE);
+    }
+    offset += DLT_STANDARD_HEADER_EXTRA_SIZE(standardheader->htyp);
 
-    ret = updateIndex();
+    values.apid = 0;
+    values.ctid = 0;
+    values.msin = 0;
+    if(DLT_IS_HTYP_UEH(standardheader->htyp)) {
+        if(size < offset + (int)sizeof(DltExtendedHeader))
+            return false;
+        extendedheader = (const DltExtendedHeader*) (data + offset);
+        values.msin = extendedheader->msin;
+        memcpy(&values.apid,extendedheader->apid,DLT_ID_SIZE);
+        memcpy(&values.ctid,extendedheader->ctid,DLT_ID_SIZE);
+        offset += sizeof(DltExtendedHeader);
+    }
 
-    qDebug() << "Create index finished - "<< indexAll.size() << "messages found";
+    memcpy(&len,&standardheader->len,sizeof(len));
+    values.payloadOffset = offset;
+    values.payloadSize = (int)DLT_BETOH_16(len) + (int)sizeof(DltStorageHeader) - offset;
 
-    return ret;
+    return values.payloadSize >= 0;
 }
 
-bool QDltFile::updateIndex()
+/* Find all DLT0x01 markers in a buffer read from position pos of a file.
+   lastFound keeps the state of a marker split between two buffers. */
+static void qDltFindMarkers(const char *cbuf,int cbuf_sz,unsigned long pos,char &lastFound,QList<unsigned long> &index)
 {
-    QByteArray buf;
-    unsigned long pos = 0;
-
-    /* check if file is already opened */
-    if(!infile.isOpen()) {
-        qDebug() << "updateIndex: Infile is not open";
-        return false;
-    }
-
-    mutexQDlt.lock();
-
-    /* start at last found position */
-    if(indexAll.size()) {
-        /* move behind last found position */
-        pos = indexAll[indexAll.size()-1] + 4;
-        infile.seek(pos);
-    }
+    for(int num=0;num<cbuf_sz;num++) {
+        if(cbuf[num] == 'D')
+        {
+            lastFound = 'D';
+        }
+        else if(lastFound == 'D' && cbuf[num] == 'L')
+        {
+            lastFound = 'L';
+        }
+        else if(lastFound == 'L' && cbuf[num] == 'T')
+        {
+            lastFound = 'T';
+        }
+        else if(lastFound == 'T' && cbuf[num] == 0x01)
+        {
+            index.append(pos+num-3);
+            lastFound = 0;
+        }
+        else
+        {
+            lastFound = 0;
+        }
+    }
+}
+
+/* Layout of a compressed DLT log file:
+   header with magic and version, the compressed blocks,
+   the compressed footer with the block index and the message lengths,
+   the trailer with the position of the footer and the magic. */
+static const char qDltCompressedMagic[] = "DLTZ";
+static const quint32 QDLT_COMPRESSED_VERSION = 1;
+static const int QDLT_COMPRESSED_HEADER_SZ = 8;
+static const int QDLT_COMPRESSED_TRAILER_SZ = 12;
+
+/* Uncompressed size of one block, each block contains complete messages. */
+static const int QDLT_COMPRESSED_BLOCK_SZ = 1024 * 1024;
+
+static QByteArray qDltCompressBlock(const QByteArray &data)
+{
+    return qCompress(data);
+}
+
+static QByteArray qDltUncompressBlock(const QByteArray &data)
+{
+    return qUncompress(data);
+}
+
+QDltCompressedFile::QDltCompressedFile(const QString &name)
+{
+    file.setFileName(name);
+    position = 0;
+    dataSize = 0;
+    cacheSize = 16;
+    lastBlock = -2;
+}
+
+QDltCompressedFile::~QDltCompressedFile()
+{
+    close();
+}
+
+bool QDltCompressedFile::isCompressed(const QString &filename)
+{
+    QFile file(filename);
+
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    return file.read(4) == QByteArray(qDltCompressedMagic,4);
+}
+
+bool QDltCompressedFile::create(const QString &filename, QDltFile &file)
+{
+    QFile out(filename);
+    QVector<Block> blocks;
+    QVector<quint32> lengths;
+    qint64 pos = 0;
+    int num = 0;
+    int count = file.size();
+    int jobs = qMax(QThread::idealThreadCount(),1);
+
+    if(!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "open of file" << filename << "failed";
+        return false;
+    }
+
+    out.write(qDltCompressedMagic,4);
+    QDataStream header(&out);
+    header << QDLT_COMPRESSED_VERSION;
+
+    lengths.reserve(count);
+    while(num < count) {
+        QList<QByteArray> datas;
+
+        /* collect one block for each thread */
+        for(int job=0;job<jobs && num<count;job++) {
+            QByteArray data;
+            data.reserve(QDLT_COMPRESSED_BLOCK_SZ + DLT_MAX_MESSAGE_LEN);
+            while(num < count && data.size() < QDLT_COMPRESSED_BLOCK_SZ) {
+                QByteArray msg = file.getMsg(num++);
+                lengths.append(msg.size());
+                data.append(msg);
+            }
+            datas.append(data);
+        }
+
+        QList<QByteArray> compressed = QtConcurrent::blockingMapped(datas,qDltCompressBlock);
+
+        for(int job=0;job<compressed.size();job++) {
+            Block block;
+            block.filePos = out.pos();
+            block.fileSize = compressed[job].size();
+            block.pos = pos;
+            block.size = datas[job].size();
+            pos += block.size;
+            blocks.append(block);
+
+            if(out.write(compressed[job]) != compressed[job].size()) {
+                qWarning() << "write of file" << filename << "failed";
+                return false;
+            }
+        }
+    }
+
+    /* the footer is compressed as well, the message lengths are very similar */
+    QByteArray footer;
+    QDataStream stream(&footer,QIODevice::WriteOnly);
+    stream << (quint32)blocks.size();
+    for(int block=0;block<blocks.size();block++)
+        stream << blocks[block].filePos << blocks[block].fileSize << blocks[block].pos << blocks[block].size;
+    stream << (quint32)lengths.size();
+    for(int msg=0;msg<lengths.size();msg++)
+        stream << lengths[msg];
+
+    qint64 footerPos = out.pos();
+    out.write(qCompress(footer));
+    QDataStream trailer(&out);
+    trailer << footerPos;
+    out.write(qDltCompressedMagic,4);
+
+    return out.error() == QFile::NoError;
+}
+
+void QDltCompressedFile::setFileName(const QString &name)
+{
+    file.setFileName(name);
+}
+
+QString QDltCompressedFile::fileName() const
+{
+    return file.fileName();
+}
+
+bool QDltCompressedFile::open(OpenMode mode)
+{
+    quint32 version = 0;
+    qint64 footerPos = 0;
+
+    if(mode & QIODevice::WriteOnly) {
+        setErrorString("Compressed DLT log files can only be read");
+        return false;
+    }
+
+    if(!file.open(QIODevice::ReadOnly)) {
+        setErrorString(file.errorString());
+        return false;
+    }
+
+    /* check header and trailer */
+    QByteArray header = file.read(QDLT_COMPRESSED_HEADER_SZ);
+    QDataStream headerStream(header.mid(4));
+    headerStream >> version;
+    file.seek(file.size() - QDLT_COMPRESSED_TRAILER_SZ);
+    QByteArray trailer = file.read(QDLT_COMPRESSED_TRAILER_SZ);
+    QDataStream trailerStream(trailer);
+    trailerStream >> footerPos;
+
+    if(header.size() != QDLT_COMPRESSED_HEADER_SZ || !header.startsWith(qDltCompressedMagic) ||
+       version != QDLT_COMPRESSED_VERSION || trailer.size() != QDLT_COMPRESSED_TRAILER_SZ ||
+       !trailer.endsWith(qDltCompressedMagic) || footerPos < QDLT_COMPRESSED_HEADER_SZ ||
+       footerPos > file.size() - QDLT_COMPRESSED_TRAILER_SZ) {
+        setErrorString("Not a compressed DLT log file or file is incomplete");
+        file.close();
+        return false;
+    }
+
+    /* read block index and message index */
+    file.seek(footerPos);
+    QByteArray footer = qUncompress(file.read(file.size() - QDLT_COMPRESSED_TRAILER_SZ - footerPos));
+    QDataStream stream(footer);
+    quint32 count;
+
+    blocks.clear();
+    index.clear();
+    stream >> count;
+    blocks.reserve(count);
+    for(quint32 num=0;num<count && stream.status()==QDataStream::Ok;num++) {
+        Block block;
+        stream >> block.filePos >> block.fileSize >> block.pos >> block.size;
+        blocks.append(block);
+    }
+    stream >> count;
+    unsigned long pos = 0;
+    for(quint32 num=0;num<count && stream.status()==QDataStream::Ok;num++) {
+        quint32 length;
+        stream >> length;
+        index.append(pos);
+        pos += length;
+    }
+
+    if(stream.status() != QDataStream::Ok) {
+        setErrorString("Corrupted footer of compressed DLT log file");
+        blocks.clear();
+        index.clear();
+        file.close();
+        return false;
+    }
+
+    dataSize = blocks.isEmpty() ? 0 : blocks.last().pos + blocks.last().size;
+    position = 0;
+    lastBlock = -2;
+
+    return QIODevice::open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+void QDltCompressedFile::close()
+{
+    if(!isOpen())
+        return;
+
+    QIODevice::close();
+    clearCache();
+    file.close();
+    blocks.clear();
+    index.clear();
+    position = 0;
+    dataSize = 0;
+}
+
+bool QDltCompressedFile::isSequential() const
+{
+    return false;
+}
+
+qint64 QDltCompressedFile::size() const
+{
+    return dataSize;
+}
+
+bool QDltCompressedFile::seek(qint64 pos)
+{
+    if(pos < 0 || pos > dataSize)
+        return false;
+
+    QIODevice::seek(pos);
+    position = pos;
+
+    return true;
+}
+
+void QDltCompressedFile::setCacheSize(int blocks)
+{
+    cacheSize = qMax(blocks,1);
+
+    while(cacheOrder.size() > cacheSize)
+        cache.remove(cacheOrder.takeFirst());
+}
+
+QList<unsigned long> QDltCompressedFile::getIndex()
+{
+    return index;
+}
+
+qint64 QDltCompressedFile::readData(char *data, qint64 maxSize)
+{
+    qint64 done = 0;
+
+    while(done < maxSize && position < dataSize) {
+        int num = findBlock(position);
+        if(num < 0)
+            break;
+
+        QByteArray block = getBlock(num);
+        if(block.size() != (int)blocks[num].size) {
+            setErrorString(QString("Corrupted block %1 in compressed DLT log file").arg(num));
+            return done ? done : -1;
+        }
+
+        qint64 offset = position - blocks[num].pos;
+        qint64 len = qMin(maxSize - done,(qint64)block.size() - offset);
+        memcpy(data + done,block.constData() + offset,len);
+        done += len;
+        position += len;
+    }
+
+    return done;
+}
+
+qint64 QDltCompressedFile::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+
+    return -1;
+}
+
+int QDltCompressedFile::findBlock(qint64 pos) const
+{
+    int low = 0;
+    int high = blocks.size() - 1;
+
+    while(low <= high) {
+        int middle = (low + high) / 2;
+        if(pos < blocks[middle].pos)
+            high = middle - 1;
+        else if(pos >= blocks[middle].pos + blocks[middle].size)
+            low = middle + 1;
+        else
+            return middle;
+    }
+
+    return -1;
+}
+
+QByteArray QDltCompressedFile::getBlock(int num)
+{
+    QByteArray data;
+
+    if(cache.contains(num)) {
+        /* most recently used block is at the end */
+        cacheOrder.removeOne(num);
+        cacheOrder.append(num);
+        data = cache[num];
+    }
+    else {
+        if(pending.contains(num)) {
+            data = pending.take(num).result();
+        }
+        else {
+            file.seek(blocks[num].filePos);
+            data = qDltUncompressBlock(file.read(blocks[num].fileSize));
+        }
+
+        cache.insert(num,data);
+        cacheOrder.append(num);
+        while(cacheOrder.size() > cacheSize)
+            cache.remove(cacheOrder.takeFirst());
+    }
+
+    /* blocks read in order are decompressed in advance */
+    if(num == lastBlock + 1)
+        prefetch(num + 1);
+    lastBlock = num;
+
+    return data;
+}
+
+void QDltCompressedFile::prefetch(int num)
+{
+    int last = qMin(num + qMax(QThread::idealThreadCount(),1),blocks.size());
+
+    /* drop blocks decompressed in advance which were not read */
+    QMap<int,QFuture<QByteArray> >::iterator it = pending.begin();
+    while(it != pending.end()) {
+        if(it.key() < num - 1 || it.key() >= last)
+            it = pending.erase(it);
+        else
+            ++it;
+    }
+
+    for(;num<last;num++) {
+        if(cache.contains(num) || pending.contains(num))
+            continue;
+
+        file.seek(blocks[num].filePos);
+        pending.insert(num,QtConcurrent::run(qDltUncompressBlock,file.read(blocks[num].fileSize)));
+    }
+}
+
+void QDltCompressedFile::clearCache()
+{
+    /* running decompressions finish on their own copies of the data */
+    pending.clear();
+    cache.clear();
+    cacheOrder.clear();
+    lastBlock = -2;
+}
+
+/* Distance of the seek points of a gzip compressed file in the uncompressed content. */
+static const qint64 QDLT_GZIP_CHECKPOINT_DISTANCE = 4 * 1024 * 1024;
+
+/* Size of the deflate window, the history needed to restart the decompression. */
+static const int QDLT_GZIP_WINDOW_SZ = 32768;
+
+static const int QDLT_GZIP_CHUNK_SZ = 1024 * 1024;
+static const int QDLT_GZIP_INPUT_SZ = 256 * 1024;
+
+/* Size of the trailer of a gzip member with CRC and size. */
+static const int QDLT_GZIP_TRAILER_SZ = 8;
+
+QDltGzipFile::QDltGzipFile(const QString &name)
+{
+    file.setFileName(name);
+    stream = new z_stream;
+    memset(stream,0,sizeof(z_stream));
+    streamValid = false;
+    inputEnd = 0;
+    trailer = 0;
+    raw = false;
+    nextMember = false;
+    memberStart = false;
+    finished = true;
+    checkpointDistance = QDLT_GZIP_CHECKPOINT_DISTANCE;
+    chunkPos = 0;
+    position = 0;
+    dataSize = 0;
+    complete = false;
+}
+
+QDltGzipFile::~QDltGzipFile()
+{
+    close();
+    delete stream;
+}
+
+bool QDltGzipFile::isCompressed(const QString &filename)
+{
+    QFile file(filename);
+
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    return file.read(2) == QByteArray("\x1f\x8b");
+}
+
+void QDltGzipFile::setFileName(const QString &name)
+{
+    file.setFileName(name);
+}
+
+QString QDltGzipFile::fileName() const
+{
+    return file.fileName();
+}
+
+bool QDltGzipFile::open(OpenMode mode)
+{
+    if(mode & QIODevice::WriteOnly) {
+        setErrorString("Gzip compressed DLT log files can only be read");
+        return false;
+    }
+
+    if(!file.open(QIODevice::ReadOnly)) {
+        setErrorString(file.errorString());
+        return false;
+    }
+
+    /* the first seek point is the start of the file */
+    Checkpoint checkpoint;
+    checkpoint.pos = 0;
+    checkpoint.filePos = 0;
+    checkpoint.bits = 0;
+    checkpoint.member = true;
+    checkpoints.clear();
+    checkpoints.append(checkpoint);
+    position = 0;
+    dataSize = 0;
+    complete = false;
+
+    if(!restart(checkpoints.first())) {
+        file.close();
+        return false;
+    }
+
+    return QIODevice::open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+void QDltGzipFile::close()
+{
+    if(!isOpen())
+        return;
+
+    QIODevice::close();
+    if(streamValid)
+        inflateEnd(stream);
+    streamValid = false;
+    file.close();
+    input.clear();
+    history.clear();
+    chunk.clear();
+    checkpoints.clear();
+    chunkPos = 0;
+    position = 0;
+    dataSize = 0;
+    complete = false;
+    finished = true;
+}
+
+bool QDltGzipFile::isSequential() const
+{
+    return false;
+}
+
+qint64 QDltGzipFile::size() const
+{
+    return dataSize;
+}
+
+bool QDltGzipFile::seek(qint64 pos)
+{
+    if(pos < 0)
+        return false;
+
+    QIODevice::seek(pos);
+    position = pos;
+
+    return true;
+}
+
+void QDltGzipFile::setCheckpointDistance(qint64 distance)
+{
+    checkpointDistance = qMax(distance,(qint64)QDLT_GZIP_WINDOW_SZ);
+}
+
+void QDltGzipFile::copyCheckpoints(const QDltGzipFile &other)
+{
+    if(other.checkpoints.size() > checkpoints.size())
+        checkpoints = other.checkpoints;
+    dataSize = qMax(dataSize,other.dataSize);
+    complete = complete || other.complete;
+}
+
+qint64 QDltGzipFile::readData(char *data, qint64 maxSize)
+{
+    qint64 done = 0;
+
+    while(done < maxSize) {
+        if(position >= chunkPos && position < chunkPos + chunk.size()) {
+            qint64 offset = position - chunkPos;
+            qint64 len = qMin(maxSize - done,(qint64)chunk.size() - offset);
+            memcpy(data + done,chunk.constData() + offset,len);
+            done += len;
+            position += len;
+            continue;
+        }
+
+        /* restart at the nearest seek point when the position is before the
+           current chunk or a seek point is nearer than the current chunk */
+        const Checkpoint &checkpoint = checkpoints[findCheckpoint(position)];
+        if(position < chunkPos || checkpoint.pos > chunkPos + chunk.size()) {
+            if(!restart(checkpoint))
+                return done ? done : -1;
+        }
+
+        /* end of the data */
+        if(!inflateChunk())
+            break;
+    }
+
+    return done;
+}
+
+qint64 QDltGzipFile::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+
+    return -1;
+}
+
+int QDltGzipFile::findCheckpoint(qint64 pos) const
+{
+    int low = 0;
+    int high = checkpoints.size() - 1;
+
+    /* last seek point before or at the position, the first one is at 0 */
+    while(low < high) {
+        int middle = (low + high + 1) / 2;
+        if(checkpoints[middle].pos <= pos)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+
+    return low;
+}
+
+bool QDltGzipFile::restart(const Checkpoint &checkpoint)
+{
+    finished = true;
+
+    if(streamValid)
+        inflateEnd(stream);
+    memset(stream,0,sizeof(z_stream));
+    streamValid = false;
+
+    /* the gzip header is parsed at the start of a member, raw deflate data in the middle */
+    if(inflateInit2(stream,checkpoint.member ? 15 + 16 : -15) != Z_OK) {
+        setErrorString("Cannot initialize decompression");
+        return false;
+    }
+    streamValid = true;
+
+    /* a seek point inside of a byte needs the remaining bits of this byte */
+    input.clear();
+    inputEnd = checkpoint.filePos - (checkpoint.bits ? 1 : 0);
+    if(!file.seek(inputEnd)) {
+        setErrorString(file.errorString());
+        return false;
+    }
+    if(checkpoint.bits) {
+        char byte;
+        if(!file.getChar(&byte)) {
+            setErrorString(file.errorString());
+            return false;
+        }
+        inputEnd++;
+        inflatePrime(stream,checkpoint.bits,(unsigned char)byte >> (8 - checkpoint.bits));
+    }
+    if(!checkpoint.member)
+        inflateSetDictionary(stream,(const Bytef*)checkpoint.window.constData(),checkpoint.window.size());
+
+    history = checkpoint.window;
+    chunk.clear();
+    chunkPos = checkpoint.pos;
+    trailer = 0;
+    raw = !checkpoint.member;
+    nextMember = false;
+    memberStart = checkpoint.member && checkpoint.pos > 0;
+    finished = false;
+
+    return true;
+}
+
+bool QDltGzipFile::inflateChunk()
+{
+    int filled = 0;
+
+    if(finished)
+        return false;
+
+    /* the end of the previous chunk is the history of the new one */
+    if(chunk.size() >= QDLT_GZIP_WINDOW_SZ)
+        history = chunk.right(QDLT_GZIP_WINDOW_SZ);
+    else if(!chunk.isEmpty())
+        history = (history + chunk).right(QDLT_GZIP_WINDOW_SZ);
+    chunkPos += chunk.size();
+    chunk.resize(QDLT_GZIP_CHUNK_SZ);
+
+    while(filled < chunk.size() && !finished) {
+        if(stream->avail_in == 0) {
+            input = file.read(QDLT_GZIP_INPUT_SZ);
+            inputEnd += input.size();
+            stream->next_in = (Bytef*)input.data();
+            stream->avail_in = input.size();
+
+            if(input.isEmpty()) {
+                if(!nextMember)
+                    qWarning() << "gzip compressed file" << file.fileName() << "is incomplete";
+                finished = true;
+                complete = true;
+                break;
+            }
+        }
+
+        if(trailer > 0) {
+            /* the raw decompression started at a seek point does not read the trailer */
+            int skip = qMin(trailer,(int)stream->avail_in);
+            stream->next_in += skip;
+            stream->avail_in -= skip;
+            trailer -= skip;
+            continue;
+        }
+
+        if(nextMember) {
+            /* another gzip member follows, e.g. in concatenated files */
+            inflateReset2(stream,15 + 16);
+            raw = false;
+            nextMember = false;
+            memberStart = true;
+            addCheckpoint(chunkPos + filled,true);
+        }
+
+        stream->next_out = (Bytef*)chunk.data() + filled;
+        stream->avail_out = chunk.size() - filled;
+        int ret = inflate(stream,Z_BLOCK);
+        int produced = chunk.size() - filled - stream->avail_out;
+        filled += produced;
+        if(produced)
+            memberStart = false;
+
+        if(ret == Z_STREAM_END) {
+            trailer = raw ? QDLT_GZIP_TRAILER_SZ : 0;
+            nextMember = true;
+            continue;
+        }
+
+        if(ret != Z_OK && ret != Z_BUF_ERROR) {
+            /* data behind the last gzip member, e.g. padding, is ignored */
+            if(!memberStart)
+                qWarning() << "gzip compressed file" << file.fileName() << "is corrupted:" << (stream->msg ? stream->msg : "");
+            finished = true;
+            complete = memberStart;
+            break;
+        }
+
+        /* the end of a deflate block is a possible seek point */
+        if((stream->data_type & 128) && !(stream->data_type & 64))
+            addCheckpoint(chunkPos + filled,false);
+    }
+
+    chunk.resize(filled);
+    dataSize = qMax(dataSize,chunkPos + filled);
+
+    return filled > 0;
+}
+
+void QDltGzipFile::addCheckpoint(qint64 pos, bool member)
+{
+    /* seek points are only added when the file is read the first time */
+    if(pos < checkpoints.last().pos + (member ? 1 : checkpointDistance))
+        return;
+
+    Checkpoint checkpoint;
+    checkpoint.pos = pos;
+    checkpoint.filePos = inputEnd - stream->avail_in;
+    checkpoint.bits = member ? 0 : (stream->data_type & 7);
+    checkpoint.member = member;
+
+    if(!member) {
+        int offset = pos - chunkPos;
+        if(offset >= QDLT_GZIP_WINDOW_SZ)
+            checkpoint.window = chunk.mid(offset - QDLT_GZIP_WINDOW_SZ,QDLT_GZIP_WINDOW_SZ);
+        else
+            checkpoint.window = history.right(QDLT_GZIP_WINDOW_SZ - offset) + chunk.left(offset);
+    }
+
+    checkpoints.append(checkpoint);
+}
+
+/* Index and storage times of one file of a merged log. */
+typedef struct
+{
+    QString filename;
+    QIODevice *device;
+    QList<unsigned long> index;
+    QVector<qint64> keys;
+} QDltMergeSource;
+
+/* Create the device reading a log file, depending on the compression of the file. */
+static QIODevice *qDltCreateDevice(const QString &filename)
+{
+    if(QDltCompressedFile::isCompressed(filename))
+        return new QDltCompressedFile(filename);
+    if(QDltGzipFile::isCompressed(filename))
+        return new QDltGzipFile(filename);
+
+    return new QFile(filename);
+}
+
+/* Create the index of one file of a merged log, called in parallel for all files. */
+static void qDltIndexMergeSource(QDltMergeSource &source)
+{
+    QScopedPointer<QIODevice> device(qDltCreateDevice(source.filename));
+    QIODevice &file = *device;
+    QDltCompressedFile *compressedFile = dynamic_cast<QDltCompressedFile*>(device.data());
+    QByteArray buf;
+    unsigned long pos = 0;
+    unsigned long bufPos = 0;
+    char lastFound = 0;
+    qint64 lastKey = 0;
+    int num = 0;
+
+    /* Align kbytes, 1MB read at a time */
+    static const int READ_BUF_SZ = 1024 * 1024;
+    static const int HEADER_SZ = sizeof(DltStorageHeader) + sizeof(DltStandardHeader);
+
+    source.index.clear();
+    source.keys.clear();
+
+    if(file.open(QIODevice::ReadOnly)==false) {
+        qWarning() << "open of file" << source.filename << "failed";
+        return;
+    }
+
+    if(compressedFile) {
+        /* the message index is stored in the compressed file,
+           only the storage times have to be read */
+        source.index = compressedFile->getIndex();
+        source.keys.reserve(source.index.size());
+        for(num=0;num<source.index.size();num++) {
+            pos = source.index[num];
+
+            if(buf.isEmpty() || pos + HEADER_SZ > bufPos + buf.size()) {
+                file.seek(pos);
+                buf = file.read(READ_BUF_SZ);
+                bufPos = pos;
+            }
+
+            int offset = pos - bufPos;
+            lastKey = qDltTimeKey(buf.constData() + offset,buf.size() - offset,QDltFile::DltSortStorageTime,lastKey);
+            source.keys.append(lastKey);
+        }
+    }
+    else {
+        /* walk through the whole file once, find all DLT0x01 markers and read
+           the storage time of each message, so compressed files are decompressed only once */
+        while(true) {
+            QByteArray data = file.read(READ_BUF_SZ);
+            if(data.isEmpty())
+                break; // EOF
+
+            qDltFindMarkers(data.constData(),data.size(),pos,lastFound,source.index);
+            pos += data.size();
+
+            /* keep the end of the previous buffer for headers split between two buffers */
+            bufPos = pos - data.size() - buf.size();
+            buf.append(data);
+
+            for(;num<source.index.size() && source.index[num] + HEADER_SZ <= pos;num++) {
+                int offset = source.index[num] - bufPos;
+                lastKey = qDltTimeKey(buf.constData() + offset,buf.size() - offset,QDltFile::DltSortStorageTime,lastKey);
+                source.keys.append(lastKey);
+            }
+
+            buf = buf.right(HEADER_SZ);
+        }
+
+        /* messages at the end of the file with incomplete header */
+        for(;num<source.index.size();num++)
+            source.keys.append(lastKey);
+
+        /* the device of the merged log continues with the seek points found while indexing */
+        QDltGzipFile *gzipFile = dynamic_cast<QDltGzipFile*>(device.data());
+        QDltGzipFile *target = dynamic_cast<QDltGzipFile*>(source.device);
+        if(gzipFile && target)
+            target->copyCheckpoints(*gzipFile);
+    }
+
+    file.close();
+}
+
+/* Next message of one file while merging, ordered by time, file and position. */
+typedef struct QDltMergeHead
+{
+    qint64 key;
+    int source;
+    int num;
+
+    bool operator>(const QDltMergeHead &other) const
+    {
+        if(key != other.key)
+            return key > other.key;
+        if(source != other.source)
+            return source > other.source;
+        return num > other.num;
+    }
+} QDltMergeHead;
+
+QDltFile::QDltFile()
+{
+    filterFlag = false;
+    sortMode = DltSortNone;
+    removedMsgs = 0;
+    indexFilterSorted = 0;
+}
+
+QDltFile::~QDltFile()
+{
+    if(infile.isOpen()) {
+        infile.close();
+    }
+    closeMerge();
+}
+
+void QDltFile::setDltIndex(QList<unsigned long> &_indexAll){
+    indexAll = _indexAll;
+    indexSource.clear();
+    removedMsgs = 0;
+
+    timeKeys.clear();
+    indexTime.clear();
+    clearColumns();
+    updateIndexTime();
+}
+
+void QDltFile::appendDltIndex(QList<unsigned long> &_index){
+    mutexQDlt.lock();
+
+    indexAll.append(_index);
+    if(!indexSource.isEmpty())
+        indexSource.insert(indexSource.end(),_index.size(),0);
+
+    mutexQDlt.unlock();
+
+    /* add the new messages to the time index */
+    updateIndexTime();
+}
+
+int QDltFile::checkMsg(const char *data,int size)
+{
+    DltStandardHeader standardheader;
+    int minsize;
+
+    if(size < (int)(sizeof(DltStorageHeader) + sizeof(DltStandardHeader)))
+        return (size >= 4 && memcmp(data,"DLT\x01",4) != 0) ? -1 : 0;
+
+    if(memcmp(data,"DLT\x01",4) != 0)
+        return -1;
+
+    memcpy(&standardheader,data + sizeof(DltStorageHeader),sizeof(DltStandardHeader));
+    if((standardheader.htyp & DLT_HTYP_VERS) != DLT_HTYP_PROTOCOL_VERSION1)
+        return -1;
+
+    /* the length has to cover all headers announced by the header type */
+    minsize = sizeof(DltStandardHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(standardheader.htyp)
+            + (DLT_IS_HTYP_UEH(standardheader.htyp) ? sizeof(DltExtendedHeader) : 0);
+    if(DLT_BETOH_16(standardheader.len) < minsize)
+        return -1;
+
+    if(size < (int)sizeof(DltStorageHeader) + DLT_BETOH_16(standardheader.len))
+        return 0;
+
+    return sizeof(DltStorageHeader) + DLT_BETOH_16(standardheader.len);
+}
+
+int QDltFile::size()
+{
+    return indexAll.size();
+}
+
+int QDltFile::sizeFilter()
+{
+    if(filterFlag)
+        return indexFilter.size();
+    else
+        return indexAll.size();
+}
+
+void QDltFile::removeMsgs(int count)
+{
+    mutexQDlt.lock();
+
+    /* the last message of infile is kept, updateIndex() continues behind it */
+    int last = indexAll.size();
+    for(int num=indexSource.size()-1;num>=0;num--) {
+        if(indexSource[num] == 0) {
+            last = num + 1;
+            break;
+        }
+    }
+    count = qBound(0,count,last - 1);
+    if(count == 0) {
+        mutexQDlt.unlock();
+        return;
+    }
+
+    indexAll.erase(indexAll.begin(),indexAll.begin() + count);
+    if(!indexSource.isEmpty())
+        indexSource.remove(0,count);
+    timeKeys.remove(0,qMin(count,timeKeys.size()));
+    for(int column=0;column<DltColumnCount;column++)
+        columns[column].remove(0,qMin(count,columns[column].size()));
+
+    /* the time index and the filter index contain message numbers */
+    int used = 0;
+    for(int num=0;num<indexTime.size();num++) {
+        if(indexTime[num] >= count)
+            indexTime[used++] = indexTime[num] - count;
+    }
+    indexTime.resize(used);
+
+    QList<unsigned long> filter;
+    int sorted = 0;
+    filter.reserve(indexFilter.size());
+    for(int num=0;num<indexFilter.size();num++) {
+        if(indexFilter[num] >= (unsigned long)count) {
+            filter.append(indexFilter[num] - count);
+            if(num < indexFilterSorted)
+                sorted++;
+        }
+    }
+    indexFilter = filter;
+    indexFilterSorted = sorted;
+
+    removedMsgs += count;
+
+    mutexQDlt.unlock();
+}
+
+int QDltFile::getRemovedMsgs()
+{
+    return removedMsgs;
+}
+
+int QDltFile::getMsgNumber(int index)
+{
+    return index + removedMsgs;
+}
+
+bool QDltFile::open(QString _filename) {
+
+    qDebug() << "Open file" << _filename << "started";
+
+    /* check if file is already opened */
+    if(infile.isOpen()) {
+        qWarning() << "infile.isOpen: file is already open";
+        infile.close();
+    }
+
+    /* set new filename */
+    infile.setFileName(_filename);
+
+    /* open the log file read only */
+    if(infile.open(QIODevice::ReadOnly)==false) {
+        /* open file failed */
+        qWarning() << "open of file" << _filename << "failed";
+        return false;
+    }
+
+    qDebug() << "Open file" << _filename << "finished";
+
+    return true;
+}
+
+void QDltFile::clearIndex()
+{
+    indexAll.clear();
+    indexSource.clear();
+    timeKeys.clear();
+    indexTime.clear();
+    clearColumns();
+    removedMsgs = 0;
+}
+
+bool QDltFile::createIndex()
+{
+    bool ret = false;
+
+    qDebug() << "Create index started";
+
+    /* check if file is already opened */
+    if(!infile.isOpen()) {
+        /* return empty buffer */
+        qDebug() << "createIndex: Infile is not open";
+        return ret;
+    }
+
+    clearIndex();
+
+    /* Example to use QtConcurrent to call updateIndex in sepearte Thread*/
+    //QFuture<bool> f = QtConcurrent::run(this, &QDltFile::updateIndex);
+    //f.waitForFinished();
+
+    ret = updateIndex();
+
+    qDebug() << "Create index finished - "<< indexAll.size() << "messages found";
+
+    return ret;
+}
+
+bool QDltFile::updateIndex()
+{
+    QByteArray buf;
+    unsigned long pos = 0;
+
+    /* check if file is already opened */
+    if(!infile.isOpen()) {
+        qDebug() << "updateIndex: Infile is not open";
+        return false;
+    }
+
+    mutexQDlt.lock();
+
+    /* start at last found position */
+    if(!indexSource.isEmpty()) {
+        /* merged log, new messages are only added to infile */
+        for(int num=indexAll.size()-1;num>=0;num--) {
+            if(indexSource[num] == 0) {
+                pos = indexAll[num] + 4;
+                break;
+            }
+        }
+        infile.seek(pos);
+    }
+    else if(indexAll.size()) {
+        /* move behind last found position */
+        pos = indexAll[indexAll.size()-1] + 4;
+        infile.seek(pos);
+    }
     else {
         /* the file was empty the last call */
         infile.seek(0);
@@ -1461,94 +2801,267 @@ bool QDltFile::updateIndex()
     /* Align kbytes, 1MB read at a time */
     static const int READ_BUF_SZ = 1024 * 1024;
 
-    /* walk through the whole file and find all DLT0x01 markers */
-    /* store the found positions in the indexAll */
-    char lastFound = 0;
+    /* walk through the whole file and find all DLT0x01 markers */
+    /* store the found positions in the indexAll */
+    QDltProfilerScope profile("Indexing");
+    char lastFound = 0;
+    int oldsize = indexAll.size();
+
+    while(true) {
+
+        /* read buffer from file */
+        buf = infile.read(READ_BUF_SZ);
+        if(buf.isEmpty())
+            break; // EOF
+
+        /* find marker in buffer */
+        qDltFindMarkers(buf.constData(),buf.size(),pos,lastFound,indexAll);
+        pos += buf.size();
+    }
+
+    if(!indexSource.isEmpty())
+        indexSource.insert(indexSource.end(),indexAll.size()-oldsize,0);
+
+    mutexQDlt.unlock();
+
+    profile.setItems(indexAll.size()-oldsize);
+    profile.stop();
+
+    /* add the new messages to the time index */
+    updateIndexTime();
+
+    /* success */
+    return true;
+}
+
+bool QDltFile::createIndexFilter()
+{
+    /* clear old index */
+    indexFilter.clear();
+    indexFilterSorted = 0;
+
+    return updateIndexFilter();
+}
+
+bool QDltFile::updateIndexFilter()
+{
+    QDltMsg msg;
+    QByteArray buf;
+    int index;
+
+    /* update index filter by starting from last found index in list */
+
+    /* get lattest found index in filter list, which is not the last one if sorted by time */
+    if(indexFilter.size()>0) {
+        index = *std::max_element(indexFilter.constBegin(),indexFilter.constEnd()) + 1;
+    }
+    else {
+        index = 0;
+    }
+
+    for(int num=index;num<indexAll.size();num++) {
+        buf = getMsg(num);
+        if(!buf.isEmpty()) {
+            msg.setMsg(buf);
+            if(checkFilter(msg)) {
+                indexFilter.append(num);
+            }
+        }
+
+    }
+
+    sortFilterIndex();
+
+    return true;
+}
+
+void QDltFile::setSortMode(DltSortDef mode)
+{
+    if(mode == sortMode)
+        return;
+
+    sortMode = mode;
+
+    createIndexTime();
+
+    /* present the filtered messages in the new order */
+    if(sortMode != DltSortNone && timeKeys.size() == indexAll.size())
+        std::sort(indexFilter.begin(),indexFilter.end(),QDltTimeKeyLess(timeKeys.constData()));
+    else
+        qSort(indexFilter);
+    indexFilterSorted = indexFilter.size();
+}
+
+QDltFile::DltSortDef QDltFile::getSortMode()
+{
+    return sortMode;
+}
+
+bool QDltFile::createIndexTime()
+{
+    timeKeys.clear();
+    indexTime.clear();
+
+    return updateIndexTime();
+}
+
+bool QDltFile::updateIndexTime()
+{
+    QList<QByteArray> bufs;
+    QList<unsigned long> bufPos;
+    qint64 lastKey;
+    int first;
+
+    if(sortMode == DltSortNone)
+        return true;
+
+    /* check if file is already opened */
+    if(!infile.isOpen()) {
+        qDebug() << "updateIndexTime: Infile is not open";
+        return false;
+    }
+
+    /* Align kbytes, 1MB read at a time */
+    static const int READ_BUF_SZ = 1024 * 1024;
+    static const int KEY_HEADER_SZ = sizeof(DltStorageHeader) + sizeof(DltStandardHeader) + sizeof(DltStandardHeaderExtra);
+
+    QDltProfilerScope profile("Sorting");
 
-    while(true) {
+    mutexQDlt.lock();
 
-        /* read buffer from file */
-        buf = infile.read(READ_BUF_SZ);
-        if(buf.isEmpty())
-            break; // EOF
+    /* read the sort keys of the new messages, the messages are read in blocks
+       as the headers of consecutive messages are close to each other,
+       each file of a merged log has its own block */
+    for(int num=0;num<=mergeFiles.size();num++) {
+        bufs.append(QByteArray());
+        bufPos.append(0);
+    }
+    first = timeKeys.size();
+    profile.setItems(indexAll.size() - first);
+    lastKey = first ? timeKeys[first-1] : 0;
+    timeKeys.reserve(indexAll.size());
+    for(int num=first;num<indexAll.size();num++) {
+        unsigned long pos = indexAll[num];
+        int source = indexSource.isEmpty() ? 0 : indexSource[num];
+        QByteArray &buf = bufs[source];
+
+        if(buf.isEmpty() || pos < bufPos[source] || pos + KEY_HEADER_SZ > bufPos[source] + buf.size()) {
+            QIODevice *file = getMsgFile(num);
+            file->seek(pos);
+            buf = file->read(READ_BUF_SZ);
+            bufPos[source] = pos;
+        }
 
-        /* Use primitive buffer for faster access */
-        int cbuf_sz = buf.size();
-        const char *cbuf = buf.constData();
+        int offset = pos - bufPos[source];
+        lastKey = qDltTimeKey(buf.constData() + offset,buf.size() - offset,sortMode,lastKey);
+        timeKeys.append(lastKey);
+    }
 
-        /* find marker in buffer */
-        for(int num=0;num<cbuf_sz;num++) {
-            if(cbuf[num] == 'D')
-            {
-                lastFound = 'D';
-            }
-            else if(lastFound == 'D' && cbuf[num] == 'L')
-            {
-                lastFound = 'L';
-            }
-            else if(lastFound == 'L' && cbuf[num] == 'T')
-            {
-                lastFound = 'T';
-            }
-            else if(lastFound == 'T' && cbuf[num] == 0x01)
-            {
-                indexAll.append(pos+num-3);
-                lastFound = 0;
-            }
-            else
-            {
-                lastFound = 0;
+    mutexQDlt.unlock();
+
+    QDltTimeKeyLess less(timeKeys.constData());
+
+    if(first == 0) {
+        /* sort the whole index, each thread sorts one part which are merged afterwards */
+        int count = timeKeys.size();
+        int chunks = QThread::idealThreadCount();
+
+        indexTime.resize(count);
+        for(int num=0;num<count;num++)
+            indexTime[num] = num;
+
+        if(count < 100000 || chunks < 2) {
+            std::sort(indexTime.begin(),indexTime.end(),less);
+            return true;
+        }
+
+        QList<QDltTimeSortRange> ranges;
+        for(int num=0;num<chunks;num++) {
+            QDltTimeSortRange range;
+            range.data = indexTime.data();
+            range.keys = timeKeys.constData();
+            range.begin = (qint64)count * num / chunks;
+            range.end = (qint64)count * (num+1) / chunks;
+            range.middle = range.end;
+            ranges.append(range);
+        }
+        QtConcurrent::blockingMap(ranges,qDltTimeSortRange);
+
+        while(ranges.size() > 1) {
+            QList<QDltTimeSortRange> merges;
+            for(int num=0;num+1<ranges.size();num+=2) {
+                QDltTimeSortRange range = ranges[num];
+                range.middle = ranges[num].end;
+                range.end = ranges[num+1].end;
+                merges.append(range);
             }
+            QtConcurrent::blockingMap(merges,qDltTimeMergeRange);
+            if(ranges.size() % 2)
+                merges.append(ranges.last());
+            ranges = merges;
         }
-        pos += cbuf_sz;
     }
+    else {
+        /* the new messages are sorted and merged once, they are usually the latest ones,
+           but an appended log of another source can be interleaved with all messages */
+        int count = indexTime.size();
 
-    mutexQDlt.unlock();
+        indexTime.resize(count + timeKeys.size() - first);
+        for(int num=first;num<timeKeys.size();num++)
+            indexTime[count + num - first] = num;
+
+        std::sort(indexTime.begin() + count,indexTime.end(),less);
+        if(count > 0 && less(indexTime[count],indexTime[count-1]))
+            std::inplace_merge(indexTime.begin(),indexTime.begin() + count,indexTime.end(),less);
+    }
 
-    /* success */
     return true;
 }
 
-bool QDltFile::createIndexFilter()
+qint64 QDltFile::getTimeKey(int index)
 {
-    /* clear old index */
-    indexFilter.clear();
+    if(index<0 || index>=timeKeys.size())
+        return 0;
 
-    return updateIndexFilter();
+    return timeKeys[index];
 }
 
-bool QDltFile::updateIndexFilter()
+int QDltFile::findTime(qint64 key)
 {
-    QDltMsg msg;
-    QByteArray buf;
-    int index;
+    int low = 0;
+    int high;
 
-    /* update index filter by starting from last found index in list */
+    if(sortMode == DltSortNone)
+        return -1;
 
-    /* get lattest found index in filter list */
-    if(indexFilter.size()>0) {
-        index = indexFilter[indexFilter.size()-1] + 1;
+    /* binary search for the first row with a key not lower than key */
+    if(filterFlag) {
+        high = indexFilter.size();
+        while(low < high) {
+            int mid = (low + high) / 2;
+            if(getTimeKey(indexFilter[mid]) < key)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return (low < indexFilter.size()) ? low : -1;
     }
     else {
-        index = 0;
-    }
-
-    for(int num=index;num<indexAll.size();num++) {
-        buf = getMsg(num);
-        if(!buf.isEmpty()) {
-            msg.setMsg(buf);
-            if(checkFilter(msg)) {
-                indexFilter.append(num);
-            }
+        high = indexTime.size();
+        while(low < high) {
+            int mid = (low + high) / 2;
+            if(getTimeKey(indexTime[mid]) < key)
+                low = mid + 1;
+            else
+                high = mid;
         }
-
+        return (low < indexTime.size()) ? low : -1;
     }
-
-    return true;
 }
 
 bool QDltFile::checkFilter(QDltMsg &msg)
 {  
+    QDltProfilerScope profile("Filter");
     QDltFilter filter;
     bool found = false, foundFilter;
     bool filterActivated = false;
@@ -1651,6 +3164,7 @@ void QDltFile::clearFilterIndex()
 {
     /* clear old index */
     indexFilter.clear();
+    indexFilterSorted = 0;
 
 }
 
@@ -1660,6 +3174,23 @@ void QDltFile::addFilterIndex (int index)
 
 }
 
+void QDltFile::sortFilterIndex()
+{
+    int count = qMin(indexFilterSorted,indexFilter.size());
+
+    indexFilterSorted = indexFilter.size();
+
+    /* the filter index is in file order if sorting is disabled */
+    if(sortMode == DltSortNone || timeKeys.size() != indexAll.size() || count == indexFilter.size())
+        return;
+
+    QDltTimeKeyLess less(timeKeys.constData());
+
+    std::sort(indexFilter.begin() + count,indexFilter.end(),less);
+    if(count > 0 && less(indexFilter[count],indexFilter[count-1]))
+        std::inplace_merge(indexFilter.begin(),indexFilter.begin() + count,indexFilter.end(),less);
+}
+
 QColor QDltFile::checkMarker(QDltMsg &msg)
 {
     QDltFilter filter;
@@ -1717,6 +3248,195 @@ void QDltFile::close()
     infile.close();
 }
 
+bool QDltFile::openMerge(QStringList filenames)
+{
+    closeMerge();
+
+    for(int num=0;num<filenames.size();num++) {
+        QIODevice *file = qDltCreateDevice(filenames[num]);
+
+        /* open the log file read only */
+        if(file->open(QIODevice::ReadOnly)==false) {
+            /* open file failed */
+            qWarning() << "open of file" << filenames[num] << "failed";
+            delete file;
+            closeMerge();
+            return false;
+        }
+
+        mergeFiles.append(file);
+        mergeFileNames.append(filenames[num]);
+    }
+
+    return true;
+}
+
+void QDltFile::closeMerge()
+{
+    mutexQDlt.lock();
+
+    qDeleteAll(mergeFiles);
+    mergeFiles.clear();
+    mergeFileNames.clear();
+
+    /* merged messages are no longer accessible */
+    if(!indexSource.isEmpty()) {
+        indexAll.clear();
+        indexSource.clear();
+        timeKeys.clear();
+        indexTime.clear();
+        clearColumns();
+    }
+
+    mutexQDlt.unlock();
+}
+
+bool QDltFile::isCompressed(const QString &filename)
+{
+    return QDltCompressedFile::isCompressed(filename) || QDltGzipFile::isCompressed(filename);
+}
+
+QStringList QDltFile::getMergeFileNames()
+{
+    return mergeFileNames;
+}
+
+bool QDltFile::rotate(QString _filename)
+{
+    /* check if file is already opened */
+    if(!infile.isOpen()) {
+        qDebug() << "rotate: Infile is not open";
+        return false;
+    }
+
+    QFile *file = new QFile(infile.fileName());
+    if(file->open(QIODevice::ReadOnly)==false) {
+        qWarning() << "open of file" << infile.fileName() << "failed";
+        delete file;
+        return false;
+    }
+
+    mutexQDlt.lock();
+
+    /* the messages of the current file are now found in the new merged file */
+    int source = mergeFiles.size() + 1;
+    bool merged = !indexSource.isEmpty();
+    if(!merged) {
+        indexSource.fill(source,indexAll.size());
+    }
+    else {
+        for(int num=0;num<indexSource.size();num++)
+            if(indexSource[num] == 0)
+                indexSource[num] = source;
+    }
+    mergeFiles.append(file);
+    mergeFileNames.append(infile.fileName());
+
+    /* new messages are read from the new file */
+    QString oldFilename = infile.fileName();
+    infile.close();
+    infile.setFileName(_filename);
+    bool ret = infile.open(QIODevice::ReadOnly);
+
+    if(!ret) {
+        qWarning() << "open of file" << _filename << "failed";
+
+        /* restore the index, new messages are read from the current file again */
+        infile.setFileName(oldFilename);
+        infile.open(QIODevice::ReadOnly);
+        mergeFileNames.removeLast();
+        delete mergeFiles.takeLast();
+        if(!merged) {
+            indexSource.clear();
+        }
+        else {
+            for(int num=0;num<indexSource.size();num++)
+                if(indexSource[num] == source)
+                    indexSource[num] = 0;
+        }
+    }
+
+    mutexQDlt.unlock();
+
+    return ret;
+}
+
+bool QDltFile::createIndexMerge()
+{
+    QDltProfilerScope profile("Merging");
+    QList<QDltMergeSource> sources;
+    std::priority_queue<QDltMergeHead,std::vector<QDltMergeHead>,std::greater<QDltMergeHead> > heads;
+
+    /* check if file is already opened */
+    if(!infile.isOpen()) {
+        qDebug() << "createIndexMerge: Infile is not open";
+        return false;
+    }
+
+    /* index all files in parallel */
+    QDltMergeSource source;
+    source.filename = infile.fileName();
+    source.device = 0;
+    sources.append(source);
+    for(int num=0;num<mergeFileNames.size();num++) {
+        source.filename = mergeFileNames[num];
+        source.device = mergeFiles[num];
+        sources.append(source);
+    }
+    QtConcurrent::blockingMap(sources,qDltIndexMergeSource);
+
+    /* merge the indexes by always taking the earliest next message of all files */
+    mutexQDlt.lock();
+
+    int count = 0;
+    for(int num=0;num<sources.size();num++) {
+        count += sources[num].index.size();
+        if(!sources[num].index.isEmpty()) {
+            QDltMergeHead head = { sources[num].keys[0], num, 0 };
+            heads.push(head);
+        }
+    }
+
+    indexAll.clear();
+    indexSource.clear();
+    indexSource.reserve(count);
+    clearColumns();
+    removedMsgs = 0;
+    while(!heads.empty()) {
+        QDltMergeHead head = heads.top();
+        heads.pop();
+
+        indexAll.append(sources[head.source].index[head.num]);
+        indexSource.append(head.source);
+
+        if(++head.num < sources[head.source].index.size()) {
+            head.key = sources[head.source].keys[head.num];
+            heads.push(head);
+        }
+    }
+
+    /* without merged files all messages are in infile */
+    if(mergeFiles.isEmpty())
+        indexSource.clear();
+
+    mutexQDlt.unlock();
+
+    profile.setItems(indexAll.size());
+    profile.stop();
+
+    qDebug() << "Create merged index finished - "<< indexAll.size() << "messages found in" << sources.size() << "files";
+
+    return createIndexTime();
+}
+
+QIODevice *QDltFile::getMsgFile(int index)
+{
+    if(indexSource.isEmpty() || indexSource[index] == 0)
+        return &infile;
+
+    return mergeFiles[indexSource[index]-1];
+}
+
 QByteArray QDltFile::getMsg(int index)
 {
     QByteArray buf;
@@ -1740,6 +3460,25 @@ QByteArray QDltFile::getMsg(int index)
 
     mutexQDlt.lock();
 
+    if(!indexSource.isEmpty()) {
+        /* the next message in the index is from another file in a merged log,
+           so the size is taken from the standard header */
+        QIODevice *file = getMsgFile(index);
+        file->seek(indexAll[index]);
+        buf = file->read(sizeof(DltStorageHeader) + sizeof(DltStandardHeader));
+        if(buf.size() == (int)(sizeof(DltStorageHeader) + sizeof(DltStandardHeader))) {
+            DltStandardHeader standardheader;
+            memcpy(&standardheader,buf.constData() + sizeof(DltStorageHeader),sizeof(DltStandardHeader));
+            int len = DLT_BETOH_16(standardheader.len);
+            if(len > (int)sizeof(DltStandardHeader))
+                buf.append(file->read(len - sizeof(DltStandardHeader)));
+        }
+
+        mutexQDlt.unlock();
+
+        return buf;
+    }
+
     /* move to file position selected by index */
     infile.seek(indexAll[index]);
 
@@ -1757,6 +3496,233 @@ QByteArray QDltFile::getMsg(int index)
     return buf;
 }
 
+bool QDltFile::copyMsgs(QVector<int> indexes,QIODevice &destination)
+{
+    static const qint64 COPY_BUF_SZ = 4 * 1024 * 1024;
+
+    /* check if file is already opened */
+    if(!infile.isOpen()) {
+        qDebug() << "copyMsgs: Infile is not open";
+        return false;
+    }
+
+    /* the messages are written in the order of the caller, e.g. sorted by time */
+    int num = 0;
+    while(num < indexes.size()) {
+        int first = indexes[num];
+
+        if(first<0 || first>=indexAll.size()) {
+            num++;
+            continue;
+        }
+
+        if(!indexSource.isEmpty()) {
+            /* following messages of a merged log can be in different files */
+            if(destination.write(getMsg(first)) < 0)
+                return false;
+            num++;
+            continue;
+        }
+
+        /* extend the range while the next message follows directly */
+        int last = first;
+        while(num+1 < indexes.size() && indexes[num+1] == last+1) {
+            num++;
+            last++;
+        }
+        num++;
+
+        mutexQDlt.lock();
+        qint64 pos = indexAll[first];
+        qint64 end = (last == indexAll.size()-1) ? infile.size() : (qint64)indexAll[last+1];
+        mutexQDlt.unlock();
+
+        while(pos < end) {
+            QByteArray buf;
+
+            mutexQDlt.lock();
+            if(infile.seek(pos))
+                buf = infile.read(qMin(COPY_BUF_SZ,end-pos));
+            mutexQDlt.unlock();
+
+            if(buf.isEmpty() || destination.write(buf) != buf.size())
+                return false;
+
+            pos += buf.size();
+        }
+    }
+
+    return true;
+}
+
+void QDltFile::clearColumns()
+{
+    for(int column=0;column<DltColumnCount;column++)
+        columns[column].clear();
+}
+
+void QDltFile::updateColumns()
+{
+    QList<QByteArray> bufs;
+    QList<unsigned long> bufPos;
+    QDltHeaderValues values;
+
+    /* Align kbytes, 1MB read at a time */
+    static const int READ_BUF_SZ = 1024 * 1024;
+    static const int COLUMN_HEADER_SZ = sizeof(DltStorageHeader) + sizeof(DltStandardHeader) + sizeof(DltStandardHeaderExtra) + sizeof(DltExtendedHeader);
+
+    int first = columns[DltColumnApid].size();
+    if(first >= indexAll.size() || !infile.isOpen())
+        return;
+
+    QDltProfilerScope profile("Header columns",indexAll.size() - first);
+
+    /* the headers of consecutive messages are close to each other and read in blocks,
+       each file of a merged log has its own block */
+    for(int num=0;num<=mergeFiles.size();num++) {
+        bufs.append(QByteArray());
+        bufPos.append(0);
+    }
+    for(int column=0;column<DltColumnCount;column++)
+        columns[column].reserve(indexAll.size());
+
+    for(int num=first;num<indexAll.size();num++) {
+        unsigned long pos = indexAll[num];
+        int source = indexSource.isEmpty() ? 0 : indexSource[num];
+        QByteArray &buf = bufs[source];
+
+        if(buf.isEmpty() || pos < bufPos[source] || pos + COLUMN_HEADER_SZ > bufPos[source] + buf.size()) {
+            QIODevice *file = getMsgFile(num);
+            file->seek(pos);
+            buf = file->read(READ_BUF_SZ);
+            bufPos[source] = pos;
+        }
+
+        int offset = pos - bufPos[source];
+        if(!qDltHeaderValues(buf.constData() + offset,buf.size() - offset,values))
+            memset(&values,0,sizeof(values));
+
+        columns[DltColumnEcuid].append(values.ecuid);
+        columns[DltColumnApid].append(values.apid);
+        columns[DltColumnCtid].append(values.ctid);
+        columns[DltColumnMessageInfo].append(values.msin);
+        columns[DltColumnPayloadSize].append(values.payloadSize);
+    }
+}
+
+QVector<quint32> QDltFile::getColumn(DltColumnDef column,int begin,int end)
+{
+    if(column < 0 || column >= DltColumnCount)
+        return QVector<quint32>();
+
+    QMutexLocker locker(&mutexQDlt);
+
+    updateColumns();
+
+    const QVector<quint32> &values = columns[column];
+    if(end < 0 || end > values.size())
+        end = values.size();
+    begin = qBound(0,begin,end);
+
+    return values.mid(begin,end - begin);
+}
+
+QVector<int> QDltFile::findMsgs(const QDltIdSet &ids,int begin,int end)
+{
+    QVector<int> found;
+
+    QMutexLocker locker(&mutexQDlt);
+
+    updateColumns();
+
+    int count = columns[DltColumnApid].size();
+    if(end < 0 || end > count)
+        end = count;
+    begin = qBound(0,begin,end);
+
+    if(ids.isEmpty()) {
+        found.reserve(end - begin);
+        for(int num=begin;num<end;num++)
+            found.append(num);
+        return found;
+    }
+
+    const quint32 *apids = columns[DltColumnApid].constData();
+    const quint32 *ctids = columns[DltColumnCtid].constData();
+    for(int num=begin;num<end;num++) {
+        if(ids.contains(apids[num],ctids[num]))
+            found.append(num);
+    }
+
+    return found;
+}
+
+bool QDltFile::getPayloads(const QVector<int> &indexes,QList<QByteArray> &payloads)
+{
+    QByteArray buf;
+    unsigned long bufPos = 0;
+    int bufSource = -1;
+    QDltHeaderValues values;
+    bool ok = true;
+
+    /* Align kbytes, 1MB read at a time */
+    static const int READ_BUF_SZ = 1024 * 1024;
+
+    payloads.clear();
+    payloads.reserve(indexes.size());
+
+    QMutexLocker locker(&mutexQDlt);
+
+    for(int num=0;num<indexes.size();num++) {
+        int index = indexes[num];
+
+        if(index < 0 || index >= indexAll.size()) {
+            payloads.append(QByteArray());
+            ok = false;
+            continue;
+        }
+
+        unsigned long pos = indexAll[index];
+        int source = indexSource.isEmpty() ? 0 : indexSource[index];
+        int offset = 0;
+
+        /* consecutive messages are taken from the block read before */
+        bool found = (source == bufSource && pos >= bufPos && pos < bufPos + buf.size());
+        if(found) {
+            offset = pos - bufPos;
+            found = qDltHeaderValues(buf.constData() + offset,buf.size() - offset,values)
+                    && offset + values.payloadOffset + values.payloadSize <= buf.size();
+        }
+
+        if(!found) {
+            QIODevice *file = getMsgFile(index);
+            file->seek(pos);
+            buf = file->read(READ_BUF_SZ);
+            bufPos = pos;
+            bufSource = source;
+            offset = 0;
+
+            found = qDltHeaderValues(buf.constData(),buf.size(),values);
+            if(found && values.payloadOffset + values.payloadSize > buf.size()) {
+                /* the message is larger than a block */
+                file->seek(pos);
+                buf = file->read(values.payloadOffset + values.payloadSize);
+                found = (buf.size() == values.payloadOffset + values.payloadSize);
+            }
+        }
+
+        if(!found) {
+            payloads.append(QByteArray());
+            ok = false;
+            continue;
+        }
+
+        payloads.append(buf.mid(offset + values.payloadOffset,values.payloadSize));
+    }
+
+    return ok;
+}
+
 bool QDltFile::getMsg(int index,QDltMsg &msg)
 {
     QByteArray data;
@@ -1789,7 +3755,7 @@ QByteArray QDltFile::getMsgFilter(int index)
             /* return empty data buffer */
             return QByteArray();
         }
-        return getMsg(index);
+        return getMsg(getMsgFilterPos(index));
     }
 }
 
@@ -1813,6 +3779,8 @@ int QDltFile::getMsgFilterPos(int index)
             /* return invalid */
             return -1;
         }
+        if(sortMode != DltSortNone && index < indexTime.size())
+            return indexTime[index];
         return index;
     }
 }
@@ -2015,6 +3983,27 @@ bool QDltConnection::parse(QDltMsg &msg)
     /* try to read msg */
     if(!msg.setMsg(data.mid(firstPos),false))
     {
+        /* headers and payload are complete, but the message is invalid;
+           drop it instead of waiting for more data. The sizes are read from
+           the standard header, because setMsg() rejects a length field shorter
+           than the headers before the sizes are known. */
+        if(data.size() - firstPos >= (int)sizeof(DltStandardHeader))
+        {
+            DltStandardHeader standardheader;
+            memcpy(&standardheader,data.constData() + firstPos,sizeof(standardheader));
+
+            int headers = sizeof(DltStandardHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(standardheader.htyp) +
+                          (DLT_IS_HTYP_UEH(standardheader.htyp) ? sizeof(DltExtendedHeader) : 0);
+            int size = qMax((int)DLT_SWAP_16(standardheader.len),headers);
+
+            if(data.size() - firstPos >= size)
+            {
+                bytesError += size;
+                data.remove(0,firstPos + size);
+                return false;
+            }
+        }
+
         /* no complete msg found */
         /* perhaps not completely received */
         /* check valid size */
@@ -24,10 +24,18 @@
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QFile>
 #include <QDateTime>
 #include <QColor>
 #include <QMutex>
+#include <QVector>
+#include <QIODevice>
+#include <QHash>
+#include <QSet>
+#include <QMap>
+#include <QFuture>
+#include <QElapsedTimer>
 #include <time.h>
 
 struct sDltFile;
@@ -82,6 +90,46 @@ public:
     */
     QString toAscii(QByteArray &bytes,bool ascii = false);
 
+    //! Append byte array as text output to a string.
+    /*!
+      Same output as toAscii(), but written directly into a reusable string.
+      \param text the string the output is appended to
+      \param bytes The data to be converted
+      \param ascii true output in ascii, false output in hex
+    */
+    static void appendAscii(QString &text,const QByteArray &bytes,bool ascii = false);
+
+    //! Append an unsigned decimal number to a string.
+    /*!
+      \param text the string the number is appended to
+      \param value the number to be appended
+      \param width minimum number of digits, filled with leading zeros
+    */
+    static void appendNumber(QString &text,qulonglong value,int width = 0);
+
+    //! Append a signed decimal number to a string.
+    /*!
+      \param text the string the number is appended to
+      \param value the number to be appended
+    */
+    static void appendSignedNumber(QString &text,qlonglong value);
+
+    //! Convert an ECU, application or context id into a number.
+    /*!
+      The four characters of the id are packed in the order of the DLT header,
+      so the number can be compared with the ids read from the header.
+      \param id the id, up to four characters
+      \return the id as number
+    */
+    static quint32 idToNumber(const QString &id);
+
+    //! Convert a number created with idToNumber() back into an id.
+    /*!
+      \param number the id as number
+      \return the id
+    */
+    static QString numberToId(quint32 number);
+
     //! The endianness of the message.
     typedef enum { DltEndiannessUnknown = -2, DltEndiannessLittleEndian = 0, DltEndiannessBigEndian = 1 } DltEndiannessDef;
 
@@ -93,6 +141,131 @@ private:
 
 };
 
+//! Performance counters of the processing stages.
+/*!
+  Each counter collects the number of calls, the number of processed items,
+  the total, minimum and maximum time and a histogram of the call durations.
+  The histogram has one bucket for each power of two nanoseconds.
+  The counters are only updated while the profiler is enabled, so the
+  measurement costs nearly nothing when it is not used.
+  This class is multithread save.
+*/
+class QDltProfiler
+{
+public:
+    //! Values of one counter.
+    typedef struct
+    {
+        QString name;
+        qint64 calls;
+        qint64 items;
+        qint64 total;
+        qint64 min;
+        qint64 max;
+        QVector<qint64> histogram;
+    } Counter;
+
+    //! Get the profiler used by the application.
+    static QDltProfiler *instance();
+
+    //! Check if the counters are updated.
+    static bool isEnabled() { return enabled; }
+
+    //! Enable or disable the update of the counters.
+    void setEnabled(bool state);
+
+    //! Add the duration of one call to a counter.
+    /*!
+      \param name the name of the counter, e.g. the processing stage
+      \param nsecs the duration of the call in nanoseconds
+      \param items the number of items processed in the call
+    */
+    void add(const QString &name, qint64 nsecs, qint64 items = 1);
+
+    //! Reset all counters.
+    void clear();
+
+    //! Get a copy of all counters, ordered by name.
+    QList<Counter> getCounters();
+
+    //! Get the time since the counters were reset in milliseconds.
+    qint64 getElapsed();
+
+    //! Get an upper bound of the duration of a fraction of the calls.
+    /*!
+      \param counter the counter
+      \param fraction e.g. 0.99 for the duration of 99 percent of the calls
+      \return duration in nanoseconds
+    */
+    static qint64 getPercentile(const Counter &counter, double fraction);
+
+    //! Get all counters as JSON document.
+    QByteArray toJson();
+
+private:
+    QDltProfiler();
+
+    static bool enabled;
+
+    QMutex mutex;
+    QMap<QString,Counter> counters;
+    QElapsedTimer started;
+};
+
+//! Measure the duration of a scope with the profiler.
+/*!
+  The duration from the construction to the destruction or to stop()
+  is added to the counter, if the profiler is enabled.
+*/
+class QDltProfilerScope
+{
+public:
+    //! Start the measurement.
+    /*!
+      \param name the name of the counter, a string literal
+      \param items the number of items processed in the scope
+    */
+    QDltProfilerScope(const char *name, qint64 items = 1)
+        : literal(name), items(items), running(QDltProfiler::isEnabled())
+    {
+        if(running)
+            timer.start();
+    }
+
+    //! Start the measurement.
+    /*!
+      \param name the name of the counter
+      \param items the number of items processed in the scope
+    */
+    QDltProfilerScope(const QString &name, qint64 items = 1)
+        : literal(0), name(name), items(items), running(QDltProfiler::isEnabled())
+    {
+        if(running)
+            timer.start();
+    }
+
+    ~QDltProfilerScope() { stop(); }
+
+    //! Set the number of items processed in the scope.
+    void setItems(qint64 count) { items = count; }
+
+    //! Stop the measurement and add the duration to the counter.
+    void stop()
+    {
+        if(!running)
+            return;
+        running = false;
+        QDltProfiler::instance()->add(literal ? QString(QLatin1String(literal)) : name,timer.nsecsElapsed(),items);
+    }
+
+private:
+    const char *literal;
+    QString name;
+    qint64 items;
+    bool running;
+    QElapsedTimer timer;
+};
+
 //! One argument of a DLT message.
 /*!
   This class contains one argument of a DLT message.
@@ -240,6 +413,13 @@ public:
     */
     QString toString(bool binary = false);
 
+    //! Append argument content to a string.
+    /*!
+      \param text the string the argument is appended to
+      \param binary if true write parameter as  Hex, if false translate into text
+    */
+    void toString(QString &text,bool binary = false);
+
     //! Clears all variables of the class.
     void clear();
 
@@ -660,12 +840,25 @@ public:
     */
     QString toStringHeader();
 
+    //! Append Header to a string.
+    /*!
+      Use this function with a reused string to avoid allocations when formatting many messages.
+      \param text the string the header is appended to
+    */
+    void toStringHeader(QString &text);
+
     //! Print Payload content into a string.
     /*!
       \return The payload string.
     */
     QString toStringPayload();
 
+    //! Append Payload content to a string.
+    /*!
+      \param text the string the payload is appended to
+    */
+    void toStringPayload(QString &text);
+
 
 protected:
 
@@ -755,6 +948,256 @@ protected:
 private:
 };
 
+//! A set of application and context ids used to select messages with QDltFile::findMsgs().
+/*!
+  The ids are compared as numbers created with QDlt::idToNumber(),
+  so no string is created for the messages checked.
+*/
+class QDltIdSet
+{
+public:
+    //! Select all messages of an application.
+    /*!
+      \param apid the application id
+    */
+    void addApid(const QString &apid) { apids.insert(QDlt::idToNumber(apid)); }
+
+    //! Select the messages of one context of an application.
+    /*!
+      \param apid the application id
+      \param ctid the context id
+    */
+    void addContext(const QString &apid, const QString &ctid) { contexts.insert(((quint64)QDlt::idToNumber(apid) << 32) | QDlt::idToNumber(ctid)); }
+
+    //! Check if no id was added, an empty set selects all messages.
+    bool isEmpty() const { return apids.isEmpty() && contexts.isEmpty(); }
+
+    //! Check if a message with the ids is selected.
+    /*!
+      \param apid the application id created with QDlt::idToNumber()
+      \param ctid the context id created with QDlt::idToNumber()
+      \return true if the message is selected
+    */
+    bool contains(quint32 apid, quint32 ctid) const { return apids.contains(apid) || contexts.contains(((quint64)apid << 32) | ctid); }
+
+private:
+    QSet<quint32> apids;
+    QSet<quint64> contexts;
+};
+
+class QDltFile;
+struct z_stream_s;
+
+//! Read access to a compressed DLT log file.
+/*!
+  A compressed DLT log file stores the messages in blocks which are compressed
+  independently. A footer contains the position of each block and the message index.
+  The device provides the uncompressed content of the log file with random access,
+  only the blocks containing the requested data are decompressed. Recently used blocks
+  are kept in a cache. When the blocks are read in order, the next blocks are
+  decompressed in parallel in advance.
+  The positions of the message index are positions in the uncompressed content.
+  This class is not multithread save, as QFile.
+*/
+class QDltCompressedFile : public QIODevice
+{
+public:
+    //! The constructor.
+    /*!
+      \param name the name of the compressed DLT log file
+    */
+    QDltCompressedFile(const QString &name = QString());
+
+    //! The destructor.
+    ~QDltCompressedFile();
+
+    //! Check if a file is a compressed DLT log file.
+    /*!
+      \param filename the name of the file
+      \return true if the file is a compressed DLT log file
+    */
+    static bool isCompressed(const QString &filename);
+
+    //! Write all messages of a DLT log file into a compressed DLT log file.
+    /*!
+      The messages are written in the order of the index of the DLT log file.
+      The blocks are compressed in parallel.
+      \param filename the name of the compressed DLT log file to be created
+      \param file the DLT log file with the messages
+      \return true if the file was written, false if there was an error.
+    */
+    static bool create(const QString &filename, QDltFile &file);
+
+    //! Set the name of the compressed DLT log file.
+    void setFileName(const QString &name);
+
+    //! Get the name of the compressed DLT log file.
+    QString fileName() const;
+
+    //! Open the compressed DLT log file, only read access is supported.
+    bool open(OpenMode mode);
+
+    //! Close the compressed DLT log file.
+    void close();
+
+    //! The device supports random access.
+    bool isSequential() const;
+
+    //! Size of the uncompressed content.
+    qint64 size() const;
+
+    //! Set the position in the uncompressed content.
+    bool seek(qint64 pos);
+
+    //! Set the number of decompressed blocks kept in the cache.
+    void setCacheSize(int blocks);
+
+    //! Get the message index stored in the footer.
+    /*!
+      \return Positions of all DLT messages in the uncompressed content.
+    */
+    QList<unsigned long> getIndex();
+
+protected:
+    qint64 readData(char *data, qint64 maxSize);
+    qint64 writeData(const char *data, qint64 maxSize);
+
+private:
+    typedef struct
+    {
+        qint64 filePos;
+        quint32 fileSize;
+        qint64 pos;
+        quint32 size;
+    } Block;
+
+    int findBlock(qint64 pos) const;
+    QByteArray getBlock(int num);
+    void prefetch(int num);
+    void clearCache();
+
+    QFile file;
+    QVector<Block> blocks;
+    QList<unsigned long> index;
+    qint64 position;
+    qint64 dataSize;
+
+    QHash<int,QByteArray> cache;
+    QList<int> cacheOrder;
+    int cacheSize;
+    QMap<int,QFuture<QByteArray> > pending;
+    int lastBlock;
+};
+
+//! Read access to a gzip compressed DLT log file.
+/*!
+  The content is decompressed while it is read. While the file is read the first time,
+  seek points are stored in distances of a few megabytes of uncompressed data.
+  A seek point contains the state of the decompression, so reading can be restarted
+  near any position instead of from the start of the file. The last decompressed
+  chunk is kept, so messages read in order are decompressed only once.
+  Files with several gzip members, e.g. concatenated files, are supported.
+  This class is not multithread save, as QFile.
+*/
+class QDltGzipFile : public QIODevice
+{
+public:
+    //! The constructor.
+    /*!
+      \param name the name of the gzip compressed DLT log file
+    */
+    QDltGzipFile(const QString &name = QString());
+
+    //! The destructor.
+    ~QDltGzipFile();
+
+    //! Check if a file is gzip compressed.
+    /*!
+      \param filename the name of the file
+      \return true if the file starts with the gzip magic
+    */
+    static bool isCompressed(const QString &filename);
+
+    //! Set the name of the gzip compressed DLT log file.
+    void setFileName(const QString &name);
+
+    //! Get the name of the gzip compressed DLT log file.
+    QString fileName() const;
+
+    //! Open the gzip compressed DLT log file, only read access is supported.
+    bool open(OpenMode mode);
+
+    //! Close the gzip compressed DLT log file.
+    void close();
+
+    //! The device supports random access.
+    bool isSequential() const;
+
+    //! Size of the uncompressed content.
+    /*!
+      The size is only known when the file was read up to the end once,
+      before that the size of the content decompressed so far is returned.
+    */
+    qint64 size() const;
+
+    //! Set the position in the uncompressed content.
+    bool seek(qint64 pos);
+
+    //! Set the distance of the seek points in the uncompressed content.
+    /*!
+      Each seek point keeps 32kB of uncompressed data. A smaller distance allows
+      faster random access, but needs more memory.
+      \param distance distance in bytes
+    */
+    void setCheckpointDistance(qint64 distance);
+
+    //! Take over the seek points found by another device reading the same file.
+    /*!
+      Used when the file was indexed by another device, e.g. in a worker thread.
+      \param other the device which read the file
+    */
+    void copyCheckpoints(const QDltGzipFile &other);
+
+protected:
+    qint64 readData(char *data, qint64 maxSize);
+    qint64 writeData(const char *data, qint64 maxSize);
+
+private:
+    typedef struct
+    {
+        qint64 pos;
+        qint64 filePos;
+        int bits;
+        bool member;
+        QByteArray window;
+    } Checkpoint;
+
+    int findCheckpoint(qint64 pos) const;
+    bool restart(const Checkpoint &checkpoint);
+    bool inflateChunk();
+    void addCheckpoint(qint64 pos, bool member);
+
+    QFile file;
+    struct z_stream_s *stream;
+    bool streamValid;
+    QByteArray input;
+    qint64 inputEnd;
+    int trailer;
+    bool raw;
+    bool nextMember;
+    bool memberStart;
+    bool finished;
+
+    QList<Checkpoint> checkpoints;
+    qint64 checkpointDistance;
+    QByteArray history;
+    QByteArray chunk;
+    qint64 chunkPos;
+    qint64 position;
+    qint64 dataSize;
+    bool complete;
+};
+
 //! Access to a DLT log file.
 /*!
   This class provide access to DLT log file.
@@ -763,6 +1206,9 @@ private:
 class QDltFile : public QDlt
 {
 public:
+    //! The order in which the messages are presented by getMsgFilter() and getMsgFilterPos().
+    typedef enum { DltSortNone = 0, DltSortStorageTime, DltSortTimestamp } DltSortDef;
+
     //! The constructor.
     /*!
     */
@@ -786,6 +1232,29 @@ public:
     */
     int sizeFilter();
 
+    //! Remove the oldest DLT messages from the index.
+    /*!
+      Used in live mode to keep the memory bounded during long captures.
+      The messages stay in the DLT log file, only the entries of all indexes are removed.
+      The numbers of the remaining messages are reduced by count.
+      \param count the number of messages to be removed from the start of the index
+    */
+    void removeMsgs(int count);
+
+    //! Get the number of DLT messages removed from the index with removeMsgs().
+    /*!
+      \return the number of removed messages since the index was created.
+    */
+    int getRemovedMsgs();
+
+    //! Get the number of a DLT message shown to the user.
+    /*!
+      The number of a message does not change when messages are removed with removeMsgs().
+      \param index position of the DLT message in the log file
+      \return the number shown in the table, the exports and the plugins.
+    */
+    int getMsgNumber(int index);
+
     //! Open a DLT log file.
     /*!
       The DLT log file is parsed and a index of all DLT log messages is created.
@@ -799,12 +1268,77 @@ public:
     */
     void close();
 
+    //! Open DLT log files which are merged with the currently opened DLT log file.
+    /*!
+      The files are opened read only, no data is copied.
+      Compressed DLT log files and gzip compressed DLT log files are read directly.
+      The merged index is created with createIndexMerge().
+      \param filenames The DLT filenames.
+      \return true if all files are successfully opened, false if an error occured.
+    */
+    bool openMerge(QStringList filenames);
+
+    //! Check if a file is a compressed DLT log file which can only be read with openMerge().
+    /*!
+      \param filename the name of the file
+      \return true if the file is a compressed DLT log file or gzip compressed
+    */
+    static bool isCompressed(const QString &filename);
+
+    //! Close all merged DLT log files.
+    /*!
+      The index has to be recreated afterwards.
+    */
+    void closeMerge();
+
+    //! Get the names of the merged DLT log files.
+    /*!
+      \return the list of merged file names, empty if no files are merged.
+    */
+    QStringList getMergeFileNames();
+
+    //! Continue with a new DLT log file, the current file becomes a merged file.
+    /*!
+      Used to split a long capture into several files. The messages of the current
+      file keep their place in the index, new messages are read from the new file
+      with updateIndex(). No index has to be recreated.
+      \param _filename The DLT filename of the new file, the file must exist.
+      \return true if the new file was opened, false if an error occured and the index was not changed.
+    */
+    bool rotate(QString _filename);
+
+    //! Create the merged index of the currently opened and all merged DLT log files.
+    /*!
+      Each file is indexed in parallel, the indexes are merged by storage time.
+      Messages of each file keep their order in the file.
+      \return true if the operation was successful, false if an error occured.
+    */
+    bool createIndexMerge();
+
     //! Sets the internal index of all DLT messages.
     /*!
       \param New index list of all DLT messages
     */
     void setDltIndex(QList<unsigned long> &_indexAll);
 
+    //! Append positions of new DLT messages to the internal index.
+    /*!
+      Used when the caller already knows the positions of the messages added
+      to the end of the DLT log file, so the file does not need to be scanned again.
+      \param _index positions of the new DLT messages in the log file
+    */
+    void appendDltIndex(QList<unsigned long> &_index);
+
+    //! Check if a buffer starts with a valid DLT message including storage header.
+    /*!
+      The storage header pattern, the protocol version and the length of the standard header are checked.
+      \param data the buffer starting with the storage header
+      \param size the number of bytes available in the buffer
+      \return the size of the DLT message including storage header, 0 if more data is needed,
+      -1 if the data is not a valid DLT message.
+    */
+    static int checkMsg(const char *data,int size);
+
     //! Clears the internal index of all DLT messages.
     /*!
     */
@@ -834,6 +1368,53 @@ public:
     */
     bool updateIndexFilter();
 
+    //! Set the order in which the messages are presented.
+    /*!
+      If sorting is enabled a time index of all messages is created.
+      The rows returned by getMsgFilter() and getMsgFilterPos() are then ordered by time,
+      messages with the same time keep their order in the file.
+      \param mode DltSortStorageTime sorts by the storage header time,
+      DltSortTimestamp by the ECU timestamp, DltSortNone presents the file order.
+    */
+    void setSortMode(DltSortDef mode);
+
+    //! Get the order in which the messages are presented.
+    /*!
+      \return the current sort mode.
+    */
+    DltSortDef getSortMode();
+
+    //! Create the time index of all DLT messages of the currently opened DLT log file.
+    /*!
+      The sort keys of all messages are read and sorted in parallel.
+      \return true if the operation was successful, false if an error occured.
+    */
+    bool createIndexTime();
+
+    //! Update the time index by adding the DLT messages added to the index since the last call.
+    /*!
+      This is called automatically by updateIndex() and setDltIndex() if sorting is enabled.
+      \return true if the operation was successful, false if an error occured.
+    */
+    bool updateIndexTime();
+
+    //! Get the sort key of a DLT message.
+    /*!
+      The key is the storage time in microseconds or the timestamp in 0.1 milliseconds,
+      depending on the sort mode. Messages without timestamp get the key of the message before.
+      \param index position of the DLT message in the log file
+      \return the sort key, 0 if sorting is disabled or the index is out of range.
+    */
+    qint64 getTimeKey(int index);
+
+    //! Find the first row presented at or after a time.
+    /*!
+      The search is a binary search in the time index and respects the filter.
+      \param key the time in the unit of getTimeKey()
+      \return the row usable with getMsgFilter(), -1 if sorting is disabled or no message was found.
+    */
+    int findTime(qint64 key);
+
     //! Get one message of the DLT log file.
     /*!
       This function retrieves on DLT message of the log file
@@ -850,6 +1431,52 @@ public:
     */
     QByteArray getMsg(int index);
 
+    //! Copy DLT messages of the DLT log file to another file.
+    /*!
+      The messages are written in the order of the indexes, e.g. the order of the view.
+      Indexes following each other in the log file are copied as one range with large reads.
+      \param indexes positions of the DLT messages in the log file
+      \param destination device the messages are written to
+      \return true if the copy was successful, false if there was an error.
+    */
+    bool copyMsgs(QVector<int> indexes,QIODevice &destination);
+
+    //! The header columns provided by getColumn().
+    typedef enum { DltColumnEcuid = 0, DltColumnApid, DltColumnCtid, DltColumnMessageInfo, DltColumnPayloadSize, DltColumnCount } DltColumnDef;
+
+    //! Get the values of one header column for a range of DLT messages.
+    /*!
+      The header columns are read from the headers of all messages when a column is
+      requested the first time, and extended with the messages added to the index later.
+      No message is parsed. The ids are numbers created with QDlt::idToNumber(), the
+      message info is the MSIN byte of the extended header, 0 if there is no extended header.
+      \param column the column
+      \param begin number of the first DLT message
+      \param end number behind the last DLT message, -1 for all messages
+      \return the values of the column, one for each message.
+    */
+    QVector<quint32> getColumn(DltColumnDef column,int begin = 0,int end = -1);
+
+    //! Find the DLT messages of a set of applications and contexts.
+    /*!
+      Only the header columns are compared, no message is read or parsed.
+      \param ids the applications and contexts to be selected, an empty set selects all messages
+      \param begin number of the first DLT message to be checked
+      \param end number behind the last DLT message to be checked, -1 for all messages
+      \return the numbers of the matching messages in ascending order.
+    */
+    QVector<int> findMsgs(const QDltIdSet &ids,int begin = 0,int end = -1);
+
+    //! Get the payloads of several DLT messages.
+    /*!
+      Messages close to each other in the log file are read with one large read,
+      only the headers needed to find the payload are evaluated.
+      \param indexes positions of the DLT messages in the log file
+      \param payloads the payload of each message, empty if the message could not be read
+      \return true if all payloads were read, false if there was an error.
+    */
+    bool getPayloads(const QVector<int> &indexes,QList<QByteArray> &payloads);
+
     //! Get one DLT message of the filtered DLT log file selected by index
     /*!
       \param index position of the DLT message in the log file up to the number of DLT messages in the file
@@ -914,10 +1541,19 @@ public:
 
     //! Add filter to the filter index.
     /*!
+      The index is appended, sortFilterIndex() must be called after adding messages.
       \param index The position of the message in the allIndex to be added
     */
     void addFilterIndex (int index);
 
+    //! Order the filter indexes added since the last call by time.
+    /*!
+      The new indexes are sorted and merged once into the filter index,
+      so adding many messages with interleaved times is not quadratic.
+      Nothing is done if sorting is disabled.
+    */
+    void sortFilterIndex();
+
     //! Check if message will be marked.
     /*!
       Colours used are:
@@ -942,6 +1578,24 @@ private:
     //! DLT log file.
     QFile infile;
 
+    //! DLT log files merged with infile.
+    /*!
+      Compressed DLT log files are accessed by QDltCompressedFile.
+    */
+    QList<QIODevice*> mergeFiles;
+
+    //! Names of the DLT log files merged with infile.
+    QStringList mergeFileNames;
+
+    //! Source of each DLT message in indexAll.
+    /*!
+      0 is infile, n is mergeFiles[n-1]. Empty if all messages are in infile.
+    */
+    QVector<int> indexSource;
+
+    //! Get the file containing a message.
+    QIODevice *getMsgFile(int index);
+
     //! Index of all DLT messages.
     /*!
       Index contains positions of beginning of DLT messages in DLT log file.
@@ -951,9 +1605,37 @@ private:
     //! Index of all DLT messages matching filter.
     /*!
       Index contains positions of DLT messages in indexAll.
+      If sorting is enabled the positions are ordered by time.
     */
     QList<unsigned long> indexFilter;
 
+    //! Number of indexes at the start of indexFilter which are already in order.
+    int indexFilterSorted;
+
+    //! Order in which the messages are presented.
+    DltSortDef sortMode;
+
+    //! Sort keys of all DLT messages in the order of indexAll.
+    QVector<qint64> timeKeys;
+
+    //! Index of all DLT messages ordered by time.
+    /*!
+      Index contains positions of DLT messages in indexAll.
+    */
+    QVector<int> indexTime;
+
+    //! Number of DLT messages removed from the start of the index.
+    int removedMsgs;
+    //! Header columns of all DLT messages in the order of indexAll.
+    /*!
+      Empty until a column is requested with getColumn() or findMsgs().
+    */
+    QVector<quint32> columns[DltColumnCount];
+    //! Read the header columns of the messages added to indexAll, mutexQDlt must be locked.
+    void updateColumns();
+    //! Drop the header columns.
+    void clearColumns();
+
     //! List of positive filters.
     QList<QDltFilter> pfilter;
 
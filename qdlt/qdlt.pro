@@ -18,11 +18,31 @@ CONFIG                 += warn_on qt thread
 QT                     += network
 QT                     += gui
 
+# coverage instrumentation of the libFuzzer harnesses in tests/fuzz
+fuzzer {
+    QMAKE_CFLAGS       += -fsanitize=fuzzer-no-link,address
+    QMAKE_CXXFLAGS     += -fsanitize=fuzzer-no-link,address
+    QMAKE_LFLAGS       += -fsanitize=address
+}
+
 OBJECTS_DIR             = build/obj
 MOC_DIR                 = build/moc
 
 INCLUDEPATH = ../qextserialport/src ../src
 
+# gzip compressed log files are decompressed with zlib 1.2.5 or later.
+# On Windows zlib is found in ZLIB_DIR, set with qmake ZLIB_DIR=... or in the
+# environment, with the headers in ZLIB_DIR/include and the library in ZLIB_DIR/lib.
+# ZLIB_LIBS can be set for a library with another name.
+unix:LIBS              += -lz
+win32 {
+    isEmpty(ZLIB_DIR):ZLIB_DIR = $$(ZLIB_DIR)
+    isEmpty(ZLIB_DIR):ZLIB_DIR = C:/zlib
+    isEmpty(ZLIB_LIBS):ZLIB_LIBS = -lz
+    INCLUDEPATH        += $$ZLIB_DIR/include
+    LIBS               += -L$$ZLIB_DIR/lib $$ZLIB_LIBS
+}
+
 SOURCES +=  dlt_common.c \
             qdlt.cpp
 
@@ -33,6 +33,7 @@ copy %BUILD_DIR%\plugins\dltviewerplugin.dll %TARGET_DIR%\plugins
 copy %BUILD_DIR%\plugins\nonverboseplugin.dll %TARGET_DIR%\plugins
 copy %BUILD_DIR%\plugins\filetransferplugin.dll %TARGET_DIR%\plugins
 copy %BUILD_DIR%\plugins\dltsystemviewerplugin.dll %TARGET_DIR%\plugins
+copy %BUILD_DIR%\plugins\signalplugin.dll %TARGET_DIR%\plugins
 
 copy %SOURCE_DIR%\ReleaseNotes_Viewer.txt %TARGET_DIR%
 
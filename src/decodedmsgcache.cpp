@@ -0,0 +1,105 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file decodedmsgcache.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QMutexLocker>
+
+#include "decodedmsgcache.h"
+#include "project.h"
+
+/* Default size of the cache. */
+static const int DECODED_MSG_CACHE_SZ = 64 * 1024 * 1024;
+
+/* Estimated memory used by one decoded argument besides its data. */
+static const int DECODED_MSG_ARGUMENT_SZ = 64;
+
+DecodedMsgCache *DecodedMsgCache::instance()
+{
+    static DecodedMsgCache cache;
+
+    return &cache;
+}
+
+DecodedMsgCache::DecodedMsgCache()
+{
+    entries.setMaxCost(DECODED_MSG_CACHE_SZ);
+    generation = PluginItem::getGeneration();
+}
+
+void DecodedMsgCache::checkGeneration()
+{
+    /* a plugin was enabled, disabled or reconfigured */
+    if(generation != PluginItem::getGeneration())
+    {
+        entries.clear();
+        generation = PluginItem::getGeneration();
+    }
+}
+
+bool DecodedMsgCache::lookup(int index, int triggeredByUser, QDltMsg &msg, bool &decoded)
+{
+    QMutexLocker locker(&mutex);
+
+    /* the profiler counts the lookups as calls and the hits as items */
+    QDltProfilerScope profile("Decoded cache lookup");
+
+    checkGeneration();
+
+    Entry *entry = entries.object(qMakePair(index,triggeredByUser));
+    if(!entry || entry->payload != msg.getPayload() || entry->header != msg.getHeader())
+    {
+        profile.setItems(0);
+        return false;
+    }
+
+    msg = entry->msg;
+    decoded = entry->decoded;
+
+    return true;
+}
+
+void DecodedMsgCache::insert(int index, int triggeredByUser, const QByteArray &header, const QByteArray &payload, const QDltMsg &msg, bool decoded)
+{
+    QMutexLocker locker(&mutex);
+
+    checkGeneration();
+
+    Entry *entry = new Entry;
+    entry->header = header;
+    entry->payload = payload;
+    entry->msg = msg;
+    entry->decoded = decoded;
+
+    /* the undecoded data and the decoded message */
+    int cost = 2 * (header.size() + payload.size()) + entry->msg.sizeArguments() * DECODED_MSG_ARGUMENT_SZ;
+    entries.insert(qMakePair(index,triggeredByUser),entry,cost);
+}
+
+void DecodedMsgCache::clear()
+{
+    QMutexLocker locker(&mutex);
+
+    entries.clear();
+}
+
+void DecodedMsgCache::setMaxSize(int bytes)
+{
+    QMutexLocker locker(&mutex);
+
+    entries.setMaxCost(bytes);
+}
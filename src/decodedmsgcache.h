@@ -0,0 +1,97 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file decodedmsgcache.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef DECODEDMSGCACHE_H
+#define DECODEDMSGCACHE_H
+
+#include <QCache>
+#include <QMutex>
+#include <QPair>
+
+#include "qdlt.h"
+
+//! Cache of messages decoded by the decoder plugins.
+/*!
+  The table view, selection, search, export and filtering decode the same
+  messages again and again. The decoded messages are kept in a size bounded
+  cache shared by all of them, keyed by the message number and by the
+  triggeredByUser flag passed to the plugins, as plugins may decode a message
+  differently when the user triggered it.
+
+  An entry is only used, if the plugin configuration did not change since the
+  message was decoded and the undecoded header and payload are still the same,
+  so loading another file or removing messages in live mode does not return
+  the message of another file position.
+*/
+class DecodedMsgCache
+{
+public:
+    //! The cache shared by the whole viewer.
+    static DecodedMsgCache *instance();
+
+    //! Get a decoded message.
+    /*!
+      \param index the number of the message in the log file
+      \param triggeredByUser the value passed to the plugins when the message was decoded
+      \param msg the undecoded message, replaced by the decoded message if found
+      \param decoded set to true if a plugin decoded the message
+      \return true if the message was found
+    */
+    bool lookup(int index, int triggeredByUser, QDltMsg &msg, bool &decoded);
+
+    //! Store a decoded message.
+    /*!
+      \param index the number of the message in the log file
+      \param triggeredByUser the value passed to the plugins when the message was decoded
+      \param header the header of the undecoded message
+      \param payload the payload of the undecoded message
+      \param msg the decoded message
+      \param decoded true if a plugin decoded the message
+    */
+    void insert(int index, int triggeredByUser, const QByteArray &header, const QByteArray &payload, const QDltMsg &msg, bool decoded);
+
+    //! Drop all messages.
+    void clear();
+
+    //! Set the maximum size of the cache.
+    /*!
+      \param bytes the maximum size in bytes
+    */
+    void setMaxSize(int bytes);
+
+private:
+    DecodedMsgCache();
+
+    typedef struct
+    {
+        QByteArray header;
+        QByteArray payload;
+        QDltMsg msg;
+        bool decoded;
+    } Entry;
+
+    void checkGeneration();
+
+    QMutex mutex;
+    /* message number and triggeredByUser */
+    QCache<QPair<int,int>,Entry> entries;
+    int generation;
+};
+
+#endif // DECODEDMSGCACHE_H
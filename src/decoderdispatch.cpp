@@ -0,0 +1,232 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file decoderdispatch.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "decoderdispatch.h"
+#include "decodedmsgcache.h"
+
+DecoderDispatch::DecoderDispatch()
+{
+    linear = false;
+    unconditional = 0;
+    source = 0;
+    generation = -1;
+}
+
+void DecoderDispatch::setPlugins(const QList<PluginItem*> &_plugins)
+{
+    plugins = _plugins;
+    linear = plugins.size() > 64;
+    unconditional = 0;
+    apidClaims.clear();
+    contextClaims.clear();
+    messageIdClaims.clear();
+    typeClaims.clear();
+    source = 0;
+
+    if(linear)
+        return;
+
+    for(int num=0;num<plugins.size();num++)
+    {
+        PluginItem *item = plugins[num];
+        quint64 bit = Q_UINT64_C(1) << num;
+
+        /* plugins without claims are asked for each message */
+        if(!item->plugindecoderbatchinterface)
+        {
+            unconditional |= bit;
+            continue;
+        }
+
+        QList<QDltDecoderClaim> claims = item->getClaims();
+        for(int claim=0;claim<claims.size();claim++)
+        {
+            const QDltDecoderClaim &c = claims[claim];
+            switch(c.claimType)
+            {
+            case QDltDecoderClaim::ClaimAll:
+                unconditional |= bit;
+                break;
+            case QDltDecoderClaim::ClaimContext:
+                if(c.ctid.isEmpty())
+                    apidClaims[c.apid] |= bit;
+                else
+                    contextClaims[qMakePair(c.apid,c.ctid)] |= bit;
+                break;
+            case QDltDecoderClaim::ClaimMessageId:
+                messageIdClaims[c.messageId] |= bit;
+                break;
+            case QDltDecoderClaim::ClaimMessageType:
+                typeClaims[c.messageType] |= bit;
+                break;
+            }
+        }
+    }
+}
+
+void DecoderDispatch::setPlugins(QTreeWidget *pluginWidget)
+{
+    if(source == pluginWidget && generation == PluginItem::getGeneration())
+        return;
+
+    QList<PluginItem*> list;
+    for(int num = 0; num < pluginWidget->topLevelItemCount(); num++)
+    {
+        PluginItem *item = (PluginItem*)pluginWidget->topLevelItem(num);
+
+        if(item->getMode() != item->ModeDisable && item->plugindecoderinterface)
+            list.append(item);
+    }
+
+    setPlugins(list);
+    source = pluginWidget;
+    generation = PluginItem::getGeneration();
+}
+
+quint64 DecoderDispatch::getCandidates(QDltMsg &msg)
+{
+    quint64 candidates = unconditional;
+
+    if(!apidClaims.isEmpty() || !contextClaims.isEmpty())
+    {
+        QString apid = msg.getApid();
+        if(!apidClaims.isEmpty())
+            candidates |= apidClaims.value(apid);
+        if(!contextClaims.isEmpty())
+            candidates |= contextClaims.value(qMakePair(apid,msg.getCtid()));
+    }
+
+    if(!messageIdClaims.isEmpty() && msg.getMode() == QDltMsg::DltModeNonVerbose)
+        candidates |= messageIdClaims.value(msg.getMessageId());
+
+    if(!typeClaims.isEmpty())
+        candidates |= typeClaims.value(msg.getType());
+
+    return candidates;
+}
+
+bool DecoderDispatch::decodeMsg(QDltMsg &msg, int triggeredByUser, int index)
+{
+    if(plugins.isEmpty())
+        return false;
+
+    if(index < 0)
+        return decodeCandidates(msg,triggeredByUser);
+
+    DecodedMsgCache *cache = DecodedMsgCache::instance();
+    bool decoded;
+    if(cache->lookup(index,triggeredByUser,msg,decoded))
+        return decoded;
+
+    QByteArray header = msg.getHeader();
+    QByteArray payload = msg.getPayload();
+    decoded = decodeCandidates(msg,triggeredByUser);
+    cache->insert(index,triggeredByUser,header,payload,msg,decoded);
+
+    return decoded;
+}
+
+void DecoderDispatch::decodeMsgs(QList<QDltMsg*> &msgs, int triggeredByUser, const QVector<int> &indexes)
+{
+    if(plugins.isEmpty() || msgs.isEmpty())
+        return;
+
+    if(indexes.size() != msgs.size())
+    {
+        decodeCandidates(msgs,triggeredByUser);
+        return;
+    }
+
+    /* only the messages not found in the cache are decoded */
+    DecodedMsgCache *cache = DecodedMsgCache::instance();
+    QList<QDltMsg*> missing;
+    QVector<int> positions;
+    QList<QByteArray> headers, payloads;
+    bool decoded;
+
+    for(int num=0;num<msgs.size();num++)
+    {
+        if(!cache->lookup(indexes[num],triggeredByUser,*msgs[num],decoded))
+        {
+            missing.append(msgs[num]);
+            positions.append(num);
+            headers.append(msgs[num]->getHeader());
+            payloads.append(msgs[num]->getPayload());
+        }
+    }
+
+    if(missing.isEmpty())
+        return;
+
+    QVector<bool> done = decodeCandidates(missing,triggeredByUser);
+
+    for(int num=0;num<missing.size();num++)
+        cache->insert(indexes[positions[num]],triggeredByUser,headers[num],payloads[num],*missing[num],done[num]);
+}
+
+bool DecoderDispatch::decodeCandidates(QDltMsg &msg, int triggeredByUser)
+{
+    quint64 candidates = linear ? 0 : getCandidates(msg);
+
+    for(int num=0;num<plugins.size();num++)
+    {
+        if(isCandidate(candidates,num) && plugins[num]->decodeMsg(msg,triggeredByUser))
+            return true;
+    }
+
+    return false;
+}
+
+QVector<bool> DecoderDispatch::decodeCandidates(QList<QDltMsg*> &msgs, int triggeredByUser)
+{
+    QVector<quint64> candidates(msgs.size());
+    QVector<bool> done(msgs.size(),false);
+
+    for(int num=0;num<msgs.size();num++)
+        candidates[num] = linear ? 0 : getCandidates(*msgs[num]);
+
+    for(int plugin=0;plugin<plugins.size();plugin++)
+    {
+        QList<QDltMsg*> batch;
+        QVector<int> positions;
+
+        for(int num=0;num<msgs.size();num++)
+        {
+            if(!done[num] && isCandidate(candidates[num],plugin))
+            {
+                batch.append(msgs[num]);
+                positions.append(num);
+            }
+        }
+
+        if(batch.isEmpty())
+            continue;
+
+        QVector<bool> decoded(batch.size(),false);
+        plugins[plugin]->decodeMsgs(batch,decoded,triggeredByUser);
+
+        for(int num=0;num<positions.size();num++)
+        {
+            if(decoded[num])
+                done[positions[num]] = true;
+        }
+    }
+
+    return done;
+}
@@ -0,0 +1,101 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file decoderdispatch.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef DECODERDISPATCH_H
+#define DECODERDISPATCH_H
+
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QTreeWidget>
+
+#include "qdlt.h"
+#include "project.h"
+
+//! Pass messages only to the decoder plugins responsible for them.
+/*!
+  The claims of the decoder plugins are collected in hash tables, which map
+  application and context ids, non-verbose message ids and message types to the
+  set of plugins claiming them. For each message only these plugins and the
+  plugins without claims are called, in the order of the plugin list.
+  The first plugin decoding a message ends the search, as before.
+*/
+class DecoderDispatch
+{
+public:
+    DecoderDispatch();
+
+    //! Build the dispatch table for a list of decoder plugins.
+    /*!
+      \param plugins the enabled decoder plugins in the order they are called
+    */
+    void setPlugins(const QList<PluginItem*> &plugins);
+
+    //! Build the dispatch table for all enabled decoder plugins of the project.
+    /*!
+      The table is only rebuilt if a plugin was changed since the last call.
+      \param pluginWidget the plugin list of the project
+    */
+    void setPlugins(QTreeWidget *pluginWidget);
+
+    //! True if no decoder plugin is enabled.
+    bool isEmpty() { return plugins.isEmpty(); }
+
+    //! Decode a message with the first responsible plugin.
+    /*!
+      If the message number is given, the decoded message is taken from
+      or stored in the DecodedMsgCache.
+      \param msg the message to be decoded
+      \param triggeredByUser passed to the plugins
+      \param index the number of the message in the log file, -1 if unknown
+      \return true if a plugin decoded the message
+    */
+    bool decodeMsg(QDltMsg &msg, int triggeredByUser, int index = -1);
+
+    //! Decode a batch of messages.
+    /*!
+      Each plugin is called once with all messages it may decode
+      and which were not decoded by a previous plugin.
+      \param msgs the messages to be decoded
+      \param triggeredByUser passed to the plugins
+      \param indexes the numbers of the messages in the log file for the DecodedMsgCache, may be empty
+    */
+    void decodeMsgs(QList<QDltMsg*> &msgs, int triggeredByUser, const QVector<int> &indexes = QVector<int>());
+
+private:
+    quint64 getCandidates(QDltMsg &msg);
+    bool decodeCandidates(QDltMsg &msg, int triggeredByUser);
+    QVector<bool> decodeCandidates(QList<QDltMsg*> &msgs, int triggeredByUser);
+    bool isCandidate(quint64 candidates, int num) { return linear || (candidates & (Q_UINT64_C(1) << num)); }
+
+    QList<PluginItem*> plugins;
+
+    /* one bit per plugin, more plugins are called for each message */
+    bool linear;
+    quint64 unconditional;
+    QHash<QString,quint64> apidClaims;
+    QHash<QPair<QString,QString>,quint64> contextClaims;
+    QHash<unsigned int,quint64> messageIdClaims;
+    QHash<int,quint64> typeClaims;
+
+    QTreeWidget *source;
+    int generation;
+};
+
+#endif // DECODERDISPATCH_H
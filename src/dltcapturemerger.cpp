@@ -0,0 +1,134 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file dltcapturemerger.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QDateTime>
+
+#include "dltcapturemerger.h"
+
+DltCaptureMerger::DltCaptureMerger()
+{
+    sortMode = SortByTimestamp;
+    window = 500;
+    buffered = 0;
+}
+
+void DltCaptureMerger::setWindow(int msecs)
+{
+    window = (msecs < 0) ? 0 : msecs;
+}
+
+void DltCaptureMerger::add(const QString &ecuid, const QByteArray &data, qint64 storageTime, unsigned int timestamp, bool withTimestamp)
+{
+    Stream &stream = streams[ecuid];
+    Entry entry;
+
+    entry.storageTime = storageTime;
+    entry.data = data;
+    entry.key = storageTime;
+
+    if(sortMode == SortByTimestamp && withTimestamp)
+    {
+        /* timestamp is in 0.1ms since ECU startup */
+        qint64 tmsp = (qint64)timestamp * 100;
+
+        /* the smallest difference between receive time and timestamp is
+           the best estimation of the ECU clock offset; restart the estimation
+           when the timestamp jumps back, e.g. after an ECU reset */
+        if(!stream.offsetValid || timestamp < stream.lastTimestamp || storageTime - tmsp < stream.offset)
+        {
+            stream.offset = storageTime - tmsp;
+            stream.offsetValid = true;
+        }
+        stream.lastTimestamp = timestamp;
+
+        entry.key = tmsp + stream.offset;
+    }
+
+    stream.queue.append(entry);
+    buffered++;
+}
+
+int DltCaptureMerger::flush(QIODevice &device, bool all)
+{
+    return merge(device,all,0);
+}
+
+int DltCaptureMerger::flush(QIODevice &device, const QString &ecuid)
+{
+    QMap<QString,Stream>::iterator it = streams.find(ecuid);
+
+    if(it == streams.end())
+        return 0;
+
+    int written = merge(device,false,&it.value());
+    streams.erase(it);
+
+    return written;
+}
+
+int DltCaptureMerger::merge(QIODevice &device, bool all, const Stream *until)
+{
+    QByteArray buffer;
+    int written = 0;
+    qint64 limit = QDateTime::currentMSecsSinceEpoch() * 1000 - (qint64)window * 1000;
+
+    while(buffered > 0)
+    {
+        /* find stream with the smallest key at its head */
+        Stream *next = 0;
+        QMap<QString,Stream>::iterator it;
+        for(it = streams.begin(); it != streams.end(); ++it)
+        {
+            Stream &stream = it.value();
+            if(!stream.queue.isEmpty() && (!next || stream.queue.first().key < next->queue.first().key))
+                next = &stream;
+        }
+
+        if(!next)
+            break;
+
+        if(until)
+        {
+            /* write until the stream is empty, older messages of other ECUs first */
+            if(until->queue.isEmpty())
+                break;
+        }
+        else if(!all && next->queue.first().storageTime > limit)
+        {
+            /* the head has to wait until it left the reorder window,
+               a later message of another ECU could still be ordered before it */
+            break;
+        }
+
+        buffer.append(next->queue.takeFirst().data);
+        buffered--;
+        written++;
+    }
+
+    if(!buffer.isEmpty())
+        device.write(buffer);
+
+    return written;
+}
+
+void DltCaptureMerger::clear()
+{
+    streams.clear();
+    buffered = 0;
+}
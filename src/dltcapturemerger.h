@@ -0,0 +1,125 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file dltcapturemerger.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef DLTCAPTUREMERGER_H
+#define DLTCAPTUREMERGER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+#include <QIODevice>
+
+//! Merge live messages of several ECUs into one time ordered stream.
+/*!
+  Messages received from the connected ECUs are buffered per ECU for a bounded
+  reorder window. When flushed the buffered streams are k-way merged by their
+  sort key, so the log file is written in global time order.
+*/
+class DltCaptureMerger
+{
+public:
+    //! The key used to order the messages of different ECUs.
+    typedef enum { SortByStorageTime = 0, SortByTimestamp } SortMode;
+
+    DltCaptureMerger();
+
+    //! Set the reorder window.
+    /*!
+      A message is held back at most this time before it is written.
+      \param msecs the reorder window in milliseconds
+    */
+    void setWindow(int msecs);
+
+    //! Get the reorder window in milliseconds.
+    int getWindow() { return window; }
+
+    //! Set the key used for ordering the messages.
+    /*!
+      SortByTimestamp orders by the ECU timestamp corrected with an estimated
+      per ECU clock offset. Messages without timestamp fall back to the storage time.
+      \param mode the sort mode
+    */
+    void setSortMode(SortMode mode) { sortMode = mode; }
+
+    //! Get the key used for ordering the messages.
+    SortMode getSortMode() { return sortMode; }
+
+    //! Add a received message to the buffer of its ECU.
+    /*!
+      \param ecuid the ECU the message was received from
+      \param data complete message including storage header
+      \param storageTime receive time in microseconds
+      \param timestamp ECU timestamp in 0.1 milliseconds
+      \param withTimestamp true if the message header contains a timestamp
+    */
+    void add(const QString &ecuid, const QByteArray &data, qint64 storageTime, unsigned int timestamp, bool withTimestamp);
+
+    //! Write all messages which left the reorder window.
+    /*!
+      \param device the device the merged messages are written to
+      \param all write all buffered messages regardless of the reorder window
+      \return number of messages written
+    */
+    int flush(QIODevice &device, bool all = false);
+
+    //! Write all messages of an ECU which stopped sending.
+    /*!
+      The messages of other ECUs ordered before the last message of the ECU
+      are written too, so the written messages stay in global order.
+      The clock offset of the ECU is estimated again when it sends again.
+      \param device the device the merged messages are written to
+      \param ecuid the ECU which stopped sending
+      \return number of messages written
+    */
+    int flush(QIODevice &device, const QString &ecuid);
+
+    //! Number of messages currently buffered.
+    int count() { return buffered; }
+
+    //! Drop all buffered messages and clock offset estimations.
+    void clear();
+
+private:
+    typedef struct
+    {
+        qint64 key;
+        qint64 storageTime;
+        QByteArray data;
+    } Entry;
+
+    struct Stream
+    {
+        Stream() : offset(0), lastTimestamp(0), offsetValid(false) {}
+
+        QList<Entry> queue;
+        qint64 offset;
+        unsigned int lastTimestamp;
+        bool offsetValid;
+    };
+
+    int merge(QIODevice &device, bool all, const Stream *until);
+
+    QMap<QString,Stream> streams;
+    SortMode sortMode;
+    int window;
+    int buffered;
+};
+
+#endif // DLTCAPTUREMERGER_H
@@ -0,0 +1,264 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file dltconverter.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QFile>
+#include <QVector>
+#include <QThread>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+#include <QDebug>
+#include <QTime>
+
+#include <string.h>
+
+#include "dltconverter.h"
+#include "qdlt.h"
+
+/* Size of the file region mapped at once. */
+static const qint64 DLT_CONVERT_REGION_SZ = 64 * 1024 * 1024;
+
+/* Minimum number of messages formatted by one worker job. */
+static const int DLT_CONVERT_BATCH_MIN = 1024;
+
+/* Messages of a region formatted by one worker job. */
+typedef struct
+{
+    const char *data;
+    const QVector<int> *markers;
+    int begin;
+    int end;
+    unsigned long first;
+} DltConvertBatch;
+
+/* Find all DLT0x01 markers in a region, the same markers the index of the viewer is built from. */
+static void dltConvertFindMarkers(const char *data,int size,QVector<int> &markers)
+{
+    const char *pos = data;
+    const char *end = data + size;
+
+    while(end - pos >= 4)
+    {
+        pos = (const char*)memchr(pos,'D',end - pos - 3);
+        if(!pos)
+            break;
+        if(pos[1] == 'L' && pos[2] == 'T' && pos[3] == 0x01)
+        {
+            markers.append(pos - data);
+            pos += 4;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+}
+
+/* Format the messages of one batch, called in parallel by the worker threads. */
+static QByteArray dltConvertBatch(const DltConvertBatch &batch)
+{
+    QDltMsg msg;
+    QString text;
+    QByteArray buffer;
+    const QVector<int> &markers = *batch.markers;
+
+    for(int num = batch.begin; num < batch.end; num++)
+    {
+        msg.setMsg(QByteArray::fromRawData(batch.data + markers[num], markers[num+1] - markers[num]));
+
+        text.clear();
+        QDlt::appendNumber(text,batch.first + (num - batch.begin));
+        text += QLatin1Char(' ');
+        msg.toStringHeader(text);
+        text += QLatin1Char(' ');
+        msg.toStringPayload(text);
+        text += QLatin1Char('\n');
+
+        buffer += text.toAscii();
+    }
+
+    return buffer;
+}
+
+/* Write the formatted text of one region, runs while the next region is formatted. */
+static bool dltConvertWrite(QFile *file,QList<QByteArray> texts)
+{
+    for(int num = 0; num < texts.size(); num++)
+    {
+        if(file->write(texts[num]) != texts[num].size())
+            return false;
+    }
+
+    return true;
+}
+
+DltConverter::DltConverter()
+{
+    count = 0;
+}
+
+bool DltConverter::convertToASCII(const QString &source, const QString &dest)
+{
+    QFile in(source);
+    QFile out(dest);
+    QFuture<bool> writer;
+    bool writing = false;
+    qint64 offset = 0;
+    qint64 regionSize = DLT_CONVERT_REGION_SZ;
+    int jobs = qMax(QThread::idealThreadCount(),1) * 4;
+
+#ifdef DEBUG_PERFORMANCE
+    QTime t;
+    t.start();
+#endif
+
+    count = 0;
+    error.clear();
+
+    if(!in.open(QIODevice::ReadOnly))
+    {
+        error = QString("Cannot open %1: %2").arg(source).arg(in.errorString());
+        return false;
+    }
+
+    if(!out.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        error = QString("Cannot create %1: %2").arg(dest).arg(out.errorString());
+        return false;
+    }
+
+    qint64 fileSize = in.size();
+
+    while(offset < fileSize)
+    {
+        qint64 size = qMin(regionSize, fileSize - offset);
+        bool last = (offset + size == fileSize);
+        QByteArray buffer;
+        const char *data;
+
+        uchar *mapped = in.map(offset,size);
+        if(mapped)
+        {
+            data = (const char*)mapped;
+        }
+        else
+        {
+            /* mapping is not supported by all file systems */
+            if(!in.seek(offset) || (buffer = in.read(size)).size() != size)
+            {
+                error = QString("Cannot read %1: %2").arg(source).arg(in.errorString());
+                break;
+            }
+            data = buffer.constData();
+        }
+
+        QVector<int> markers;
+        dltConvertFindMarkers(data,(int)size,markers);
+
+        /* the last marker of a region starts the next region,
+           only the last region ends with the end of the file */
+        qint64 next;
+        if(last)
+        {
+            markers.append((int)size);
+            next = fileSize;
+        }
+        else if(markers.isEmpty())
+        {
+            /* no message start yet, keep a marker split at the region end */
+            next = offset + size - 3;
+        }
+        else
+        {
+            next = offset + markers.last();
+        }
+
+        if(next == offset)
+        {
+            /* one message larger than the region, retry with a larger region */
+            if(mapped)
+                in.unmap(mapped);
+            regionSize *= 2;
+            continue;
+        }
+
+        int messages = qMax(markers.size() - 1,0);
+        QList<QByteArray> texts;
+
+        if(messages > 0)
+        {
+            QList<DltConvertBatch> batches;
+            int batchSize = qMax(DLT_CONVERT_BATCH_MIN,(messages + jobs - 1) / jobs);
+
+            for(int begin = 0; begin < messages; begin += batchSize)
+            {
+                DltConvertBatch batch;
+                batch.data = data;
+                batch.markers = &markers;
+                batch.begin = begin;
+                batch.end = qMin(begin + batchSize,messages);
+                batch.first = count + begin;
+                batches.append(batch);
+            }
+
+            /* the previous region is still written while this one is formatted */
+            QFuture<QByteArray> formatter = QtConcurrent::mapped(batches,dltConvertBatch);
+            formatter.waitForFinished();
+            texts = formatter.results();
+            count += messages;
+        }
+
+        if(mapped)
+            in.unmap(mapped);
+
+        if(writing)
+        {
+            writer.waitForFinished();
+            writing = false;
+            if(!writer.result())
+            {
+                error = QString("Cannot write %1: %2").arg(dest).arg(out.errorString());
+                break;
+            }
+        }
+
+        if(!texts.isEmpty())
+        {
+            writer = QtConcurrent::run(dltConvertWrite,&out,texts);
+            writing = true;
+        }
+
+        offset = next;
+    }
+
+    if(writing)
+    {
+        writer.waitForFinished();
+        if(!writer.result() && error.isEmpty())
+            error = QString("Cannot write %1: %2").arg(dest).arg(out.errorString());
+    }
+
+    in.close();
+    out.close();
+
+#ifdef DEBUG_PERFORMANCE
+    qDebug() << "Time to convert" << count << "messages: " << t.elapsed()/1000 << "s";
+#endif
+
+    return error.isEmpty();
+}
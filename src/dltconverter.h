@@ -0,0 +1,58 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file dltconverter.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef DLTCONVERTER_H
+#define DLTCONVERTER_H
+
+#include <QString>
+
+//! Convert DLT files without any user interface.
+/*!
+  The source file is memory mapped region by region. The messages of a region
+  are formatted in parallel by worker threads, while the text of the previous
+  region is written in order with large writes. No widget is needed, so the
+  conversion can run in batch jobs on machines without display.
+*/
+class DltConverter
+{
+public:
+    DltConverter();
+
+    //! Convert a DLT file into an ASCII file.
+    /*!
+      Each message is written in one line with its message number, header and payload,
+      the same format used by the viewer. Decoder plugins are not applied.
+      \param source the DLT file to be converted
+      \param dest the ASCII file to be written
+      \return true if the conversion was successful, false if an error occured
+    */
+    bool convertToASCII(const QString &source, const QString &dest);
+
+    //! Number of messages converted by the last conversion.
+    unsigned long getCount() { return count; }
+
+    //! Description of the error of the last failed conversion.
+    QString getError() { return error; }
+
+private:
+    unsigned long count;
+    QString error;
+};
+
+#endif // DLTCONVERTER_H
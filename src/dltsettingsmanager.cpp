@@ -74,3 +74,8 @@ QString DltSettingsManager::fileName() const
 {
     return settings->fileName();
 }
+
+QStringList DltSettingsManager::allKeys() const
+{
+    return settings->allKeys();
+}
@@ -43,6 +43,7 @@ public:
     QVariant value(const QString &key, const QVariant &defaultValue = QVariant()) const;
     void clear();
     QString fileName() const;
+    QStringList allKeys() const;
 
 };
 
@@ -19,18 +19,66 @@
 
 #include <QtGui/QApplication>
 #include <QModelIndex>
+#include <QDebug>
 
 #include "mainwindow.h"
 #include "optmanager.h"
+#include "dltconverter.h"
+#include "dltsettingsmanager.h"
+#include "project.h"
 
-int main(int argc, char *argv[])
+/* Check if a default project or a plugin is enabled in the settings.
+   Both are only loaded by the main window. */
+static bool isDecoderConfigured()
 {
-    QApplication a(argc, argv);
+    DltSettingsManager *settings = DltSettingsManager::getInstance();
+
+    if(settings->value("startup/defaultProjectFile",0).toInt())
+        return true;
+
+    foreach(QString key, settings->allKeys())
+    {
+        if(key.startsWith("plugin/pluginmodefor") &&
+           settings->value(key,PluginItem::ModeDisable).toInt() != PluginItem::ModeDisable)
+            return true;
+    }
+
+    return false;
+}
 
-    QStringList arguments = a.arguments();
+int main(int argc, char *argv[])
+{
+    QStringList arguments;
+    for(int num = 0; num < argc; num++)
+        arguments << QString::fromLocal8Bit(argv[num]);
     OptManager *opt = OptManager::getInstance();
     opt->parse(&arguments);
 
+    /* A plain conversion runs without any window, so it can be used in batch jobs.
+       Project and filter files, the default project and enabled plugins still need
+       the main window to apply filters and decoders. */
+    bool headless = opt->isConvert() && !opt->isProjectFile() && !opt->isFilterFile();
+    if(headless)
+    {
+        /* the settings file is located relative to the application on Windows */
+        QCoreApplication settingsApp(argc, argv);
+        headless = !isDecoderConfigured();
+        DltSettingsManager::close();
+    }
+
+    QApplication a(argc, argv, !headless);
+
+    if(headless)
+    {
+        DltConverter converter;
+        if(!converter.convertToASCII(opt->getConvertSourceFile(),opt->getConvertDestFile()))
+        {
+            qDebug() << "Error occured during conversion:" << converter.getError();
+            return -1;
+        }
+        return 0;
+    }
+
     MainWindow w;
     w.show();
 
@@ -31,6 +31,7 @@
 #include <QLineEdit>
 #include <QUrl>
 #include <QDateTime>
+#include <QInputDialog>
 
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
@@ -52,11 +53,23 @@ MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::MainWindow),
     timer(this),
-    qcontrol(this)
+    qcontrol(this),
+    exportThread(0),
+    exportProgress(0),
+    rotationNumber(0),
+    rotationFailed(false)
 {
     ui->setupUi(this);
     setAcceptDrops(true);
 
+    /* Performance profiler, counters are only collected while visible */
+    profilerDock = new QDockWidget("Profiler",this);
+    profilerDock->setObjectName("Profiler");
+    profilerDock->setWidget(new ProfilerWidget(profilerDock));
+    addDockWidget(Qt::BottomDockWidgetArea,profilerDock);
+    profilerDock->hide();
+    connect(profilerDock,SIGNAL(visibilityChanged(bool)),ui->action_menuHelp_Profiler,SLOT(setChecked(bool)));
+
     /* Settings */
     settings = new SettingsDialog(&qfile,this);
     settings->assertSettingsVersion();
@@ -246,9 +259,9 @@ MainWindow::MainWindow(QWidget *parent) :
         statusFilename->setText("no log file loaded");
         if(settings->defaultLogFile)
         {
-            openDltFile(settings->defaultLogFileName);
             outputfileIsFromCLI = false;
             outputfileIsTemporary = false;
+            openDltFile(settings->defaultLogFileName);
         }
         else
         {
@@ -321,9 +334,9 @@ void MainWindow::commandLineConvertToASCII(){
     QDltMsg msg;
     QString text;
 
-    openDltFile(OptManager::getInstance()->getConvertSourceFile());
     outputfileIsFromCLI = false;
     outputfileIsTemporary = false;
+    openDltFile(OptManager::getInstance()->getConvertSourceFile());
 
     QFile asciiFile(OptManager::getInstance()->getConvertDestFile());
     if(!asciiFile.open(QIODevice::WriteOnly | QIODevice::Text))
@@ -340,15 +353,16 @@ void MainWindow::commandLineConvertToASCII(){
         msg.setMsg(data);
 
         /* decode message is necessary */
-        iterateDecodersForMsg(msg,1);
+        iterateDecodersForMsg(msg,1,qfile.getMsgFilterPos(num));
 
         /* get message ASCII text */
         text.clear();
-        text += QString("%1 ").arg(qfile.getMsgFilterPos(num));
-        text += msg.toStringHeader();
-        text += " ";
-        text += msg.toStringPayload();
-        text += "\n";
+        QDlt::appendSignedNumber(text,qfile.getMsgNumber(qfile.getMsgFilterPos(num)));
+        text += QLatin1Char(' ');
+        msg.toStringHeader(text);
+        text += QLatin1Char(' ');
+        msg.toStringPayload(text);
+        text += QLatin1Char('\n');
 
         /* write to file */
         asciiFile.write(text.toAscii().constData());
@@ -397,6 +411,7 @@ void MainWindow::commandLineExecutePlugin(QString plugin, QString cmd, QStringLi
 
 void MainWindow::closeEvent(QCloseEvent *event)
 {
+    stopExport();
 
     settings->writeSettings(this);
     if(settings->tempCloseWithoutAsking)
@@ -406,6 +421,7 @@ void MainWindow::closeEvent(QCloseEvent *event)
             // Delete created temp file
             qfile.close();
             outputfile.close();
+            removeRotatedFiles();
             if(outputfile.exists() && !outputfile.remove())
             {
                 QMessageBox::critical(0, QString("DLT Viewer"),
@@ -427,6 +443,7 @@ void MainWindow::closeEvent(QCloseEvent *event)
                 // Delete created temp file
                 qfile.close();
                 outputfile.close();
+                removeRotatedFiles();
                 if(outputfile.exists() && !outputfile.remove())
                 {
                     QMessageBox::critical(0, QString("DLT Viewer"),
@@ -460,11 +477,14 @@ void MainWindow::on_action_menuFile_New_triggered()
     workingDirectory = QFileInfo(fileName).absolutePath();
 
     /* close existing file */
+    finishCapture();
     if(outputfile.isOpen())
         outputfile.close();
 
     /* create new file; truncate if already exist */
     outputfile.setFileName(fileName);
+    stopExport();
+    qfile.closeMerge();
     outputfileIsTemporary = false;
     outputfileIsFromCLI = false;
     setCurrentFile(fileName);
@@ -480,7 +500,7 @@ void MainWindow::on_action_menuFile_New_triggered()
 void MainWindow::on_action_menuFile_Open_triggered()
 {
     QString fileName = QFileDialog::getOpenFileName(this,
-                                                    tr("Open DLT Log file"), workingDirectory, tr("DLT Files (*.dlt);;All files (*.*)"));
+                                                    tr("Open DLT Log file"), workingDirectory, tr("DLT Files (*.dlt);;Compressed DLT Files (*.dltz *.gz);;All files (*.*)"));
 
     if(fileName.isEmpty())
         return;
@@ -488,23 +508,87 @@ void MainWindow::on_action_menuFile_Open_triggered()
     /* change current working directory */
     workingDirectory = QFileInfo(fileName).absolutePath();
 
-    openDltFile(fileName);
+    /* a compressed file is opened as temporary merged file */
     outputfileIsFromCLI = false;
     outputfileIsTemporary = false;
+    openDltFile(fileName);
+
+    searchDlg->setMatch(false);
+    searchDlg->setOnceClicked(false);
+    searchDlg->setStartLine(-1);
+}
+
+void MainWindow::on_action_menuFile_Open_Merged_triggered()
+{
+    QStringList fileNames = QFileDialog::getOpenFileNames(this,
+                                                          tr("Open DLT Log files to merge"), workingDirectory, tr("DLT Files (*.dlt *.dltz *.gz);;All files (*.*)"));
+
+    if(fileNames.isEmpty())
+        return;
+
+    /* change current working directory */
+    workingDirectory = QFileInfo(fileNames.first()).absolutePath();
+
+    openMergedFiles(fileNames);
 
     searchDlg->setMatch(false);
     searchDlg->setOnceClicked(false);
     searchDlg->setStartLine(-1);
 }
 
+void MainWindow::openMergedFiles(QStringList fileNames)
+{
+    /* messages received while the merged files are open are stored in a new temporary file */
+    QString fn = DltFileUtils::createTempFile(DltFileUtils::getTempPath(settings));
+    if(!fn.length())
+        return;
+
+    /* the files are only read, nothing is copied */
+    stopExport();
+    if(!qfile.openMerge(fileNames))
+    {
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("Cannot open log files to merge"));
+        return;
+    }
+
+    /* close existing file */
+    finishCapture();
+    if(outputfile.isOpen())
+        outputfile.close();
+
+    outputfile.setFileName(fn);
+    outputfileIsTemporary = true;
+    outputfileIsFromCLI = false;
+
+    if(outputfile.open(QIODevice::WriteOnly|QIODevice::Truncate))
+        reloadLogFile();
+    else
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("Cannot open log file \"%1\"\n%2")
+                              .arg(fn)
+                              .arg(outputfile.errorString()));
+}
+
 void MainWindow::openDltFile(QString fileName)
 {
+    /* compressed files are read only, new messages are stored in a temporary file */
+    if(QDltFile::isCompressed(fileName))
+    {
+        setCurrentFile(fileName);
+        openMergedFiles(QStringList() << fileName);
+        return;
+    }
+
     /* close existing file */
+    finishCapture();
     if(outputfile.isOpen())
         outputfile.close();
 
     /* open existing file and append new data */
     outputfile.setFileName(fileName);
+    stopExport();
+    qfile.closeMerge();
     setCurrentFile(fileName);
     if(outputfile.open(QIODevice::WriteOnly|QIODevice::Append))
         reloadLogFile();
@@ -612,61 +696,108 @@ void MainWindow::on_action_menuFile_Append_DLT_File_triggered()
     if(!outputfile.isOpen())
         return;
 
-    DltFile importfile;
-
-    dlt_file_init(&importfile,0);
-
-    QProgressDialog progress("Append log file", "Cancel Loading", 0, 100, this);
-    int num = 0;
-
-    /* open DLT log file with same filename as output file */
-    if (dlt_file_open(&importfile,fileName.toAscii() ,0)<0)
+    QFile importfile(fileName);
+    if(!importfile.open(QIODevice::ReadOnly))
     {
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("Cannot open log file \"%1\"\n%2")
+                              .arg(fileName)
+                              .arg(importfile.errorString()));
         return;
     }
 
-    /* get number of files in DLT log file */
-    while (dlt_file_read(&importfile,0)>=0)
+    QProgressDialog progress("Append log file", "Cancel Loading", 0, 100, this);
+    progress.setWindowModality(Qt::WindowModal);
+
+    /* Align kbytes, 1MB read and written at a time */
+    static const int READ_BUF_SZ = 1024 * 1024;
+
+    QByteArray buf;
+    QByteArray block;
+    QList<unsigned long> index;
+    qint64 skipped = 0;
+    bool eof = false;
+
+    block.reserve(2 * READ_BUF_SZ);
+
+    /* the new messages are indexed at their position behind the current end of the log file */
+    outputfile.flush();
+    unsigned long pos = outputfile.size();
+    int oldsize = qfile.size();
+
+    /* read the file once, validate each message and copy it into the write block */
+    while(!eof && !progress.wasCanceled())
     {
-        num++;
-        if ((num%1000) == 0)
-            progress.setValue(importfile.file_position*100/importfile.file_length);
-        if (progress.wasCanceled())
+        QByteArray data = importfile.read(READ_BUF_SZ);
+        eof = data.isEmpty();
+        buf.append(data);
+
+        int offset = 0;
+        while(offset < buf.size())
         {
-            dlt_file_free(&importfile,0);
-            return;
+            int size = QDltFile::checkMsg(buf.constData() + offset, buf.size() - offset);
+            if(size > 0)
+            {
+                index.append(pos + block.size());
+                block.append(buf.constData() + offset, size);
+                offset += size;
+            }
+            else if(size == 0 && !eof)
+            {
+                /* message continues in the next read */
+                break;
+            }
+            else
+            {
+                /* corrupted data, continue with the next storage header */
+                int next = buf.indexOf("DLT\x01", offset + 1);
+                if(next < 0)
+                    next = eof ? buf.size() : qMax(offset + 1, buf.size() - 3);
+                skipped += next - offset;
+                offset = next;
+            }
         }
-    }
+        buf = buf.mid(offset);
 
-    /* read DLT messages and append to current output file */
-    for(int pos = 0 ; pos<num ; pos++)
-    {
-        if ((pos%1000) == 0)
-            progress.setValue(pos*100/num);
-        if (progress.wasCanceled())
+        if(block.size() >= READ_BUF_SZ || eof)
         {
-            dlt_file_free(&importfile,0);
-            reloadLogFile();
-            return;
+            outputfile.write(block);
+            pos += block.size();
+            block.clear();
         }
-        dlt_file_message(&importfile,pos,0);
-        outputfile.write((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
-        outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
+
+        if(importfile.size() > 0)
+            progress.setValue(importfile.pos()*100/importfile.size());
     }
+
+    /* messages already validated are appended also if canceled */
+    if(!block.isEmpty())
+        outputfile.write(block);
     outputfile.flush();
 
-    dlt_file_free(&importfile,0);
+    importfile.close();
 
-    /* reload log file */
-    reloadLogFile();
+    /* extend index by the appended messages */
+    qfile.appendDltIndex(index);
+    oldsize = qMax(oldsize - applyRetention(),0);
+    processNewMessages(oldsize);
 
+    if(skipped > 0)
+        QMessageBox::warning(0, QString("DLT Viewer"),
+                             QString("%1 bytes of corrupted data skipped in \"%2\"").arg(skipped).arg(fileName));
 }
 
 void MainWindow::on_action_menuFile_Export_ASCII_triggered()
 {
-    QDltMsg msg;
-    QByteArray data;
-    QString text;
+    QList<PluginItem*> activeDecoderPlugins;
+
+    if(exportThread)
+    {
+        QMessageBox::warning(0, QString("DLT Viewer"),
+                             QString("An export to \"%1\" is still running.").arg(exportThread->getFileName()));
+        return;
+    }
+
     QString fileName = QFileDialog::getSaveFileName(this,
                                                     tr("Export to ASCII"), workingDirectory, tr("ASCII Files (*.txt);;All files (*.*)"));
 
@@ -676,41 +807,81 @@ void MainWindow::on_action_menuFile_Export_ASCII_triggered()
     /* change current working directory */
     workingDirectory = QFileInfo(fileName).absolutePath();
 
-    QFile outfile(fileName);
-    if(!outfile.open(QIODevice::WriteOnly | QIODevice::Text))
-        return;
-
-    QProgressDialog fileprogress("Export to ASCII...", "Cancel", 0, qfile.sizeFilter(), this);
-    fileprogress.setWindowTitle("DLT Viewer");
-    fileprogress.setWindowModality(Qt::WindowModal);
-    fileprogress.show();
+    /* the export works on the messages shown when it is started */
     const int qsz = qfile.sizeFilter();
+    QVector<int> positions(qsz);
     for(int num = 0;num< qsz;num++)
+        positions[num] = qfile.getMsgFilterPos(num);
+
+    for(int i = 0; i < project.plugin->topLevelItemCount(); i++)
     {
-        if((num%(qsz/300+1))==0)
-            fileprogress.setValue(num);
+        PluginItem *item = (PluginItem*)project.plugin->topLevelItem(i);
 
-        /* get message form log file */
-        data = qfile.getMsgFilter(num);
-        msg.setMsg(data);
+        if(item->getMode() != PluginItem::ModeDisable && item->plugindecoderinterface)
+            activeDecoderPlugins.append(item);
+    }
 
-        /* decode message is necessary */
-        iterateDecodersForMsg(msg,1);
+    exportThread = new ThreadExport(this);
+    exportThread->setQDltFile(&qfile);
+    exportThread->setActiveDecoderPlugins(activeDecoderPlugins);
+    exportThread->setPositions(positions);
+    exportThread->setFileName(fileName);
 
-        /* get message ASCII text */
-        text.clear();
-        text += QString("%1 ").arg(qfile.getMsgFilterPos(num));
-        text += msg.toStringHeader();
-        text += " ";
-        text += msg.toStringPayload();
-        text += "\n";
+    /* the export runs in the background, the progress dialog does not block the window */
+    exportProgress = new QProgressDialog("Export to ASCII...", "Cancel", 0, qsz, this);
+    exportProgress->setWindowTitle("DLT Viewer");
+    exportProgress->setWindowModality(Qt::NonModal);
+    exportProgress->setAutoClose(false);
+    exportProgress->setAutoReset(false);
 
-        /* write to file */
-        outfile.write(text.toAscii().constData());
+    connect(exportThread, SIGNAL(percentageComplete(int)), exportProgress, SLOT(setValue(int)));
+    connect(exportProgress, SIGNAL(canceled()), exportThread, SLOT(stopProcessMsg()));
+    connect(exportThread, SIGNAL(finished()), this, SLOT(exportFinished()));
+
+    exportProgress->show();
+    exportThread->start();
+}
 
+void MainWindow::exportFinished()
+{
+    /* ignore the signal of an export already finished by stopExport() */
+    if(!exportThread || (sender() && sender() != exportThread))
+        return;
+
+    if(!exportThread->getError().isEmpty())
+    {
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("Export to \"%1\" failed\n%2")
+                              .arg(exportThread->getFileName())
+                              .arg(exportThread->getError()));
+    }
+    else if(exportThread->wasStopped())
+    {
+        QMessageBox::warning(0, QString("DLT Viewer"),
+                             QString("Export to \"%1\" canceled after %2 messages.")
+                             .arg(exportThread->getFileName())
+                             .arg(exportThread->getCount()));
     }
 
-    outfile.close();
+    exportProgress->deleteLater();
+    exportProgress = 0;
+    exportThread->deleteLater();
+    exportThread = 0;
+}
+
+void MainWindow::stopExport()
+{
+    /* the export reads from the log file, stop it before the log file is changed */
+    if(exportThread)
+    {
+        exportThread->stopProcessMsg();
+
+        /* GUI thread only plugins can not be served while waiting */
+        PluginItem::setGuiThreadBlocked(true);
+        exportThread->wait();
+        PluginItem::setGuiThreadBlocked(false);
+        exportFinished();
+    }
 }
 
 void MainWindow::on_action_menuFile_Export_Selection_triggered()
@@ -723,6 +894,65 @@ void MainWindow::on_action_menuFile_Export_Selection_ASCII_triggered()
     exportSelection(true,true);
 }
 
+void MainWindow::on_action_menuFile_Export_Filtered_triggered()
+{
+    QString fileName = QFileDialog::getSaveFileName(this,
+                                                    tr("Export Filtered"), workingDirectory, tr("DLT Files (*.dlt)"));
+
+    if(fileName.isEmpty())
+        return;
+
+    /* change current working directory */
+    workingDirectory = QFileInfo(fileName).absolutePath();
+
+    QFile outfile(fileName);
+    if(!outfile.open(QIODevice::WriteOnly))
+    {
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("Cannot create file \"%1\"\n%2")
+                              .arg(fileName)
+                              .arg(outfile.errorString()));
+        return;
+    }
+
+    const int qsz = qfile.sizeFilter();
+    QVector<int> positions(qsz);
+    for(int num = 0;num< qsz;num++)
+        positions[num] = qfile.getMsgFilterPos(num);
+
+    exportMsgs(positions,outfile);
+}
+
+void MainWindow::exportMsgs(const QVector<int> &positions,QFile &outfile)
+{
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+
+#ifdef DEBUG_PERFORMANCE
+    QTime t;
+    t.start();
+#endif
+
+    /* live messages are written to the log file, they have to be visible to the copy */
+    outputfile.flush();
+
+    bool success = qfile.copyMsgs(positions,outfile);
+    outfile.close();
+
+#ifdef DEBUG_PERFORMANCE
+    qDebug() << "Time to export" << positions.size() << "messages: " << t.elapsed()/1000 << "s";
+#endif
+
+    QApplication::restoreOverrideCursor();
+
+    if(!success)
+    {
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("Export to \"%1\" failed\n%2")
+                              .arg(outfile.fileName())
+                              .arg(outfile.errorString()));
+    }
+}
+
 void MainWindow::exportSelection(bool ascii = true,bool file = false)
 {
     QModelIndexList list = ui->tableView->selectionModel()->selection().indexes();
@@ -766,6 +996,29 @@ void MainWindow::exportSelection(bool ascii = true,bool file = false)
             return;
     }
 
+    if(!ascii)
+    {
+        if(file)
+        {
+            /* only the first column identifies a selected message, they are written in the order of the view */
+            QVector<int> rows;
+            rows.reserve(list.count());
+            for(int num=0; num < list.count();num++)
+            {
+                if(list[num].column()==0)
+                    rows.append(list[num].row());
+            }
+            qSort(rows);
+
+            QVector<int> positions(rows.size());
+            for(int num=0; num < rows.size();num++)
+                positions[num] = qfile.getMsgFilterPos(rows[num]);
+
+            exportMsgs(positions,outfile);
+        }
+        return;
+    }
+
     QProgressDialog fileprogress("Export...", "Cancel", 0, list.count(), this);
     fileprogress.setWindowTitle("DLT Viewer");
     fileprogress.setWindowModality(Qt::WindowModal);
@@ -782,43 +1035,29 @@ void MainWindow::exportSelection(bool ascii = true,bool file = false)
         {
             data = qfile.getMsgFilter(index.row());
 
-            if(ascii)
-            {
-                msg.setMsg(data);
+            msg.setMsg(data);
 
-                /* decode message is necessary */
-                iterateDecodersForMsg(msg,1);
+            /* decode message is necessary */
+            iterateDecodersForMsg(msg,1,qfile.getMsgFilterPos(index.row()));
 
-                /* get message ASCII text */
-                text.clear();
-                text += QString("%1 ").arg(qfile.getMsgFilterPos(index.row()));
-                text += msg.toStringHeader();
-                text += " ";
-                text += msg.toStringPayload();
-                text += "\n";
+            /* get message ASCII text */
+            text.clear();
+            QDlt::appendSignedNumber(text,qfile.getMsgNumber(qfile.getMsgFilterPos(index.row())));
+            text += QLatin1Char(' ');
+            msg.toStringHeader(text);
+            text += QLatin1Char(' ');
+            msg.toStringPayload(text);
+            text += QLatin1Char('\n');
 
-                if(file)
-                {
-                    // write to file
-                    outfile.write(text.toAscii().constData());
-                }
-                else
-                {
-                    // write to clipboard
-                    textExport += text;
-                }
+            if(file)
+            {
+                // write to file
+                outfile.write(text.toAscii().constData());
             }
             else
             {
-                if(file)
-                {
-                    // write to file
-                    outfile.write(data);
-                }
-                else
-                {
-                    // write to clipboard
-                }
+                // write to clipboard
+                textExport += text;
             }
         }
     }
@@ -855,17 +1094,41 @@ void MainWindow::on_action_menuFile_SaveAs_triggered()
     /* change current working directory */
     workingDirectory = QFileInfo(fileName).absolutePath();
 
-    qfile.close();
-    outputfile.close();
-
     bool success = true;
-    QFile sourceFile( outputfile.fileName() );
     QFile destFile( fileName );
-    success &= sourceFile.open( QFile::ReadOnly );
-    success &= destFile.open( QFile::WriteOnly | QFile::Truncate );
-    success &= destFile.write( sourceFile.readAll() ) >= 0;
-    sourceFile.close();
-    destFile.close();
+
+    stopExport();
+
+    /* the messages held back for reordering are saved too */
+    flushCapture(true);
+
+    if(!qfile.getMergeFileNames().isEmpty())
+    {
+        /* store merged log files in their merged order */
+        outputfile.flush();
+        success &= destFile.open( QFile::WriteOnly | QFile::Truncate );
+        for(int num = 0; success && num < qfile.size(); num++)
+        {
+            success &= destFile.write( qfile.getMsg(num) ) >= 0;
+        }
+        destFile.close();
+
+        qfile.closeMerge();
+        qfile.close();
+        outputfile.close();
+    }
+    else
+    {
+        qfile.close();
+        outputfile.close();
+
+        QFile sourceFile( outputfile.fileName() );
+        success &= sourceFile.open( QFile::ReadOnly );
+        success &= destFile.open( QFile::WriteOnly | QFile::Truncate );
+        success &= destFile.write( sourceFile.readAll() ) >= 0;
+        sourceFile.close();
+        destFile.close();
+    }
 
     if(!success)
     {
@@ -888,6 +1151,40 @@ void MainWindow::on_action_menuFile_SaveAs_triggered()
                               .arg(outputfile.errorString()));
 }
 
+void MainWindow::on_action_menuFile_SaveAs_Compressed_triggered()
+{
+    QString fileName = QFileDialog::getSaveFileName(this,
+                                                    tr("Save compressed DLT Log file"), workingDirectory, tr("Compressed DLT Files (*.dltz);;All files (*.*)"));
+
+    if(fileName.isEmpty())
+        return;
+
+    /* check if filename is the same as already open */
+    if(outputfile.fileName()==fileName || qfile.getMergeFileNames().contains(fileName))
+    {
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("File is already open!"));
+
+        return;
+    }
+
+    /* change current working directory */
+    workingDirectory = QFileInfo(fileName).absolutePath();
+
+    /* the open log file stays open, all its messages are compressed into the new file */
+    stopExport();
+    outputfile.flush();
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    bool success = QDltCompressedFile::create(fileName,qfile);
+    QApplication::restoreOverrideCursor();
+
+    if(!success)
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("Cannot create compressed log file \"%1\"")
+                              .arg(fileName));
+}
+
 void MainWindow::on_action_menuFile_Clear_triggered()
 {
     QString fn = DltFileUtils::createTempFile(DltFileUtils::getTempPath(settings));
@@ -900,12 +1197,21 @@ void MainWindow::on_action_menuFile_Clear_triggered()
 
     QString oldfn = outputfile.fileName();
 
+    /* the messages held back for reordering are cleared with the log */
+    captureMerger.clear();
+
     if(outputfile.isOpen())
     {
         outputfile.close();
     }
 
     outputfile.setFileName(fn);
+    stopExport();
+
+    /* files split from a temporary log file are deleted with it */
+    if(outputfileIsTemporary && !settings->tempSaveOnClear && !outputfileIsFromCLI)
+        removeRotatedFiles();
+    qfile.closeMerge();
 
     if(outputfile.open(QIODevice::WriteOnly|QIODevice::Truncate))
     {
@@ -943,6 +1249,9 @@ void MainWindow::threadpluginFinished(){
 
 void MainWindow::reloadLogFile()
 {
+    stopExport();
+    rotationStart = QDateTime();
+    rotationFailed = false;
 
     PluginItem *item = 0;
     QList<PluginItem*> activeViewerPlugins;
@@ -982,6 +1291,8 @@ void MainWindow::reloadLogFile()
 
     //qfile.createIndex();
 
+    QDltProfilerScope indexProfile("Indexing");
+
     /* ----> Thread usage to create DLT index starts here <---- */
     threadDltIndex.start();
     threadDltIndex.setPriority(QThread::HighestPriority);
@@ -995,9 +1306,27 @@ void MainWindow::reloadLogFile()
 #endif
 
     QList<unsigned long> indexDltList = threadDltIndex.getIndexAll();
+    indexProfile.setItems(indexDltList.size());
+    indexProfile.stop();
     qfile.setDltIndex(indexDltList);
     /* ----> Thread usage to create DLT index ends here <---- */
 
+    if(!qfile.getMergeFileNames().isEmpty())
+    {
+        fileprogress.setLabelText(QString("Merging %1 DLT files...").arg(qfile.getMergeFileNames().size()+1));
+        QApplication::processEvents();
+
+#ifdef DEBUG_PERFORMANCE
+        t.start();
+#endif
+
+        qfile.createIndexMerge();
+
+#ifdef DEBUG_PERFORMANCE
+        qDebug() << "Time to create merged index: " << t.elapsed()/1000 << "s" ;
+#endif
+    }
+
 
     fileprogress.setMaximum(qfile.size());
     fileprogressButtons.at(0)->setEnabled(true);
@@ -1019,7 +1348,7 @@ void MainWindow::reloadLogFile()
 #ifdef DEBUG_PERFORMANCE
                 t.start();
 #endif
-                item->pluginviewerinterface->initFileStart(&qfile);
+                item->initFileStart(&qfile);
 
 #ifdef DEBUG_PERFORMANCE
                 qDebug() << "Time for initFileStart: " << item->getName() << ": " << t.elapsed()/1000 << "s" ;
@@ -1044,6 +1373,8 @@ void MainWindow::reloadLogFile()
 #endif
         QDltMsg msg;
         PluginItem *item;
+        DecoderDispatch decoderDispatch;
+        decoderDispatch.setPlugins(activeDecoderPlugins);
         for(int ix=0;ix<qfile.size();ix++)
         {
             /* Fill message from file */
@@ -1057,21 +1388,11 @@ void MainWindow::reloadLogFile()
             for(int ivp=0;ivp < activeViewerPlugins.size();ivp++)
             {
                 item = (PluginItem*)activeViewerPlugins.at(ivp);
-                item->pluginviewerinterface->initMsg(ix, msg);
+                item->initMsg(ix, msg);
             }
 
             /* Process all decoderplugins */
-            for(int idp = 0; idp < activeDecoderPlugins.size();idp++)
-            {
-                item = (PluginItem*)activeDecoderPlugins.at(idp);
-                if(item->plugindecoderinterface->isMsg(msg, 0))
-                {
-                    item->plugindecoderinterface->decodeMsg(msg, 0);
-                    /* TODO: Do we, or do we not want to break here?
-                     * Perhaps user wants to stack multiple plugins */
-                    break;
-                }
-            }
+            decoderDispatch.decodeMsg(msg,0);
 
             /* Add to filterindex if matches */
             if(qfile.checkFilter(msg))
@@ -1083,7 +1404,7 @@ void MainWindow::reloadLogFile()
             for(int ivp=0;ivp<activeViewerPlugins.size();ivp++)
             {
                 item = (PluginItem *)activeViewerPlugins.at(ivp);
-                item->pluginviewerinterface->initMsgDecoded(ix, msg);
+                item->initMsgDecoded(ix, msg);
             }
 
             /* Update progress every 0.5% */
@@ -1100,6 +1421,7 @@ void MainWindow::reloadLogFile()
                 break;
             }
         }
+        qfile.sortFilterIndex();
 
 #ifdef DEBUG_PERFORMANCE
         qDebug() << "Time to initMsg,isMsg,decodeMsg,checkFilter,initMsgDecoded: " << t.elapsed()/1000 << "s" ;
@@ -1112,7 +1434,7 @@ void MainWindow::reloadLogFile()
             t.start();
 #endif
 
-            item->pluginviewerinterface->initFileFinish();
+            item->initFileFinish();
 
 #ifdef DEBUG_PERFORMANCE
             qDebug() << "Time for initFileFinish: " << item->getName() << ": " << t.elapsed()/1000 << "s" ;
@@ -1129,7 +1451,10 @@ void MainWindow::reloadLogFile()
     tableModel->modelChanged();
 
     /* set name of opened log file in status bar */
-    statusFilename->setText(outputfile.fileName());
+    if(qfile.getMergeFileNames().isEmpty())
+        statusFilename->setText(outputfile.fileName());
+    else
+        statusFilename->setText(QString("%1 (%2 files merged)").arg(outputfile.fileName()).arg(qfile.getMergeFileNames().size()));
 }
 
 void MainWindow::applySettings()
@@ -1154,6 +1479,10 @@ void MainWindow::applySettings()
     settings->showNoar?ui->tableView->showColumn(10):ui->tableView->hideColumn(10);
     settings->showPayload?ui->tableView->showColumn(11):ui->tableView->hideColumn(11);
 
+    captureMerger.setWindow(settings->mergeCaptureWindow);
+    captureMerger.setSortMode(settings->mergeCaptureTimestamp?DltCaptureMerger::SortByTimestamp:DltCaptureMerger::SortByStorageTime);
+    if(!settings->mergeCapture)
+        flushCapture(true);
 }
 
 void MainWindow::on_action_menuFile_Settings_triggered()
@@ -2018,6 +2347,9 @@ void MainWindow::disconnectECU(EcuItem *ecuitem)
         }
 
         ecuitem->InvalidAll();
+
+        /* no more messages will be received from this ECU */
+        flushCaptureEcu(ecuitem->id);
     }
 }
 
@@ -2201,6 +2533,9 @@ void MainWindow::timeout()
             connectECU(ecuitem,true);
         }
     }
+
+    /* write merged messages of ECUs which stopped sending */
+    flushCapture(false);
 }
 
 void MainWindow::error(QAbstractSocket::SocketError /* socketError */)
@@ -2251,9 +2586,6 @@ void MainWindow::read(EcuItem* ecuitem)
 {
     int32_t bytesRcvd = 0;
     QDltMsg qmsg;
-    PluginItem *item = 0;
-    QList<PluginItem*> activeViewerPlugins;
-    QList<PluginItem*> activeDecoderPlugins;
 
     if (!ecuitem)
         return;
@@ -2306,8 +2638,18 @@ void MainWindow::read(EcuItem* ecuitem)
             /* check if message is matching the filter */
             if (outputfile.isOpen())
             {
+                QDltProfilerScope profile("Capture write");
 
-                if ((settings->writeControl && (qmsg.getType()==QDltMsg::DltTypeControl)) || (!(qmsg.getType()==QDltMsg::DltTypeControl)))
+                if(settings->mergeCapture && ((settings->writeControl && (qmsg.getType()==QDltMsg::DltTypeControl)) || (!(qmsg.getType()==QDltMsg::DltTypeControl))))
+                {
+                    /* hold message back in the reorder window of its ECU */
+                    QByteArray buffer((const char*)&str,sizeof(DltStorageHeader));
+                    buffer.append(qmsg.getHeader());
+                    buffer.append(qmsg.getPayload());
+                    captureMerger.add(ecuitem->id,buffer,(qint64)time.toMSecsSinceEpoch()*1000,qmsg.getTimestamp(),
+                                      DLT_IS_HTYP_WTMS((uint8_t)qmsg.getHeader().at(0)));
+                }
+                else if ((settings->writeControl && (qmsg.getType()==QDltMsg::DltTypeControl)) || (!(qmsg.getType()==QDltMsg::DltTypeControl)))
                 {
                     outputfile.write((char*)&str,sizeof(DltStorageHeader));
                     QByteArray buffer = qmsg.getHeader();
@@ -2349,75 +2691,314 @@ void MainWindow::read(EcuItem* ecuitem)
         statusBytesReceived->setText(QString("Recv: %1").arg(totalBytesRcvd));
         statusSyncFoundReceived->setText(QString("Sync found: %1").arg(totalSyncFoundRcvd));
 
-        if (outputfile.isOpen() )
+        if(settings->mergeCapture)
+        {
+            /* write the merged messages which left the reorder window */
+            flushCapture(false);
+        }
+        else
         {
+            updateIndex();
+        }
+    }
+}
 
-            for(int i = 0; i < project.plugin->topLevelItemCount(); i++)
-            {
-                item = (PluginItem*)project.plugin->topLevelItem(i);
+void MainWindow::flushCapture(bool all)
+{
+    if(!outputfile.isOpen() || captureMerger.count() == 0)
+        return;
 
-                if(item->getMode() != PluginItem::ModeDisable)
-                {
-                    if(item->plugindecoderinterface)
-                    {
-                        activeDecoderPlugins.append(item);
-                    }
-                    if(item->pluginviewerinterface)
-                    {
-                        item->pluginviewerinterface->updateFileStart();
-                        activeViewerPlugins.append(item);
-                    }
-                }
-            }
+    QDltProfilerScope profile("Capture flush");
+    int count = captureMerger.flush(outputfile,all);
+    profile.setItems(count);
+    profile.stop();
+
+    if(count > 0)
+    {
+        outputfile.flush();
+        updateIndex();
+    }
+}
 
+void MainWindow::flushCaptureEcu(const QString &ecuid)
+{
+    if(!outputfile.isOpen() || captureMerger.count() == 0)
+        return;
 
-            /* read received messages in DLT file parser and update DLT message list view */
-            /* update indexes  and table view */
-            int oldsize = qfile.size();
-            qfile.updateIndex();
+    /* the other ECUs keep their messages in the reorder window */
+    QDltProfilerScope profile("Capture flush");
+    int count = captureMerger.flush(outputfile,ecuid);
+    profile.setItems(count);
+    profile.stop();
 
-            for(int num=oldsize;num<qfile.size();num++) {
-                qmsg.setMsg(qfile.getMsg(num));
+    if(count > 0)
+    {
+        outputfile.flush();
+        updateIndex();
+    }
+}
 
-                for(int i = 0; i < activeViewerPlugins.size(); i++){
-                    item = (PluginItem*)activeViewerPlugins.at(i);
-                    item->pluginviewerinterface->updateMsg(num,qmsg);
-                }
+void MainWindow::finishCapture()
+{
+    /* the messages held back for reordering belong to the log file they were received for */
+    if(outputfile.isOpen() && captureMerger.count() > 0)
+        captureMerger.flush(outputfile,true);
 
-                for(int i = 0; i < activeDecoderPlugins.size(); i++)
-                {
-                    item = (PluginItem*)activeDecoderPlugins.at(i);
+    /* the clock offsets of the ECUs are estimated again for the next log file */
+    captureMerger.clear();
+}
 
-                    if(item->plugindecoderinterface->isMsg(qmsg,0))
-                    {
-                        item->plugindecoderinterface->decodeMsg(qmsg,0);
-                        break;
-                    }
-                }
+void MainWindow::updateIndex()
+{
+    if (outputfile.isOpen() )
+    {
+        /* read received messages in DLT file parser and update DLT message list view */
+        int oldsize = qfile.size();
+        qfile.updateIndex();
 
-                if(qfile.checkFilter(qmsg)) {
-                    qfile.addFilterIndex(num);
-                }
+        /* live mode keeps only the latest messages in the index */
+        oldsize = qMax(oldsize - applyRetention(),0);
 
-                for(int i = 0; i < activeViewerPlugins.size(); i++){
-                    item = (PluginItem*)activeViewerPlugins.at(i);
-                    item->pluginviewerinterface->updateMsgDecoded(num,qmsg);
-                }
-            }
+        processNewMessages(oldsize);
 
-            tableModel->modelChanged();
-            //Line below would resize the payload column automatically so that the whole content is readable
-            //ui->tableView->resizeColumnToContents(11); //Column 11 is the payload column
-            if(settings->autoScroll) {
-                ui->tableView->scrollToBottom();
-            }
+        checkRotation();
+    }
+}
+
+int MainWindow::applyRetention()
+{
+    int count = 0;
+
+    if(!settings->liveRetention)
+        return 0;
+
+    /* the export and the filter or index threads work with message numbers,
+       which are changed by removing messages, so the removal waits for them */
+    if(exportThread || threadIsRunnging)
+        return 0;
+
+    /* keep the last messages */
+    if(settings->liveRetentionCount > 0 && qfile.size() > settings->liveRetentionCount)
+        count = qfile.size() - settings->liveRetentionCount;
+
+    /* keep the messages received in the last minutes, the messages are in receive order */
+    if(settings->liveRetentionDuration > 0)
+    {
+        unsigned int limit = QDateTime::currentDateTime().toTime_t() - settings->liveRetentionDuration * 60;
+        int high = qfile.size();
+        QDltMsg msg;
+        while(count < high)
+        {
+            int middle = (count + high) / 2;
+            if(qfile.getMsg(middle,msg) && msg.getTime() < limit)
+                count = middle + 1;
+            else
+                high = middle;
+        }
+    }
+
+    /* removing renumbers all indexes, so messages are removed in larger steps */
+    if(count == 0 || count < qfile.size() / 10)
+        return 0;
+
+    /* the queued messages are passed to the viewer plugins with their old numbers first */
+    for(int i = 0; i < project.plugin->topLevelItemCount(); i++)
+    {
+        PluginItem *item = (PluginItem*)project.plugin->topLevelItem(i);
+        if(item->viewerQueue)
+            item->viewerQueue->flush();
+    }
+
+    /* the last message of the log file is always kept */
+    int removed = qfile.getRemovedMsgs();
+    qfile.removeMsgs(count);
+    removed = qfile.getRemovedMsgs() - removed;
+
+    /* the selected rows point to other messages now */
+    if(removed > 0)
+        ui->tableView->selectionModel()->clear();
+
+    return removed;
+}
+
+void MainWindow::checkRotation()
+{
+    if(!settings->splitLogfile || rotationFailed)
+        return;
+
+    if(!rotationStart.isValid())
+        rotationStart = QDateTime::currentDateTime();
+
+    /* continue the capture in a new file when the current one is too large or too old */
+    if((settings->splitLogfileSize > 0 && outputfile.size() >= (qint64)settings->splitLogfileSize * 1024 * 1024) ||
+       (settings->splitLogfileDuration > 0 && rotationStart.secsTo(QDateTime::currentDateTime()) >= settings->splitLogfileDuration * 60))
+    {
+        rotateLogFile();
+    }
+}
+
+void MainWindow::rotateLogFile()
+{
+    /* the files are numbered after the file the capture was started with */
+    rotatedFiles = getRotatedFiles();
+    if(rotatedFiles.isEmpty())
+    {
+        rotationBaseName = outputfile.fileName();
+        rotationNumber = 0;
+    }
+
+    QFileInfo info(rotationBaseName);
+    QString fn;
+    do
+    {
+        fn = QString("%1/%2_%3.%4").arg(info.absolutePath()).arg(info.completeBaseName())
+                .arg(++rotationNumber,3,10,QLatin1Char('0')).arg(info.suffix().isEmpty() ? QString("dlt") : info.suffix());
+    } while(QFile::exists(fn));
+
+    stopExport();
+
+    /* the current file is kept in the index as merged file, no index is recreated */
+    QString oldfn = outputfile.fileName();
+    outputfile.close();
+    outputfile.setFileName(fn);
+    bool opened = outputfile.open(QIODevice::WriteOnly|QIODevice::Truncate);
+    if(!opened || !qfile.rotate(fn))
+    {
+        QString error = opened ? QString("The new log file cannot be read.") : outputfile.errorString();
+
+        /* continue the capture in the current file, the index was not changed by a failed rotate */
+        outputfile.close();
+        if(opened)
+            QFile::remove(fn);
+        outputfile.setFileName(oldfn);
+        if(!outputfile.open(QIODevice::WriteOnly|QIODevice::Append))
+            error += QString("\nCannot reopen log file \"%1\"\n%2").arg(oldfn).arg(outputfile.errorString());
+
+        rotationFailed = true;
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("Cannot split log file into \"%1\"\n%2")
+                              .arg(fn)
+                              .arg(error));
+        return;
+    }
+    rotatedFiles.append(oldfn);
+
+    /* delete the oldest files, the index has to be recreated */
+    if(settings->splitLogfileCount > 0 && rotatedFiles.size() + 1 > settings->splitLogfileCount)
+    {
+        QStringList fileNames = qfile.getMergeFileNames();
+        QStringList oldFiles;
+        while(!rotatedFiles.isEmpty() && rotatedFiles.size() + 1 > settings->splitLogfileCount)
+        {
+            oldFiles.append(rotatedFiles.takeFirst());
+            fileNames.removeAll(oldFiles.last());
+        }
+
+        qfile.openMerge(fileNames);
+        for(int num = 0; num < oldFiles.size(); num++)
+            QFile::remove(oldFiles[num]);
+
+        reloadLogFile();
+    }
+    else
+    {
+        statusFilename->setText(QString("%1 (%2 files merged)").arg(outputfile.fileName()).arg(qfile.getMergeFileNames().size()));
+    }
+
+    rotationStart = QDateTime::currentDateTime();
+}
+
+QStringList MainWindow::getRotatedFiles()
+{
+    QStringList fileNames = qfile.getMergeFileNames();
+    QStringList files;
+
+    /* files split from an earlier log file are no longer part of the log */
+    for(int num = 0; num < rotatedFiles.size(); num++)
+    {
+        if(fileNames.contains(rotatedFiles[num]))
+            files.append(rotatedFiles[num]);
+    }
+
+    return files;
+}
+
+void MainWindow::removeRotatedFiles()
+{
+    QStringList files = getRotatedFiles();
+
+    qfile.closeMerge();
+    for(int num = 0; num < files.size(); num++)
+    {
+        if(!QFile::remove(files[num]))
+            qWarning() << "Cannot delete log file" << files[num];
+    }
+    rotatedFiles.clear();
+}
+
+void MainWindow::processNewMessages(int oldsize)
+{
+    QDltMsg qmsg;
+    PluginItem *item = 0;
+    QList<PluginItem*> activeViewerPlugins;
+    QList<PluginItem*> activeDecoderPlugins;
 
-            for(int i = 0; i < activeViewerPlugins.size(); i++){
-                item = (PluginItem*)activeViewerPlugins.at(i);
-                item->pluginviewerinterface->updateFileFinish();
+    for(int i = 0; i < project.plugin->topLevelItemCount(); i++)
+    {
+        item = (PluginItem*)project.plugin->topLevelItem(i);
+
+        if(item->getMode() != PluginItem::ModeDisable)
+        {
+            if(item->plugindecoderinterface)
+            {
+                activeDecoderPlugins.append(item);
+            }
+            if(item->pluginviewerinterface)
+            {
+                item->updateFileStart();
+                activeViewerPlugins.append(item);
             }
         }
     }
+
+
+    DecoderDispatch decoderDispatch;
+    decoderDispatch.setPlugins(activeDecoderPlugins);
+
+    /* update indexes  and table view */
+    for(int num=oldsize;num<qfile.size();num++) {
+        qmsg.setMsg(qfile.getMsg(num));
+
+        for(int i = 0; i < activeViewerPlugins.size(); i++){
+            item = (PluginItem*)activeViewerPlugins.at(i);
+            item->updateMsg(num,qmsg);
+        }
+
+        decoderDispatch.decodeMsg(qmsg,0);
+
+        if(qfile.checkFilter(qmsg)) {
+            qfile.addFilterIndex(num);
+        }
+
+        for(int i = 0; i < activeViewerPlugins.size(); i++){
+            item = (PluginItem*)activeViewerPlugins.at(i);
+            item->updateMsgDecoded(num,qmsg);
+        }
+    }
+    qfile.sortFilterIndex();
+
+    tableModel->modelChanged();
+    //Line below would resize the payload column automatically so that the whole content is readable
+    //ui->tableView->resizeColumnToContents(11); //Column 11 is the payload column
+    if(settings->autoScroll) {
+        ui->tableView->scrollToBottom();
+    }
+
+    for(int i = 0; i < activeViewerPlugins.size(); i++){
+        item = (PluginItem*)activeViewerPlugins.at(i);
+        item->updateFileFinish();
+        item->updateMsgRange(oldsize,qfile.size());
+    }
 }
 
 void MainWindow::on_tableView_clicked(QModelIndex index)
@@ -2462,16 +3043,9 @@ void MainWindow::on_tableView_clicked(QModelIndex index)
     }
 
 
-    for(int i = 0; i < activeDecoderPlugins.size(); i++)
-    {
-        item = (PluginItem*)activeDecoderPlugins.at(i);
-
-        if(item->plugindecoderinterface->isMsg(msg,0))
-        {
-            item->plugindecoderinterface->decodeMsg(msg,0);
-            break;
-        }
-    }
+    DecoderDispatch decoderDispatch;
+    decoderDispatch.setPlugins(activeDecoderPlugins);
+    decoderDispatch.decodeMsg(msg,0,msgIndex);
 
 
     for(int i = 0; i < activeViewerPlugins.size(); i++){
@@ -2751,6 +3325,7 @@ void MainWindow::controlMessage_SendControlMessage(EcuItem* ecuitem,DltMessage &
             qfile.addFilterIndex(num);
         }
     }
+    qfile.sortFilterIndex();
     tableModel->modelChanged();
     if(settings->autoScroll) {
         ui->tableView->scrollToBottom();
@@ -3437,6 +4012,11 @@ void MainWindow::on_action_menuHelp_Command_Line_triggered()
                              );
 }
 
+void MainWindow::on_action_menuHelp_Profiler_triggered(bool checked)
+{
+    profilerDock->setVisible(checked);
+}
+
 void MainWindow::on_pluginWidget_itemSelectionChanged()
 {
     QList<QTreeWidgetItem *> list = project.plugin->selectedItems();
@@ -3547,11 +4127,14 @@ void MainWindow::openRecentFile()
         }
 
         /* close existing file */
+        finishCapture();
         if(outputfile.isOpen())
             outputfile.close();
 
         /* open existing file and append new data */
         outputfile.setFileName(fileName);
+        stopExport();
+        qfile.closeMerge();
         outputfileIsTemporary = false;
         outputfileIsFromCLI = false;
 
@@ -3914,6 +4497,71 @@ void MainWindow::on_action_menuSearch_Find_triggered()
     searchDlg->selectText();
 }
 
+void MainWindow::on_action_menuSearch_Go_to_Time_triggered()
+{
+    QDltMsg msg;
+    QString text;
+    qint64 key;
+    bool ok;
+    int row;
+
+    if(qfile.sizeFilter() == 0)
+        return;
+
+    /* jumping to a time needs the time index */
+    if(qfile.getSortMode() == QDltFile::DltSortNone)
+    {
+        ui->action_menuFilter_Sort_by_Time->setChecked(true);
+        on_action_menuFilter_Sort_by_Time_triggered(true);
+    }
+
+    /* propose time of the selected message */
+    row = 0;
+    QModelIndexList list = ui->tableView->selectionModel()->selection().indexes();
+    if(list.count() > 0)
+        row = list.at(0).row();
+    qfile.getMsg(qfile.getMsgFilterPos(row), msg);
+
+    if(qfile.getSortMode() == QDltFile::DltSortTimestamp)
+    {
+        text = QInputDialog::getText(this, tr("Go to Time"), tr("Timestamp in seconds:"), QLineEdit::Normal,
+                                     QString("%1.%2").arg(msg.getTimestamp()/10000).arg(msg.getTimestamp()%10000,4,10,QLatin1Char('0')), &ok);
+        if(!ok || text.isEmpty())
+            return;
+
+        double seconds = text.toDouble(&ok);
+        key = (qint64)(seconds * 10000 + 0.5);
+    }
+    else
+    {
+        text = QInputDialog::getText(this, tr("Go to Time"), tr("Time (yyyy/MM/dd hh:mm:ss.uuuuuu):"), QLineEdit::Normal,
+                                     QString("%1.%2").arg(msg.getTimeString()).arg(msg.getMicroseconds(),6,10,QLatin1Char('0')), &ok);
+        if(!ok || text.isEmpty())
+            return;
+
+        QString fraction = text.section('.',1,1).left(6).leftJustified(6,'0');
+        QDateTime time = QDateTime::fromString(text.section('.',0,0).trimmed(), "yyyy/MM/dd hh:mm:ss");
+        ok = time.isValid();
+        key = (qint64)time.toTime_t() * 1000000 + fraction.toInt();
+    }
+
+    if(!ok)
+    {
+        QMessageBox::warning(0, QString("DLT Viewer"),
+                             QString("Invalid time \"%1\"").arg(text));
+        return;
+    }
+
+    /* behind the last message jumps to the last message */
+    row = qfile.findTime(key);
+    if(row < 0)
+        row = qfile.sizeFilter() - 1;
+
+    ui->tableView->selectRow(row);
+    ui->tableView->scrollTo(tableModel->index(row, 0), QAbstractItemView::PositionAtCenter);
+    on_tableView_clicked(tableModel->index(row, 0));
+}
+
 //----------------------------------------------------------------------------
 // Plugin functionalities
 //----------------------------------------------------------------------------
@@ -3978,6 +4626,17 @@ void MainWindow::loadPluginsPath(QDir dir)
                         item->pluginviewerinterface = pluginviewerinterface;
                         item->widget = item->pluginviewerinterface->initViewer();
 
+                        /* plugins reading in bulk are informed about ranges of messages */
+                        item->pluginviewerrangeinterface = qobject_cast<QDltPluginViewerRangeInterface *>(plugin);
+
+                        /* asynchronous viewer plugins get the messages from their own thread */
+                        item->pluginviewerasyncinterface = qobject_cast<QDltPluginViewerAsyncInterface *>(plugin);
+                        if(item->pluginviewerasyncinterface && !item->pluginviewerrangeinterface)
+                        {
+                            item->viewerQueue = new ViewerPluginQueue(item->getName(),pluginviewerinterface,item->pluginviewerasyncinterface,item);
+                            item->viewerQueue->start();
+                        }
+
                         if(item->widget)
                         {
                             //item->dockWidget = new QDockWidget(item->getName(),this);
@@ -3999,6 +4658,11 @@ void MainWindow::loadPluginsPath(QDir dir)
                     if(plugindecoderinterface)
                     {
                         item->plugindecoderinterface = plugindecoderinterface;
+                        item->plugindecoderbatchinterface = qobject_cast<QDLTPluginDecoderBatchInterface *>(plugin);
+
+                        QDltPluginThreadSafetyInterface *pluginthreadsafetyinterface = qobject_cast<QDltPluginThreadSafetyInterface *>(plugin);
+                        if(pluginthreadsafetyinterface)
+                            item->threadSafety = pluginthreadsafetyinterface->threadSafety();
                     }
                     QDltPluginControlInterface *plugincontrolinterface = qobject_cast<QDltPluginControlInterface *>(plugin);
                     if(plugincontrolinterface)
@@ -4159,7 +4823,7 @@ void MainWindow::processMsgAfterPluginmodeChange(PluginItem *item){
 #ifdef DEBUG_PERFORMANCE
         t.start();
 #endif
-        item->pluginviewerinterface->initFileStart(&qfile);
+        item->initFileStart(&qfile);
 
 #ifdef DEBUG_PERFORMANCE
         qDebug() << "Time for initFileStart: " << item->getName() << ": " << t.elapsed()/1000 << "s" ;
@@ -4195,6 +4859,8 @@ void MainWindow::processMsgAfterPluginmodeChange(PluginItem *item){
 
     QDltMsg msg;
     PluginItem *pitem;
+    DecoderDispatch decoderDispatch;
+    decoderDispatch.setPlugins(activeDecoderPlugins);
     for(int ix=0;ix<qfile.size();ix++)
     {
         /* Fill message from file */
@@ -4208,21 +4874,11 @@ void MainWindow::processMsgAfterPluginmodeChange(PluginItem *item){
         for(int ivp=0;ivp < activeViewerPlugins.size();ivp++)
         {
             pitem = (PluginItem*)activeViewerPlugins.at(ivp);
-            pitem->pluginviewerinterface->initMsg(ix, msg);
+            pitem->initMsg(ix, msg);
         }
 
         /* Process all decoderplugins */
-        for(int idp = 0; idp < activeDecoderPlugins.size();idp++)
-        {
-            pitem = (PluginItem*)activeDecoderPlugins.at(idp);
-            if(pitem->plugindecoderinterface->isMsg(msg, 0))
-            {
-                pitem->plugindecoderinterface->decodeMsg(msg, 0);
-                /* TODO: Do we, or do we not want to break here?
-                 * Perhaps user wants to stack multiple plugins */
-                break;
-            }
-        }
+        decoderDispatch.decodeMsg(msg,0);
 
         /* Add to filterindex if matches */
         if(qfile.checkFilter(msg))
@@ -4234,7 +4890,7 @@ void MainWindow::processMsgAfterPluginmodeChange(PluginItem *item){
         for(int ivp=0;ivp<activeViewerPlugins.size();ivp++)
         {
             pitem = (PluginItem *)activeViewerPlugins.at(ivp);
-            pitem->pluginviewerinterface->initMsgDecoded(ix, msg);
+            pitem->initMsgDecoded(ix, msg);
         }
 
         /* Update progress every 0.5% */
@@ -4251,6 +4907,7 @@ void MainWindow::processMsgAfterPluginmodeChange(PluginItem *item){
             break;
         }
     }
+    qfile.sortFilterIndex();
 
     if(item->pluginviewerinterface)
     {
@@ -4259,7 +4916,7 @@ void MainWindow::processMsgAfterPluginmodeChange(PluginItem *item){
         t.start();
 #endif
 
-        item->pluginviewerinterface->initFileFinish();
+        item->initFileFinish();
 
 #ifdef DEBUG_PERFORMANCE
         qDebug() << "Time for initFileFinish: " << item->getName() << ": " << t.elapsed()/1000 << "s" ;
@@ -4871,12 +5528,13 @@ void MainWindow::dropEvent(QDropEvent *event)
         QUrl url = event->mimeData()->urls()[0];
         filename = url.toLocalFile();
 
-        if(filename.endsWith(".dlt", Qt::CaseInsensitive))
+        if(filename.endsWith(".dlt", Qt::CaseInsensitive) || filename.endsWith(".dltz", Qt::CaseInsensitive) ||
+           filename.endsWith(".dlt.gz", Qt::CaseInsensitive))
         {
             /* DLT log file dropped */
-            openDltFile(filename);
             outputfileIsTemporary = false;
             outputfileIsFromCLI   = false;
+            openDltFile(filename);
         }
         else if(filename.endsWith(".dlp", Qt::CaseInsensitive))
         {
@@ -4937,20 +5595,10 @@ void MainWindow::on_filterWidget_itemClicked(QTreeWidgetItem *item, int column)
 }
 
 
-void MainWindow::iterateDecodersForMsg(QDltMsg &msg, int triggeredByUser)
+void MainWindow::iterateDecodersForMsg(QDltMsg &msg, int triggeredByUser, int index)
 {
-    for(int i = 0; i < project.plugin->topLevelItemCount (); i++)
-    {
-        PluginItem *item = (PluginItem*)project.plugin->topLevelItem(i);
-
-        if(item->getMode() != item->ModeDisable &&
-                item->plugindecoderinterface &&
-                item->plugindecoderinterface->isMsg(msg,triggeredByUser))
-        {
-            item->plugindecoderinterface->decodeMsg(msg,triggeredByUser);
-            break;
-        }
-    }
+    decoders.setPlugins(project.plugin);
+    decoders.decodeMsg(msg,triggeredByUser,index);
 }
 
 void MainWindow::on_action_menuConfig_Collapse_All_ECUs_triggered()
@@ -4990,3 +5638,34 @@ void MainWindow::on_action_menuFilter_Append_Filters_triggered()
     on_filterWidget_itemSelectionChanged();
 
 }
+
+void MainWindow::on_action_menuFilter_Sort_by_Time_triggered(bool checked)
+{
+    ui->action_menuFilter_Sort_by_Timestamp->setChecked(false);
+    setSortMode(checked ? QDltFile::DltSortStorageTime : QDltFile::DltSortNone);
+}
+
+void MainWindow::on_action_menuFilter_Sort_by_Timestamp_triggered(bool checked)
+{
+    ui->action_menuFilter_Sort_by_Time->setChecked(false);
+    setSortMode(checked ? QDltFile::DltSortTimestamp : QDltFile::DltSortNone);
+}
+
+void MainWindow::setSortMode(QDltFile::DltSortDef mode)
+{
+#ifdef DEBUG_PERFORMANCE
+    QTime t;
+    t.start();
+#endif
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    qfile.setSortMode(mode);
+    QApplication::restoreOverrideCursor();
+
+#ifdef DEBUG_PERFORMANCE
+    qDebug() << "Time to create time index: " << t.elapsed()/1000 << "s" ;
+#endif
+
+    ui->tableView->selectionModel()->clear();
+    tableModel->modelChanged();
+}
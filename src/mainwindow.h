@@ -25,6 +25,8 @@
 #include <QLabel>
 #include <QTimer>
 #include <QDir>
+#include <QProgressDialog>
+#include <QDateTime>
 
 #include "tablemodel.h"
 #include "project.h"
@@ -34,6 +36,10 @@
 #include "qdlt.h"
 #include "dltsettingsmanager.h"
 #include "filterdialog.h"
+#include "dltcapturemerger.h"
+#include "threadexport.h"
+#include "profilerwidget.h"
+#include "decoderdispatch.h"
 
 /**
  * When ecu items buffer size exceeds this while using
@@ -69,6 +75,20 @@ private:
 
     QDltControl qcontrol;
     QFile outputfile;
+    DltCaptureMerger captureMerger;
+    ThreadExport *exportThread;
+    QProgressDialog *exportProgress;
+    QDockWidget *profilerDock;
+    DecoderDispatch decoders;
+
+    /* Files split from the log file during a capture, oldest first */
+    QStringList rotatedFiles;
+    QString rotationBaseName;
+    int rotationNumber;
+    QDateTime rotationStart;
+    /* no further split is tried after a failed split until another log file is loaded */
+    bool rotationFailed;
+
     bool outputfileIsTemporary;
     bool outputfileIsFromCLI;
     TableModel *tableModel;
@@ -127,6 +147,7 @@ private:
     void reloadLogFile();
 
     void exportSelection(bool ascii,bool file);
+    void exportMsgs(const QVector<int> &positions,QFile &outfile);
 
     void ControlServiceRequest(EcuItem* ecuitem, int service_id );
     void SendInjection(EcuItem* ecuitem);
@@ -156,6 +177,17 @@ private:
     void connectECU(EcuItem *ecuitem,bool force = false);
     void disconnectECU(EcuItem *ecuitem);
     void read(EcuItem *ecuitem);
+    void flushCapture(bool all);
+    void flushCaptureEcu(const QString &ecuid);
+    void finishCapture();
+    void updateIndex();
+    int applyRetention();
+    void checkRotation();
+    void rotateLogFile();
+    QStringList getRotatedFiles();
+    void removeRotatedFiles();
+    void processNewMessages(int oldsize);
+    void stopExport();
 
     void updateRecentFileActions();
     void setCurrentFile(const QString &fileName);
@@ -175,18 +207,21 @@ private:
     void sendUpdates(EcuItem* ecuitem);
 
     void openDltFile(QString fileName);
+    void openMergedFiles(QStringList fileNames);
     bool openDlpFile(QString filename);
 
     void commandLineConvertToASCII();
 
     void commandLineExecutePlugin(QString plugin, QString cmd, QStringList params);
 
-    void iterateDecodersForMsg(QDltMsg &, int triggeredByUser);
+    void iterateDecodersForMsg(QDltMsg &, int triggeredByUser, int index = -1);
 
     QStringList getSerialPortsWithQextEnumartor();
 
     void processMsgAfterPluginmodeChange(PluginItem *item);
 
+    void setSortMode(QDltFile::DltSortDef mode);
+
 
 
 protected:
@@ -215,19 +250,23 @@ private slots:
     // File methods
     void on_action_menuFile_New_triggered();
     void on_action_menuFile_SaveAs_triggered();
+    void on_action_menuFile_SaveAs_Compressed_triggered();
     void on_action_menuFile_Import_DLT_Stream_with_Serial_Header_triggered();
     void on_action_menuFile_Export_Selection_triggered();
     void on_action_menuFile_Append_DLT_File_triggered();
     void on_action_menuFile_Export_Selection_ASCII_triggered();
     void on_action_menuFile_Export_ASCII_triggered();
+    void on_action_menuFile_Export_Filtered_triggered();
     void on_action_menuFile_Import_DLT_Stream_triggered();
     void on_action_menuFile_Quit_triggered();
     void on_action_menuFile_Settings_triggered();
     void on_action_menuFile_Clear_triggered();
     void on_action_menuFile_Open_triggered();
+    void on_action_menuFile_Open_Merged_triggered();
 
     // Search methods
     void on_action_menuSearch_Find_triggered();
+    void on_action_menuSearch_Go_to_Time_triggered();
 
     // Project methods
     void on_action_menuProject_Save_triggered();
@@ -237,6 +276,7 @@ private slots:
     // Help methods
     void on_action_menuHelp_Info_triggered();
     void on_action_menuHelp_Command_Line_triggered();
+    void on_action_menuHelp_Profiler_triggered(bool checked);
 
     // Config methods
     void on_action_menuConfig_Context_Delete_triggered();
@@ -277,6 +317,8 @@ private slots:
     void on_action_menuFilter_Clear_all_triggered();
     void on_action_menuFilter_Duplicate_triggered();
     void on_action_menuFilter_Append_Filters_triggered();
+    void on_action_menuFilter_Sort_by_Time_triggered(bool checked);
+    void on_action_menuFilter_Sort_by_Timestamp_triggered(bool checked);
 
     // Plugin methods
     void on_action_menuPlugin_Hide_triggered();
@@ -309,6 +351,7 @@ private slots:
 public slots:
     void sendInjection(int index,QString applicationId,QString contextId,int serviceId,QByteArray data);
     void threadpluginFinished();
+    void exportFinished();
 
 public:   
 
@@ -21,6 +21,7 @@
 
 #include "plugindialog.h"
 #include "ui_plugindialog.h"
+#include "project.h"
 
 PluginDialog::PluginDialog(QWidget *parent) :
     QDialog(parent),
@@ -73,8 +74,15 @@ QString PluginDialog::getFilename() {
 }
 
 void PluginDialog::on_toolButton_clicked() {
-    QString fileName = QFileDialog::getOpenFileName(this,
-        QString("Open ")+ui->lineEditName->text()+QString(" configuration file"), workingDirectory, tr("Plugin configuration (*.*)"));
+    QString fileName;
+
+    /* plugins can read the configuration from several files in a directory */
+    if(getType() == PluginItem::TypeDirectory)
+        fileName = QFileDialog::getExistingDirectory(this,
+            QString("Open ")+ui->lineEditName->text()+QString(" configuration directory"), workingDirectory);
+    else
+        fileName = QFileDialog::getOpenFileName(this,
+            QString("Open ")+ui->lineEditName->text()+QString(" configuration file"), workingDirectory, tr("Plugin configuration (*.*)"));
 
     if(fileName.isEmpty())
         return;
@@ -21,6 +21,8 @@
 #define PLUGININTERFACE_H
 
 #include <QString>
+#include <QList>
+#include <QVector>
 #include "dlt.h"
 #include "qdlt.h"
 
@@ -138,6 +140,8 @@ public:
     //! Decode the message and provide back the decoded message.
     /*!
       The plugin converts the DLT message.
+      The viewer caches decoded messages, the same message is not passed again
+      until a plugin is enabled, disabled or its configuration is loaded.
       Errors should be reported by providing an error message.
       \sa QDLTPluginInterface::error()
       \param msg The current DLT message and the decoded message information.
@@ -151,6 +155,113 @@ public:
 Q_DECLARE_INTERFACE(QDLTPluginDecoderInterface,
                     "org.genivi.DLT.Plugin.DLTViewerPluginDecoderInterface/1.0");
 
+//! A set of messages a decoder plugin is responsible for.
+/*!
+  A decoder plugin declares with claims which messages it may decode.
+  Messages not matching any claim of a plugin are not passed to the plugin at all.
+*/
+class QDltDecoderClaim
+{
+public:
+    //! The kind of the claim.
+    typedef enum { ClaimAll = 0, ClaimContext, ClaimMessageId, ClaimMessageType } ClaimTypeDef;
+
+    QDltDecoderClaim() : claimType(ClaimAll), messageId(0), messageType(QDltMsg::DltTypeUnknown) {}
+
+    //! All messages, the plugin is called for each message.
+    static QDltDecoderClaim all() { return QDltDecoderClaim(); }
+
+    //! Messages of an application and context.
+    /*!
+      \param apid the application id
+      \param ctid the context id, all contexts of the application if empty
+    */
+    static QDltDecoderClaim context(const QString &apid, const QString &ctid = QString())
+    { QDltDecoderClaim claim; claim.claimType = ClaimContext; claim.apid = apid; claim.ctid = ctid; return claim; }
+
+    //! Non-verbose messages with a message id.
+    /*!
+      The message id are the first four bytes of the payload of a non-verbose message.
+      \param id the message id
+    */
+    static QDltDecoderClaim nonVerboseId(unsigned int id)
+    { QDltDecoderClaim claim; claim.claimType = ClaimMessageId; claim.messageId = id; return claim; }
+
+    //! Messages of a message type, e.g. all network trace messages.
+    /*!
+      \param type the message type
+    */
+    static QDltDecoderClaim type(QDltMsg::DltTypeDef type)
+    { QDltDecoderClaim claim; claim.claimType = ClaimMessageType; claim.messageType = type; return claim; }
+
+    ClaimTypeDef claimType;
+    QString apid;
+    QString ctid;
+    unsigned int messageId;
+    QDltMsg::DltTypeDef messageType;
+};
+
+//! Extended DLT Viewer Plugin Interface used by decoder plugins, which decode batches of messages.
+/*!
+  This interface is optional and can be implemented by decoder plugins in addition to
+  the QDLTPluginDecoderInterface. The viewer builds a dispatch table from the claims of all
+  decoder plugins, so messages not matching a claim skip the plugin without any call.
+  Messages matching a claim are passed in batches where possible.
+*/
+class QDLTPluginDecoderBatchInterface
+{
+public:
+    //! The messages the plugin is responsible for.
+    /*!
+      The claims are requested again after each loadConfig() call.
+      An empty list means the plugin does not decode any message.
+      \return The list of claims.
+    */
+    virtual QList<QDltDecoderClaim> claims() = 0;
+
+    //! Decode a batch of messages.
+    /*!
+      All messages match at least one claim of the plugin. The plugin decodes the messages
+      it is responsible for and sets the decoded flag of these messages, as isMsg()
+      and decodeMsg() would do for each message.
+      \param msgs The messages to be decoded.
+      \param decoded The decoded flag of each message, all false when called.
+      \param triggeredByUser Reason for this method call was a user interaction with the GUI. 0 = not triggered by user, 1 = triggered by user
+    */
+    virtual void decodeMsgs(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser) = 0;
+};
+
+Q_DECLARE_INTERFACE(QDLTPluginDecoderBatchInterface,
+                    "org.genivi.DLT.Plugin.DLTViewerPluginDecoderBatchInterface/1.0");
+
+//! Optional DLT Viewer Plugin Interface declaring how a decoder plugin can be called from several threads.
+/*!
+  Filtering and export call the decoder plugins from worker threads, while the
+  table view calls them from the GUI thread. A plugin without this interface is
+  treated as ThreadSafetySerialized, the viewer never calls it concurrently.
+*/
+class QDltPluginThreadSafetyInterface
+{
+public:
+    //! The thread safety of a plugin.
+    /*!
+      ThreadSafetySerialized: the plugin may be called from any thread, but only from one at a time.
+      ThreadSafetyReentrant: the plugin may be called from several threads at the same time.
+      ThreadSafetyGuiThreadOnly: the plugin is only called from the GUI thread.
+    */
+    typedef enum { ThreadSafetySerialized = 0, ThreadSafetyReentrant, ThreadSafetyGuiThreadOnly } ThreadSafetyDef;
+
+    //! The thread safety of the decodeMsg(), isMsg() and decodeMsgs() calls of the plugin.
+    /*!
+      The value is requested once, when the plugin is loaded.
+      \return The thread safety of the plugin.
+    */
+    virtual ThreadSafetyDef threadSafety() = 0;
+};
+
+Q_DECLARE_INTERFACE(QDltPluginThreadSafetyInterface,
+                    "org.genivi.DLT.Plugin.DLTViewerPluginThreadSafetyInterface/1.0");
+
 //! Extended DLT Viewer Plugin Interface used by viewer plugins.
 /*!
   This is an extended DLT Plugin Interface.
@@ -268,6 +379,78 @@ public:
 Q_DECLARE_INTERFACE(QDltPluginViewerInterface,
                     "org.genivi.DLT.Plugin.DLTViewerPluginViewerInterface/1.1");
 
+//! Optional DLT Viewer Plugin Interface for viewer plugins receiving the messages in their own thread.
+/*!
+  Without this interface all calls of QDltPluginViewerInterface are made synchronously
+  from the GUI thread, so a slow viewer plugin slows down loading and live capture.
+
+  A viewer plugin implementing this interface gets the messages through a bounded queue
+  in batches from its own worker thread:
+  - initMsg(), initMsgDecoded(), updateFileStart(), updateMsg(), updateMsgDecoded() and
+    updateFileFinish() are called from the worker thread. updateFileStart() and
+    updateFileFinish() enclose each batch of received messages.
+  - initViewer(), initFileStart(), initFileFinish() and the selection calls are still made
+    from the GUI thread. initFileFinish() is called after all queued messages were delivered.
+  - The widgets of the plugin must only be changed in updateViewer(), which is called from
+    the GUI thread after messages were delivered, at most once per update interval.
+*/
+class QDltPluginViewerAsyncInterface
+{
+public:
+    //! Maximum number of messages queued for the plugin.
+    /*!
+      When the queue is full the viewer waits until the plugin processed messages.
+      \return The queue size in messages.
+    */
+    virtual int queueSize() = 0;
+
+    //! Minimum time between two calls of updateViewer().
+    /*!
+      \return The update interval in milliseconds.
+    */
+    virtual int updateInterval() = 0;
+
+    //! Update the widgets of the plugin with the messages delivered since the last call.
+    /*!
+      This function is called from the GUI thread.
+    */
+    virtual void updateViewer() = 0;
+};
+
+Q_DECLARE_INTERFACE(QDltPluginViewerAsyncInterface,
+                    "org.genivi.DLT.Plugin.DLTViewerPluginViewerAsyncInterface/1.0");
+
+//! Optional DLT Viewer Plugin Interface for viewer plugins reading the messages in bulk.
+/*!
+  A viewer plugin implementing this interface is not called for each message.
+  It is informed about ranges of messages instead and reads only the messages it
+  needs with QDltFile::findMsgs(), QDltFile::getColumn() and QDltFile::getPayloads()
+  from the file passed to initFileStart(). All calls are made from the GUI thread,
+  also if the plugin implements QDltPluginViewerAsyncInterface.
+*/
+class QDltPluginViewerRangeInterface
+{
+public:
+    //! The messages of a new log file can be read.
+    /*!
+      Called before initFileFinish() instead of initMsg() and initMsgDecoded() for each message.
+      \param begin number of the first message
+      \param end number behind the last message
+    */
+    virtual void initMsgRange(int begin, int end) = 0;
+
+    //! New messages were added to the log file.
+    /*!
+      Called instead of updateFileStart(), updateMsg(), updateMsgDecoded() and updateFileFinish().
+      \param begin number of the first new message
+      \param end number behind the last new message
+    */
+    virtual void updateMsgRange(int begin, int end) = 0;
+};
+
+Q_DECLARE_INTERFACE(QDltPluginViewerRangeInterface,
+                    "org.genivi.DLT.Plugin.DLTViewerPluginViewerRangeInterface/1.0");
+
 //! Extended DLT Control Plugin Interface used by control plugins.
 /*!
   This is an extended DLT Plugin Interface.
@@ -0,0 +1,163 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file profilerwidget.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QPushButton>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QFile>
+
+#include "profilerwidget.h"
+#include "qdlt.h"
+
+/* Columns of the counter list, the sort value of each column is stored in Qt::UserRole. */
+enum { ColumnName = 0, ColumnCalls, ColumnItems, ColumnTotal, ColumnAverage, ColumnP99, ColumnMax, ColumnRate, ColumnShare, ColumnCount };
+
+class ProfilerItem : public QTreeWidgetItem
+{
+public:
+    ProfilerItem(QTreeWidget *parent) : QTreeWidgetItem(parent) {}
+
+    bool operator<(const QTreeWidgetItem &other) const
+    {
+        int column = treeWidget()->sortColumn();
+        if(column == ColumnName)
+            return text(column) < other.text(column);
+        return data(column,Qt::UserRole).toDouble() < other.data(column,Qt::UserRole).toDouble();
+    }
+};
+
+static void setCounterValue(QTreeWidgetItem *item,int column,double value,int precision)
+{
+    item->setData(column,Qt::UserRole,value);
+    item->setText(column,QString::number(value,'f',precision));
+    item->setTextAlignment(column,Qt::AlignRight | Qt::AlignVCenter);
+}
+
+ProfilerWidget::ProfilerWidget(QWidget *parent) :
+    QWidget(parent)
+{
+    tree = new QTreeWidget(this);
+    tree->setRootIsDecorated(false);
+    tree->setColumnCount(ColumnCount);
+    tree->setHeaderLabels(QStringList() << "Stage" << "Calls" << "Items" << "Total ms" << "Avg us"
+                          << "p99 us" << "Max us" << "Items/s" << "Share %");
+    tree->setSortingEnabled(true);
+    tree->sortByColumn(ColumnTotal,Qt::DescendingOrder);
+
+    summary = new QLabel(this);
+
+    QPushButton *resetButton = new QPushButton("Reset",this);
+    QPushButton *saveButton = new QPushButton("Save JSON...",this);
+    connect(resetButton,SIGNAL(clicked()),this,SLOT(resetCounters()));
+    connect(saveButton,SIGNAL(clicked()),this,SLOT(saveJson()));
+
+    QHBoxLayout *buttons = new QHBoxLayout();
+    buttons->addWidget(summary,1);
+    buttons->addWidget(resetButton);
+    buttons->addWidget(saveButton);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0,0,0,0);
+    layout->addWidget(tree);
+    layout->addLayout(buttons);
+
+    timer.setInterval(1000);
+    connect(&timer,SIGNAL(timeout()),this,SLOT(updateCounters()));
+}
+
+void ProfilerWidget::showEvent(QShowEvent *event)
+{
+    QDltProfiler::instance()->setEnabled(true);
+    updateCounters();
+    timer.start();
+
+    QWidget::showEvent(event);
+}
+
+void ProfilerWidget::hideEvent(QHideEvent *event)
+{
+    timer.stop();
+    QDltProfiler::instance()->setEnabled(false);
+
+    QWidget::hideEvent(event);
+}
+
+void ProfilerWidget::updateCounters()
+{
+    QList<QDltProfiler::Counter> counters = QDltProfiler::instance()->getCounters();
+    qint64 elapsed = QDltProfiler::instance()->getElapsed();
+
+    tree->setSortingEnabled(false);
+
+    for(int num = 0; num < counters.size(); num++)
+    {
+        const QDltProfiler::Counter &counter = counters[num];
+
+        QTreeWidgetItem *item = items.value(counter.name);
+        if(!item)
+        {
+            item = new ProfilerItem(tree);
+            item->setText(ColumnName,counter.name);
+            items.insert(counter.name,item);
+        }
+
+        /* the rate is the processing rate of the stage itself, the share is its part of the wall time */
+        setCounterValue(item,ColumnCalls,counter.calls,0);
+        setCounterValue(item,ColumnItems,counter.items,0);
+        setCounterValue(item,ColumnTotal,counter.total / 1000000.0,1);
+        setCounterValue(item,ColumnAverage,counter.total / 1000.0 / counter.calls,2);
+        setCounterValue(item,ColumnP99,QDltProfiler::getPercentile(counter,0.99) / 1000.0,2);
+        setCounterValue(item,ColumnMax,counter.max / 1000.0,2);
+        setCounterValue(item,ColumnRate,counter.total ? counter.items * 1000000000.0 / counter.total : 0,0);
+        setCounterValue(item,ColumnShare,elapsed ? counter.total / 10000.0 / elapsed : 0,1);
+    }
+
+    tree->setSortingEnabled(true);
+
+    summary->setText(QString("Measured for %1 s").arg(elapsed / 1000));
+}
+
+void ProfilerWidget::resetCounters()
+{
+    QDltProfiler::instance()->clear();
+    tree->clear();
+    items.clear();
+    updateCounters();
+}
+
+void ProfilerWidget::saveJson()
+{
+    QString fileName = QFileDialog::getSaveFileName(this,
+                                                    tr("Save performance counters"), QString(), tr("JSON Files (*.json);;All files (*.*)"));
+
+    if(fileName.isEmpty())
+        return;
+
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(QDltProfiler::instance()->toJson()) < 0)
+    {
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("Cannot write file \"%1\"\n%2")
+                              .arg(fileName)
+                              .arg(file.errorString()));
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file profilerwidget.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef PROFILERWIDGET_H
+#define PROFILERWIDGET_H
+
+#include <QWidget>
+#include <QTreeWidget>
+#include <QLabel>
+#include <QTimer>
+#include <QMap>
+
+//! Panel showing the performance counters of the profiler.
+/*!
+  The counters are updated once per second. The profiler is only
+  enabled while the panel is visible.
+*/
+class ProfilerWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ProfilerWidget(QWidget *parent = 0);
+
+protected:
+    void showEvent(QShowEvent *event);
+    void hideEvent(QHideEvent *event);
+
+private slots:
+    void updateCounters();
+    void resetCounters();
+    void saveJson();
+
+private:
+    QTreeWidget *tree;
+    QLabel *summary;
+    QTimer timer;
+    QMap<QString,QTreeWidgetItem*> items;
+};
+
+#endif // PROFILERWIDGET_H
@@ -21,6 +21,7 @@
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include <QMessageBox>
+#include <QThread>
 
 #include "project.h"
 #include "dltsettingsmanager.h"
@@ -485,17 +486,26 @@ void MyPluginDockWidget::closeEvent(QCloseEvent *event)
 
 
 
+int PluginItem::generation = 0;
+volatile bool PluginItem::guiThreadBlocked = false;
+
 PluginItem::PluginItem(QTreeWidgetItem *parent)
     : QTreeWidgetItem(parent,plugin_type)
 {
     plugininterface = 0;
     plugindecoderinterface = 0;
+    plugindecoderbatchinterface = 0;
     pluginviewerinterface = 0;
+    pluginviewerasyncinterface = 0;
+    pluginviewerrangeinterface = 0;
     plugincontrolinterface = 0;
     plugincommandinterface = 0;
+    threadSafety = QDltPluginThreadSafetyInterface::ThreadSafetySerialized;
 
     widget = 0;
     dockWidget = 0;
+    viewerQueue = 0;
+    viewerFile = 0;
 
     mode = ModeShow;
     type = 0;
@@ -511,6 +521,11 @@ void PluginItem::update()
     QStringList types;
     QStringList list = plugininterface->infoConfig();
 
+    /* the configuration may have changed the claims */
+    if(plugindecoderbatchinterface)
+        claims = plugindecoderbatchinterface->claims();
+    generation++;
+
     if(pluginviewerinterface)
         types << "View";
     if(plugindecoderinterface)
@@ -548,6 +563,196 @@ QString PluginItem::getName(){
 }
 void PluginItem::setName(QString n){
     name = n;
+    profileIsMsg = QString("isMsg: %1").arg(name);
+    profileDecodeMsg = QString("decodeMsg: %1").arg(name);
+    profileDecodeMsgs = QString("decodeMsgs: %1").arg(name);
+}
+
+bool PluginItem::decodeMsg(QDltMsg &msg, int triggeredByUser)
+{
+    if(threadSafety == QDltPluginThreadSafetyInterface::ThreadSafetyGuiThreadOnly && QThread::currentThread() != thread())
+    {
+        QList<QDltMsg*> msgs;
+        QVector<bool> decoded(1,false);
+        msgs.append(&msg);
+        decodeMsgsInGuiThread(msgs,decoded,triggeredByUser);
+        return decoded[0];
+    }
+
+    /* a null mutex is not locked, only serialized plugins need the lock */
+    QMutexLocker locker(threadSafety == QDltPluginThreadSafetyInterface::ThreadSafetySerialized ? &decoderMutex : 0);
+    return decodeMsgUnlocked(msg,triggeredByUser);
+}
+
+void PluginItem::decodeMsgs(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser)
+{
+    if(threadSafety == QDltPluginThreadSafetyInterface::ThreadSafetyGuiThreadOnly && QThread::currentThread() != thread())
+    {
+        decodeMsgsInGuiThread(msgs,decoded,triggeredByUser);
+        return;
+    }
+
+    QMutexLocker locker(threadSafety == QDltPluginThreadSafetyInterface::ThreadSafetySerialized ? &decoderMutex : 0);
+    decodeMsgsUnlocked(msgs,decoded,triggeredByUser);
+}
+
+bool PluginItem::decodeMsgUnlocked(QDltMsg &msg, int triggeredByUser)
+{
+    QDltProfilerScope isMsgProfile(profileIsMsg);
+    if(!plugindecoderinterface->isMsg(msg,triggeredByUser))
+        return false;
+    isMsgProfile.stop();
+
+    QDltProfilerScope decodeMsgProfile(profileDecodeMsg);
+    plugindecoderinterface->decodeMsg(msg,triggeredByUser);
+
+    return true;
+}
+
+void PluginItem::decodeMsgsUnlocked(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser)
+{
+    if(!plugindecoderbatchinterface)
+    {
+        for(int num=0;num<msgs.size();num++)
+            decoded[num] = decodeMsgUnlocked(*msgs[num],triggeredByUser);
+        return;
+    }
+
+    QDltProfilerScope profile(profileDecodeMsgs,msgs.size());
+    plugindecoderbatchinterface->decodeMsgs(msgs,decoded,triggeredByUser);
+}
+
+bool PluginItem::decodeMsgsInGuiThread(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser)
+{
+    QSemaphore done;
+    GuiCall call;
+    call.msgs = &msgs;
+    call.decoded = &decoded;
+    call.triggeredByUser = triggeredByUser;
+    call.pending = true;
+    call.done = &done;
+
+    guiCallsMutex.lock();
+    guiCalls.append(&call);
+    guiCallsMutex.unlock();
+    QMetaObject::invokeMethod(this,"processGuiCalls",Qt::QueuedConnection);
+
+    while(!done.tryAcquire(1,50))
+    {
+        if(!guiThreadBlocked)
+            continue;
+
+        /* the GUI thread waits for this thread, drop the call if it was not started yet */
+        QMutexLocker locker(&guiCallsMutex);
+        if(call.pending)
+        {
+            guiCalls.removeAll(&call);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void PluginItem::processGuiCalls()
+{
+    forever
+    {
+        guiCallsMutex.lock();
+        if(guiCalls.isEmpty())
+        {
+            guiCallsMutex.unlock();
+            break;
+        }
+        GuiCall *call = guiCalls.takeFirst();
+        call->pending = false;
+        guiCallsMutex.unlock();
+
+        decodeMsgsUnlocked(*call->msgs,*call->decoded,call->triggeredByUser);
+        call->done->release();
+    }
+}
+
+void PluginItem::initFileStart(QDltFile *file)
+{
+    viewerFile = file;
+
+    if(viewerQueue)
+        viewerQueue->clear();
+
+    pluginviewerinterface->initFileStart(file);
+}
+
+void PluginItem::initMsg(int index, QDltMsg &msg)
+{
+    if(pluginviewerrangeinterface)
+        return;
+
+    if(viewerQueue)
+        viewerMsg = msg;
+    else
+        pluginviewerinterface->initMsg(index,msg);
+}
+
+void PluginItem::initMsgDecoded(int index, QDltMsg &msg)
+{
+    if(pluginviewerrangeinterface)
+        return;
+
+    if(viewerQueue)
+        viewerQueue->addInitMsg(index,viewerMsg,msg);
+    else
+        pluginviewerinterface->initMsgDecoded(index,msg);
+}
+
+void PluginItem::initFileFinish()
+{
+    if(pluginviewerrangeinterface && viewerFile)
+        pluginviewerrangeinterface->initMsgRange(0,viewerFile->size());
+    else if(viewerQueue)
+        viewerQueue->flush();
+
+    pluginviewerinterface->initFileFinish();
+}
+
+void PluginItem::updateFileStart()
+{
+    if(!viewerQueue && !pluginviewerrangeinterface)
+        pluginviewerinterface->updateFileStart();
+}
+
+void PluginItem::updateMsg(int index, QDltMsg &msg)
+{
+    if(pluginviewerrangeinterface)
+        return;
+
+    if(viewerQueue)
+        viewerMsg = msg;
+    else
+        pluginviewerinterface->updateMsg(index,msg);
+}
+
+void PluginItem::updateMsgDecoded(int index, QDltMsg &msg)
+{
+    if(pluginviewerrangeinterface)
+        return;
+
+    if(viewerQueue)
+        viewerQueue->addUpdateMsg(index,viewerMsg,msg);
+    else
+        pluginviewerinterface->updateMsgDecoded(index,msg);
+}
+
+void PluginItem::updateFileFinish()
+{
+    if(!viewerQueue && !pluginviewerrangeinterface)
+        pluginviewerinterface->updateFileFinish();
+}
+
+void PluginItem::updateMsgRange(int begin, int end)
+{
+    if(pluginviewerrangeinterface && begin < end)
+        pluginviewerrangeinterface->updateMsgRange(begin,end);
 }
 
 QString PluginItem::getPluginVersion(){
@@ -585,6 +790,7 @@ int PluginItem::getMode(){
 void PluginItem::setMode(int m){
 
     mode = m;
+    generation++;
 
 }
 
@@ -28,6 +28,8 @@
 #include <QDockWidget>
 #include <QObject>
 #include <QDateTime>
+#include <QMutex>
+#include <QSemaphore>
 #include <qextserialport.h>
 #include "settingsdialog.h"
 
@@ -38,6 +40,7 @@ extern "C"
 }
 
 #include "plugininterface.h"
+#include "viewerpluginqueue.h"
 
 #define DLT_VIEWER_BUFFER_SIZE 256000
 #define RCVBUFSIZE 128000   /* Size of receive buffer */
@@ -250,20 +253,153 @@ public:
     void savePluginModeToSettings();
     int getPluginModeFromSettings();
 
+    //! Decode a message with the decoder plugin, if the plugin is responsible for the message.
+    /*!
+      The time of the isMsg() and decodeMsg() calls of the plugin is measured by the profiler.
+      The call is serialized or passed to the GUI thread as declared by the thread safety of the plugin.
+      \param msg the message to be decoded
+      \param triggeredByUser passed to the plugin
+      \return true if the message was decoded by the plugin
+    */
+    bool decodeMsg(QDltMsg &msg, int triggeredByUser);
+
+    //! Decode a batch of messages with the decoder plugin.
+    /*!
+      Plugins without QDLTPluginDecoderBatchInterface are called for each message.
+      \param msgs the messages to be decoded
+      \param decoded set to true for each message decoded by the plugin
+      \param triggeredByUser passed to the plugin
+    */
+    void decodeMsgs(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser);
+
+    //! Pass the opened log file to the viewer plugin.
+    /*!
+      Messages still queued for an asynchronous viewer plugin are dropped.
+      \param file the opened log file
+    */
+    void initFileStart(QDltFile *file);
+
+    //! Pass an undecoded message of the opened log file to the viewer plugin.
+    /*!
+      For an asynchronous viewer plugin the message is queued together with the decoded message.
+      \param index the number of the message in the log file
+      \param msg the undecoded message
+    */
+    void initMsg(int index, QDltMsg &msg);
+
+    //! Pass a decoded message of the opened log file to the viewer plugin.
+    /*!
+      \param index the number of the message in the log file
+      \param msg the decoded message
+    */
+    void initMsgDecoded(int index, QDltMsg &msg);
+
+    //! All messages of the opened log file were passed to the viewer plugin.
+    /*!
+      Waits until an asynchronous viewer plugin processed all queued messages.
+    */
+    void initFileFinish();
+
+    //! New messages are passed to the viewer plugin, asynchronous plugins are called for each batch instead.
+    void updateFileStart();
+
+    //! Pass an undecoded received message to the viewer plugin.
+    /*!
+      \param index the number of the message in the log file
+      \param msg the undecoded message
+    */
+    void updateMsg(int index, QDltMsg &msg);
+
+    //! Pass a decoded received message to the viewer plugin.
+    /*!
+      \param index the number of the message in the log file
+      \param msg the decoded message
+    */
+    void updateMsgDecoded(int index, QDltMsg &msg);
+
+    //! All new messages were passed to the viewer plugin, asynchronous plugins are called for each batch instead.
+    void updateFileFinish();
+
+    //! New messages were added to the log file, only passed to plugins reading the messages in bulk.
+    /*!
+      \param begin number of the first new message
+      \param end number behind the last new message
+    */
+    void updateMsgRange(int begin, int end);
+
+    //! The claims of a batch decoder plugin, requested when the item is updated.
+    QList<QDltDecoderClaim> getClaims() { return claims; }
+
+    //! Changed each time the configuration or mode of any plugin is updated.
+    static int getGeneration() { return generation; }
+
+    //! Set while the GUI thread waits for a worker thread.
+    /*!
+      Calls of a GUI thread only plugin which are still queued are dropped while the flag is set,
+      the messages stay undecoded instead of blocking the viewer.
+      \param blocked true before the GUI thread starts waiting, false afterwards
+    */
+    static void setGuiThreadBlocked(bool blocked) { guiThreadBlocked = blocked; }
+
     QDLTPluginInterface *plugininterface;
     QDLTPluginDecoderInterface *plugindecoderinterface;
+    QDLTPluginDecoderBatchInterface *plugindecoderbatchinterface;
     QDltPluginViewerInterface  *pluginviewerinterface;
+    QDltPluginViewerAsyncInterface *pluginviewerasyncinterface;
+    QDltPluginViewerRangeInterface *pluginviewerrangeinterface;
     QDltPluginControlInterface *plugincontrolinterface;
     QDltPluginCommandInterface *plugincommandinterface;
     QWidget *widget;
     MyPluginDockWidget *dockWidget;
 
+    /* delivers the messages to an asynchronous viewer plugin, 0 for synchronous plugins */
+    ViewerPluginQueue *viewerQueue;
+
+    /* declared by QDltPluginThreadSafetyInterface, ThreadSafetySerialized if not implemented */
+    QDltPluginThreadSafetyInterface::ThreadSafetyDef threadSafety;
+
+private slots:
+    void processGuiCalls();
+
 private:
+    /* a decoder call passed from a worker thread to the GUI thread */
+    typedef struct
+    {
+        QList<QDltMsg*> *msgs;
+        QVector<bool> *decoded;
+        int triggeredByUser;
+        bool pending;
+        QSemaphore *done;
+    } GuiCall;
+
+    bool decodeMsgUnlocked(QDltMsg &msg, int triggeredByUser);
+    void decodeMsgsUnlocked(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser);
+    bool decodeMsgsInGuiThread(QList<QDltMsg*> &msgs, QVector<bool> &decoded, int triggeredByUser);
+
     QString name;
     QString pluginVersion;
     QString pluginInterfaceVersion;
     QString filename;
 
+    /* names of the profiler counters */
+    QString profileIsMsg;
+    QString profileDecodeMsg;
+    QString profileDecodeMsgs;
+
+    QList<QDltDecoderClaim> claims;
+    static int generation;
+
+    QMutex decoderMutex;
+
+    /* the undecoded message of the last initMsg() or updateMsg() call of an asynchronous plugin */
+    QDltMsg viewerMsg;
+
+    /* the file passed to initFileStart() */
+    QDltFile *viewerFile;
+    QMutex guiCallsMutex;
+    QList<GuiCall*> guiCalls;
+    static volatile bool guiThreadBlocked;
+
     int type;
     int mode;
 
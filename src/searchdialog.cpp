@@ -91,6 +91,7 @@ void SearchDialog::setSearchColour(QLineEdit *lineEdit,int result)
 
 int SearchDialog::find()
 {
+    QDltProfilerScope profile("Search");
     QRegExp searchTextRegExp;
     QDltMsg msg;
     QByteArray buf;
@@ -102,6 +103,8 @@ int SearchDialog::find()
     if(file->sizeFilter()==0)
             return 0;
 
+    decoders.setPlugins(plugin);
+
     //setSearchColour(QColor(0,0,0),QColor(255,255,255));
 
     if(getMatch() || getSearchFromBeginning()==false){
@@ -186,23 +189,14 @@ int SearchDialog::find()
         /* get the message with the selected item id */
         buf = file->getMsgFilter(searchLine);
         msg.setMsg(buf);
-        for(int num2 = 0; num2 < plugin->topLevelItemCount (); num2++)
-        {
-            PluginItem *item = (PluginItem*)plugin->topLevelItem(num2);
-
-            if(item->getMode() != item->ModeDisable && item->plugindecoderinterface && item->plugindecoderinterface->isMsg(msg,1))
-            {
-                item->plugindecoderinterface->decodeMsg(msg,1);
-                break;
-            }
-        }
+        decoders.decodeMsg(msg,1,file->getMsgFilterPos(searchLine));
 
         bool pluginFound = false;
 
         /* search header */
         if(!pluginFound || text.isEmpty())
         {
-            text += msg.toStringHeader();
+            msg.toStringHeader(text);
         }
 
         if(getHeader())
@@ -238,7 +232,7 @@ int SearchDialog::find()
         text.clear();
         if(!pluginFound || text.isEmpty())
         {
-            text += msg.toStringPayload();
+            msg.toStringPayload(text);
         }
 
         if(getPayload())
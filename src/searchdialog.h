@@ -24,6 +24,7 @@
 #include "qdlt.h"
 #include <QTableView>
 #include <QTreeWidget>
+#include "decoderdispatch.h"
 namespace Ui {
     class SearchDialog;
 }
@@ -77,6 +78,9 @@ public:
     QTreeWidget *plugin;
     QList<QLineEdit*> *lineEdits;
 
+private:
+    DecoderDispatch decoders;
+
 private slots:
     void on_lineEditText_textEdited(QString newText);
     void on_pushButtonPrevious_clicked();
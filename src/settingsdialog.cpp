@@ -282,6 +282,16 @@ void SettingsDialog::writeDlg()
 
     /* other */
     ui->checkBoxWriteControl->setCheckState(writeControl?Qt::Checked:Qt::Unchecked);
+    ui->checkBoxMergeCapture->setCheckState(mergeCapture?Qt::Checked:Qt::Unchecked);
+    ui->checkBoxMergeCaptureTimestamp->setCheckState(mergeCaptureTimestamp?Qt::Checked:Qt::Unchecked);
+    ui->spinBoxMergeCaptureWindow->setValue(mergeCaptureWindow);
+    ui->checkBoxSplitLogfile->setCheckState(splitLogfile?Qt::Checked:Qt::Unchecked);
+    ui->spinBoxSplitLogfileSize->setValue(splitLogfileSize);
+    ui->spinBoxSplitLogfileDuration->setValue(splitLogfileDuration);
+    ui->spinBoxSplitLogfileCount->setValue(splitLogfileCount);
+    ui->checkBoxLiveRetention->setCheckState(liveRetention?Qt::Checked:Qt::Unchecked);
+    ui->spinBoxLiveRetentionCount->setValue(liveRetentionCount);
+    ui->spinBoxLiveRetentionDuration->setValue(liveRetentionDuration);
 }
 
 void SettingsDialog::readDlg()
@@ -333,6 +343,16 @@ void SettingsDialog::readDlg()
 
     /* other */
     writeControl = (ui->checkBoxWriteControl->checkState() == Qt::Checked);
+    mergeCapture = (ui->checkBoxMergeCapture->checkState() == Qt::Checked);
+    mergeCaptureTimestamp = (ui->checkBoxMergeCaptureTimestamp->checkState() == Qt::Checked);
+    mergeCaptureWindow = ui->spinBoxMergeCaptureWindow->value();
+    splitLogfile = (ui->checkBoxSplitLogfile->checkState() == Qt::Checked);
+    splitLogfileSize = ui->spinBoxSplitLogfileSize->value();
+    splitLogfileDuration = ui->spinBoxSplitLogfileDuration->value();
+    splitLogfileCount = ui->spinBoxSplitLogfileCount->value();
+    liveRetention = (ui->checkBoxLiveRetention->checkState() == Qt::Checked);
+    liveRetentionCount = ui->spinBoxLiveRetentionCount->value();
+    liveRetentionDuration = ui->spinBoxLiveRetentionDuration->value();
 
 }
 
@@ -387,6 +407,16 @@ void SettingsDialog::writeSettings(QMainWindow *mainwindow)
 
     /* other */
     settings->setValue("startup/writeControl",writeControl);
+    settings->setValue("startup/mergeCapture",mergeCapture);
+    settings->setValue("startup/mergeCaptureTimestamp",mergeCaptureTimestamp);
+    settings->setValue("startup/mergeCaptureWindow",mergeCaptureWindow);
+    settings->setValue("startup/splitLogfile",splitLogfile);
+    settings->setValue("startup/splitLogfileSize",splitLogfileSize);
+    settings->setValue("startup/splitLogfileDuration",splitLogfileDuration);
+    settings->setValue("startup/splitLogfileCount",splitLogfileCount);
+    settings->setValue("startup/liveRetention",liveRetention);
+    settings->setValue("startup/liveRetentionCount",liveRetentionCount);
+    settings->setValue("startup/liveRetentionDuration",liveRetentionDuration);
 
     /* For settings integrity validation */
     settings->setValue("startup/versionMajor", QString(PACKAGE_MAJOR_VERSION).toInt());
@@ -442,6 +472,16 @@ void SettingsDialog::readSettings()
 
     /* other */
     writeControl = settings->value("startup/writeControl",1).toInt();
+    mergeCapture = settings->value("startup/mergeCapture",0).toInt();
+    mergeCaptureTimestamp = settings->value("startup/mergeCaptureTimestamp",1).toInt();
+    mergeCaptureWindow = settings->value("startup/mergeCaptureWindow",500).toInt();
+    splitLogfile = settings->value("startup/splitLogfile",0).toInt();
+    splitLogfileSize = settings->value("startup/splitLogfileSize",1024).toInt();
+    splitLogfileDuration = settings->value("startup/splitLogfileDuration",0).toInt();
+    splitLogfileCount = settings->value("startup/splitLogfileCount",0).toInt();
+    liveRetention = settings->value("startup/liveRetention",0).toInt();
+    liveRetentionCount = settings->value("startup/liveRetentionCount",1000000).toInt();
+    liveRetentionDuration = settings->value("startup/liveRetentionDuration",0).toInt();
 }
 
 
@@ -55,6 +55,16 @@ public:
     int autoMarkFatalError;
     int autoMarkWarn;
     int writeControl;
+    int mergeCapture;
+    int mergeCaptureTimestamp;
+    int mergeCaptureWindow;
+    int splitLogfile;
+    int splitLogfileSize;
+    int splitLogfileDuration;
+    int splitLogfileCount;
+    int liveRetention;
+    int liveRetentionCount;
+    int liveRetentionDuration;
 
     int fontSize;
     int showIndex;
@@ -55,7 +55,14 @@ SOURCES += main.cpp \
     filtertreewidget.cpp \
     threaddltindex.cpp \
     threadfilter.cpp \
-    dltfileutils.cpp
+    threadexport.cpp \
+    dltfileutils.cpp \
+    dltcapturemerger.cpp \
+    dltconverter.cpp \
+    profilerwidget.cpp \
+    decoderdispatch.cpp \
+    decodedmsgcache.cpp \
+    viewerpluginqueue.cpp
 
 HEADERS += mainwindow.h \
     project.h \
@@ -76,7 +83,14 @@ HEADERS += mainwindow.h \
     filtertreewidget.h \
     threaddltindex.h \
     threadfilter.h \
-    dltfileutils.h
+    threadexport.h \
+    dltfileutils.h \
+    dltcapturemerger.h \
+    dltconverter.h \
+    profilerwidget.h \
+    decoderdispatch.h \
+    decodedmsgcache.h \
+    viewerpluginqueue.h
 
 FORMS += mainwindow.ui \
     ecudialog.ui \
@@ -42,6 +42,7 @@ char buffer[DLT_VIEWER_LIST_BUFFER_SIZE];
 
  QVariant TableModel::data(const QModelIndex &index, int role) const
  {
+     QDltProfilerScope profile("Table data");
      QDltMsg msg;
      QByteArray buf;
 
@@ -55,22 +56,14 @@ char buffer[DLT_VIEWER_LIST_BUFFER_SIZE];
      {
          /* get the message with the selected item id */
          qfile->getMsg(qfile->getMsgFilterPos(index.row()), msg); // getMsg can be better optimized than the two single calls
-         for(int num = 0; num < project->plugin->topLevelItemCount (); num++)
-         {
-             PluginItem *item = (PluginItem*)project->plugin->topLevelItem(num);
-
-             if(item->getMode() != item->ModeDisable && item->plugindecoderinterface && item->plugindecoderinterface->isMsg(msg,0))
-             {
-                 item->plugindecoderinterface->decodeMsg(msg,0);
-                 break;
-             }
-         }
+         decoders.setPlugins(project->plugin);
+         decoders.decodeMsg(msg,0,qfile->getMsgFilterPos(index.row()));
 
          switch(index.column())
          {
          case 0:
              /* display index */
-             return QString("%1").arg(qfile->getMsgFilterPos(index.row()));
+             return QString("%1").arg(qfile->getMsgNumber(qfile->getMsgFilterPos(index.row())));
          case 1:
              if( project->settings->automaticTimeSettings == 0 )
                 return QString("%1.%2").arg(msg.getGmTimeWithOffsetString(project->settings->utcOffset,project->settings->dst)).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'));
@@ -160,16 +153,8 @@ char buffer[DLT_VIEWER_LIST_BUFFER_SIZE];
 
      if ( role == Qt::BackgroundRole ) {
          qfile->getMsg(qfile->getMsgFilterPos(index.row()), msg); // getMsg can be better optimized than the two single calls
-         for(int num = 0; num < project->plugin->topLevelItemCount (); num++)
-         {
-             PluginItem *item = (PluginItem*)project->plugin->topLevelItem(num);
-
-             if(item->getMode() != item->ModeDisable && item->plugindecoderinterface && item->plugindecoderinterface->isMsg(msg,0))
-             {
-                 item->plugindecoderinterface->decodeMsg(msg,0);
-                 break;
-             }
-         }
+         decoders.setPlugins(project->plugin);
+         decoders.decodeMsg(msg,0,qfile->getMsgFilterPos(index.row()));
 
          QColor color = qfile->checkMarker(msg);
          if(color.isValid())
@@ -27,6 +27,7 @@
 
 #include "project.h"
 #include "qdlt.h"
+#include "decoderdispatch.h"
 
 #define DLT_VIEWER_LIST_BUFFER_SIZE 100024
 
@@ -55,6 +56,10 @@ public:
     Project *project;
     void modelChanged();
 
+private:
+    /* dispatch table of the enabled decoder plugins, rebuilt when a plugin changes */
+    mutable DecoderDispatch decoders;
+
 };
 
 #endif // TABLEMODEL_H
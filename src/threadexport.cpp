@@ -0,0 +1,145 @@
+#include "threadexport.h"
+#include <QtConcurrentMap>
+
+/* Number of messages formatted by one worker job. */
+#define EXPORT_BLOCK_SIZE 1024
+
+ThreadExportFormatter::ThreadExportFormatter(QDltFile *_qDltFile, const QVector<int> *_positions, DecoderDispatch *_decoders) :
+    qDltFile(_qDltFile), positions(_positions), decoders(_decoders)
+{
+}
+
+QByteArray ThreadExportFormatter::operator()(const QPair<int,int> &block) const
+{
+    QVector<QDltMsg> msgs(block.second-block.first);
+    QString text;
+    QByteArray buffer;
+
+    for(int num=block.first;num<block.second;num++)
+        msgs[num-block.first].setMsg(qDltFile->getMsg(positions->at(num)));
+
+    /* decode the messages of the block at once, each plugin is locked as declared by its thread safety */
+    if(!decoders->isEmpty())
+    {
+        QList<QDltMsg*> batch;
+        QVector<int> indexes;
+        for(int num=0;num<msgs.size();num++) {
+            batch.append(&msgs[num]);
+            indexes.append(positions->at(block.first+num));
+        }
+
+        decoders->decodeMsgs(batch,1,indexes);
+    }
+
+    for(int num=block.first;num<block.second;num++) {
+        QDltMsg &msg = msgs[num-block.first];
+
+        /* get message ASCII text */
+        text.clear();
+        QDlt::appendSignedNumber(text,qDltFile->getMsgNumber(positions->at(num)));
+        text += QLatin1Char(' ');
+        msg.toStringHeader(text);
+        text += QLatin1Char(' ');
+        msg.toStringPayload(text);
+        text += QLatin1Char('\n');
+
+        buffer += text.toAscii();
+    }
+
+    return buffer;
+}
+
+ThreadExport::ThreadExport(QObject *parent) :
+    QThread(parent), qDltFile(0), count(0), stopExecution(false)
+{
+}
+
+void ThreadExport::stopProcessMsg(){
+    stopExecution = true;
+}
+
+int ThreadExport::nextBlocks(QList<QPair<int,int> > &blocks, int pos)
+{
+    int jobs = qMax(QThread::idealThreadCount(),1) * 4;
+
+    blocks.clear();
+    for(int num=0;num<jobs && pos<positions.size();num++) {
+        int end = qMin(pos+EXPORT_BLOCK_SIZE,positions.size());
+        blocks.append(qMakePair(pos,end));
+        pos = end;
+    }
+
+    return pos;
+}
+
+void ThreadExport::run(){
+    QList<QPair<int,int> > current,next;
+    QFuture<QByteArray> currentTexts,nextTexts;
+    int pos;
+
+    count = 0;
+    error.clear();
+
+    if(!qDltFile)
+    {
+        error = "No log file loaded";
+        return;
+    }
+
+    QFile outfile(fileName);
+    if(!outfile.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        error = outfile.errorString();
+        return;
+    }
+
+    ThreadExportFormatter formatter(qDltFile,&positions,&decoders);
+
+    pos = nextBlocks(current,0);
+    if(!current.isEmpty())
+        currentTexts = QtConcurrent::mapped(current,formatter);
+
+    while(!current.isEmpty()) {
+        currentTexts.waitForFinished();
+
+        /* format the next blocks while the current ones are written */
+        next.clear();
+        if(!stopExecution)
+            pos = nextBlocks(next,pos);
+        if(!next.isEmpty())
+            nextTexts = QtConcurrent::mapped(next,formatter);
+
+        QList<QByteArray> texts = currentTexts.results();
+        for(int num=0;num<texts.size() && error.isEmpty();num++) {
+            if(outfile.write(texts[num]) != texts[num].size())
+            {
+                error = outfile.errorString();
+                stopExecution = true;
+            }
+        }
+
+        count = current.last().second;
+        emit percentageComplete(count);
+
+        current = next;
+        currentTexts = nextTexts;
+    }
+
+    outfile.close();
+}
+
+void ThreadExport::setQDltFile(QDltFile *_qDltFile){
+    this->qDltFile=_qDltFile;
+}
+
+void ThreadExport::setActiveDecoderPlugins(QList<PluginItem*> _activeDecoderPlugins){
+    decoders.setPlugins(_activeDecoderPlugins);
+}
+
+void ThreadExport::setPositions(const QVector<int> &_positions){
+    positions=_positions;
+}
+
+void ThreadExport::setFileName(QString _fileName){
+    fileName=_fileName;
+}
@@ -0,0 +1,70 @@
+#ifndef THREADEXPORT_H
+#define THREADEXPORT_H
+
+#include <QtCore>
+#include "qdlt.h"
+#include "project.h"
+#include "plugininterface.h"
+#include "decoderdispatch.h"
+
+//! Format the messages of one block of the export, called in parallel by the worker threads.
+class ThreadExportFormatter
+{
+public:
+    typedef QByteArray result_type;
+
+    ThreadExportFormatter(QDltFile *_qDltFile, const QVector<int> *_positions, DecoderDispatch *_decoders);
+
+    QByteArray operator()(const QPair<int,int> &block) const;
+
+private:
+    QDltFile *qDltFile;
+    const QVector<int> *positions;
+    DecoderDispatch *decoders;
+};
+
+//! Export messages to an ASCII file in the background.
+/*!
+  Blocks of messages are formatted in parallel by worker threads,
+  while this thread writes the formatted blocks in order.
+*/
+class ThreadExport : public QThread
+{
+    Q_OBJECT
+public:
+    ThreadExport(QObject *parent = 0);
+
+    void setQDltFile(QDltFile *_qDltFile);
+    void setActiveDecoderPlugins(QList<PluginItem*> _activeDecoderPlugins);
+    void setPositions(const QVector<int> &_positions);
+    void setFileName(QString _fileName);
+
+    QString getFileName() { return fileName; }
+    QString getError() { return error; }
+    int getCount() { return count; }
+    bool wasStopped() { return stopExecution; }
+
+protected:
+    void run();
+
+private:
+    int nextBlocks(QList<QPair<int,int> > &blocks, int pos);
+
+    QDltFile *qDltFile;
+    DecoderDispatch decoders;
+    QVector<int> positions;
+    QString fileName;
+    QString error;
+    int count;
+
+    volatile bool stopExecution;
+
+signals:
+    void percentageComplete(int num);
+
+public slots:
+    void stopProcessMsg();
+
+};
+
+#endif // THREADEXPORT_H
@@ -1,4 +1,37 @@
 #include "threadfilter.h"
+#include <QtConcurrentMap>
+
+/* Number of messages decoded and filtered by one worker job. */
+#define FILTER_BLOCK_SIZE 256
+
+ThreadFilterMatcher::ThreadFilterMatcher(QDltFile *_qDltFile, DecoderDispatch *_decoders) :
+    qDltFile(_qDltFile), decoders(_decoders)
+{
+}
+
+QVector<int> ThreadFilterMatcher::operator()(const QPair<int,int> &block) const
+{
+    QVector<QDltMsg> msgs(block.second-block.first);
+    QVector<int> matches;
+
+    /* decode a block of messages at once, plugins can decode batches */
+    QList<QDltMsg*> batch;
+    QVector<int> indexes;
+    for(int num=block.first;num<block.second;num++) {
+        QDltMsg &msg = msgs[num-block.first];
+        msg.setMsg(qDltFile->getMsg(num));
+        batch.append(&msg);
+        indexes.append(num);
+    }
+    decoders->decodeMsgs(batch,0,indexes);
+
+    for(int num=block.first;num<block.second;num++) {
+        if(qDltFile->checkFilter(msgs[num-block.first]))
+            matches.append(num);
+    }
+
+    return matches;
+}
 
 ThreadFilter::ThreadFilter(QObject *parent) :
     QThread(parent), stopExecution(false)
@@ -18,45 +51,35 @@ void ThreadFilter::run(){
         return;
     }
 
-    QDltMsg msg;
-    QByteArray data;
-
-    for(int num=startIndex;num<stopIndex;num++) {
-
-        data = qDltFile->getMsg(num);
-        if(data.isEmpty()){
-            //qDebug()<<"Error: getMsg in thread for plugins failed for num: " << num;
-            //break;
+    DecoderDispatch decoderDispatch;
+    decoderDispatch.setPlugins(*activeDecoderPlugins);
+    ThreadFilterMatcher matcher(qDltFile,&decoderDispatch);
+    int jobs = qMax(QThread::idealThreadCount(),1) * 4;
+
+    for(int pos=startIndex;pos<stopIndex && !stopExecution;) {
+        QList<QPair<int,int> > blocks;
+        for(int num=0;num<jobs && pos<stopIndex;num++) {
+            int end = qMin(pos+FILTER_BLOCK_SIZE,stopIndex);
+            blocks.append(qMakePair(pos,end));
+            pos = end;
         }
-        msg.setMsg(data);
-        //msg.setMsg(qDltFile->getMsg(num));
 
-        for(int i = 0; i < activeDecoderPlugins->size(); i++)
-        {
-            item = (PluginItem*)activeDecoderPlugins->at(i);
+        QFuture<QVector<int> > future = QtConcurrent::mapped(blocks,matcher);
+        future.waitForFinished();
 
-            if(item->plugindecoderinterface->isMsg(msg,0))
-            {
-
-                item->plugindecoderinterface->decodeMsg(msg,0);
-                break;
-            }
+        /* the results are in order of the blocks, they are ordered by time once at the end */
+        QList<QVector<int> > matches = future.results();
+        for(int block=0;block<matches.size();block++) {
+            for(int num=0;num<matches[block].size();num++)
+                qDltFile->addFilterIndex(matches[block][num]);
         }
 
-        if(qDltFile->checkFilter(msg)) {
-            qDltFile->addFilterIndex(num);
-        }
-
-        if((num%((stopIndex/200)+1))==0)
-        {
-            emit percentageComplete(num);
-            emit updateProgressText(QString("Applying filters for message %1/%2").arg(num).arg(stopIndex));
-        }
-
-        if(stopExecution)
-            break;
+        emit percentageComplete(pos);
+        emit updateProgressText(QString("Applying filters for message %1/%2").arg(pos).arg(stopIndex));
     }
 
+    qDltFile->sortFilterIndex();
+
     qDebug() << "Finished Thread";
 }
 
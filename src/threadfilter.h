@@ -5,6 +5,28 @@
 #include "qdlt.h"
 #include "project.h"
 #include "plugininterface.h"
+#include "decoderdispatch.h"
+
+//! Decode and filter the messages of one block, called in parallel by the worker threads.
+class ThreadFilterMatcher
+{
+public:
+    typedef QVector<int> result_type;
+
+    ThreadFilterMatcher(QDltFile *_qDltFile, DecoderDispatch *_decoders);
+
+    QVector<int> operator()(const QPair<int,int> &block) const;
+
+private:
+    QDltFile *qDltFile;
+    DecoderDispatch *decoders;
+};
+
+//! Apply the filters to a log file in the background.
+/*!
+  Blocks of messages are decoded and filtered in parallel by worker threads,
+  while this thread adds the matching messages in order to the filter index.
+*/
 class ThreadFilter : public QThread
 {
     Q_OBJECT
@@ -21,13 +43,12 @@ protected:
 
 private:
     QDltFile *qDltFile;
-    PluginItem *item;
     QList<PluginItem*> *activeDecoderPlugins;
 
     int startIndex;
     int stopIndex;
 
-    bool stopExecution;
+    volatile bool stopExecution;
 
 signals:
     void updateProgressText(QString str);
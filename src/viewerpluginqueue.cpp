@@ -0,0 +1,231 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file viewerpluginqueue.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QTimer>
+
+#include "viewerpluginqueue.h"
+
+ViewerPluginQueue::ViewerPluginQueue(const QString &name, QDltPluginViewerInterface *viewer, QDltPluginViewerAsyncInterface *async, QObject *parent) :
+    QThread(parent), viewer(viewer), async(async)
+{
+    profileWait = QString("Viewer queue full: %1").arg(name);
+    profileBatch = QString("Viewer batch: %1").arg(name);
+
+    capacity = qMax(async->queueSize(),1);
+    busy = false;
+    stopping = false;
+    updatePending = false;
+
+    maxDepth = 0;
+    waits = 0;
+    delivered = 0;
+
+    /* the update is requested by the worker thread and processed in the GUI thread */
+    connect(this, SIGNAL(updateRequested()), this, SLOT(processUpdate()), Qt::QueuedConnection);
+}
+
+ViewerPluginQueue::~ViewerPluginQueue()
+{
+    mutex.lock();
+    stopping = true;
+    notEmpty.wakeAll();
+    notFull.wakeAll();
+    mutex.unlock();
+
+    wait();
+}
+
+void ViewerPluginQueue::addInitMsg(int index, const QDltMsg &msg, const QDltMsg &decoded)
+{
+    Entry entry;
+    entry.index = index;
+    entry.update = false;
+    entry.msg = msg;
+    entry.decoded = decoded;
+    add(entry);
+}
+
+void ViewerPluginQueue::addUpdateMsg(int index, const QDltMsg &msg, const QDltMsg &decoded)
+{
+    Entry entry;
+    entry.index = index;
+    entry.update = true;
+    entry.msg = msg;
+    entry.decoded = decoded;
+    add(entry);
+}
+
+void ViewerPluginQueue::add(const Entry &entry)
+{
+    QMutexLocker locker(&mutex);
+
+    if(queue.size() >= capacity)
+    {
+        /* backpressure, the plugin does not keep up with the messages */
+        QDltProfilerScope profile(profileWait);
+        waits++;
+        while(queue.size() >= capacity && !stopping)
+            notFull.wait(&mutex);
+    }
+
+    if(stopping)
+        return;
+
+    queue.append(entry);
+    maxDepth = qMax(maxDepth,queue.size());
+    notEmpty.wakeOne();
+}
+
+void ViewerPluginQueue::flush()
+{
+    QMutexLocker locker(&mutex);
+
+    while((!queue.isEmpty() || busy) && !stopping)
+        idle.wait(&mutex);
+}
+
+void ViewerPluginQueue::clear()
+{
+    QMutexLocker locker(&mutex);
+
+    queue.clear();
+    notFull.wakeAll();
+
+    while(busy && !stopping)
+        idle.wait(&mutex);
+}
+
+int ViewerPluginQueue::getDepth()
+{
+    QMutexLocker locker(&mutex);
+    return queue.size();
+}
+
+int ViewerPluginQueue::getMaxDepth()
+{
+    QMutexLocker locker(&mutex);
+    return maxDepth;
+}
+
+qint64 ViewerPluginQueue::getWaits()
+{
+    QMutexLocker locker(&mutex);
+    return waits;
+}
+
+qint64 ViewerPluginQueue::getDelivered()
+{
+    QMutexLocker locker(&mutex);
+    return delivered;
+}
+
+void ViewerPluginQueue::run()
+{
+    forever
+    {
+        QList<Entry> batch;
+
+        mutex.lock();
+        while(queue.isEmpty() && !stopping)
+            notEmpty.wait(&mutex);
+        if(stopping)
+        {
+            mutex.unlock();
+            break;
+        }
+        batch = queue;
+        queue.clear();
+        busy = true;
+        notFull.wakeAll();
+        mutex.unlock();
+
+        deliver(batch);
+
+        mutex.lock();
+        busy = false;
+        delivered += batch.size();
+        bool request = !updatePending;
+        updatePending = true;
+        if(queue.isEmpty())
+            idle.wakeAll();
+        mutex.unlock();
+
+        if(request)
+            emit updateRequested();
+    }
+}
+
+void ViewerPluginQueue::deliver(QList<Entry> &batch)
+{
+    QDltProfilerScope profile(profileBatch,batch.size());
+    bool updating = false;
+
+    for(int num=0;num<batch.size();num++)
+    {
+        Entry &entry = batch[num];
+
+        if(entry.update)
+        {
+            /* received messages of a batch are enclosed in updateFileStart() and updateFileFinish() */
+            if(!updating)
+            {
+                viewer->updateFileStart();
+                updating = true;
+            }
+            viewer->updateMsg(entry.index,entry.msg);
+            viewer->updateMsgDecoded(entry.index,entry.decoded);
+        }
+        else
+        {
+            if(updating)
+            {
+                viewer->updateFileFinish();
+                updating = false;
+            }
+            viewer->initMsg(entry.index,entry.msg);
+            viewer->initMsgDecoded(entry.index,entry.decoded);
+        }
+    }
+
+    if(updating)
+        viewer->updateFileFinish();
+}
+
+void ViewerPluginQueue::processUpdate()
+{
+    int interval = async->updateInterval();
+
+    /* limit the updates of the widgets to the interval of the plugin */
+    if(lastUpdate.isValid())
+    {
+        qint64 elapsed = lastUpdate.elapsed();
+        if(elapsed < interval)
+        {
+            QTimer::singleShot(interval - (int)elapsed, this, SLOT(processUpdate()));
+            return;
+        }
+    }
+
+    mutex.lock();
+    updatePending = false;
+    mutex.unlock();
+
+    lastUpdate.start();
+    async->updateViewer();
+}
@@ -0,0 +1,128 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file viewerpluginqueue.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef VIEWERPLUGINQUEUE_H
+#define VIEWERPLUGINQUEUE_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+
+#include "qdlt.h"
+#include "plugininterface.h"
+
+//! Deliver the messages to a viewer plugin in its own worker thread.
+/*!
+  Used for viewer plugins implementing QDltPluginViewerAsyncInterface.
+  The GUI thread adds the messages to a bounded queue and only waits when the
+  queue is full. The worker thread passes the queued messages in batches to the
+  plugin and requests a GUI update, which is limited to the update interval of
+  the plugin.
+
+  The time the GUI thread waited for a full queue and the time of each batch are
+  added to the profiler counters "Viewer queue full" and "Viewer batch".
+*/
+class ViewerPluginQueue : public QThread
+{
+    Q_OBJECT
+public:
+    ViewerPluginQueue(const QString &name, QDltPluginViewerInterface *viewer, QDltPluginViewerAsyncInterface *async, QObject *parent = 0);
+    ~ViewerPluginQueue();
+
+    //! Queue a message passed to initMsg() and initMsgDecoded() of the plugin.
+    /*!
+      \param index the number of the message in the log file
+      \param msg the undecoded message
+      \param decoded the decoded message
+    */
+    void addInitMsg(int index, const QDltMsg &msg, const QDltMsg &decoded);
+
+    //! Queue a message passed to updateMsg() and updateMsgDecoded() of the plugin.
+    /*!
+      \param index the number of the message in the log file
+      \param msg the undecoded message
+      \param decoded the decoded message
+    */
+    void addUpdateMsg(int index, const QDltMsg &msg, const QDltMsg &decoded);
+
+    //! Wait until all queued messages were passed to the plugin.
+    void flush();
+
+    //! Drop all queued messages and wait until the current batch was passed to the plugin.
+    void clear();
+
+    //! Number of messages currently queued.
+    int getDepth();
+
+    //! Maximum number of messages queued at once.
+    int getMaxDepth();
+
+    //! Number of times the queue was full and the GUI thread had to wait.
+    qint64 getWaits();
+
+    //! Number of messages passed to the plugin.
+    qint64 getDelivered();
+
+signals:
+    void updateRequested();
+
+private slots:
+    void processUpdate();
+
+protected:
+    void run();
+
+private:
+    typedef struct
+    {
+        int index;
+        bool update;
+        QDltMsg msg;
+        QDltMsg decoded;
+    } Entry;
+
+    void add(const Entry &entry);
+    void deliver(QList<Entry> &batch);
+
+    QDltPluginViewerInterface *viewer;
+    QDltPluginViewerAsyncInterface *async;
+
+    /* names of the profiler counters */
+    QString profileWait;
+    QString profileBatch;
+
+    QMutex mutex;
+    QWaitCondition notEmpty;
+    QWaitCondition notFull;
+    QWaitCondition idle;
+    QList<Entry> queue;
+    int capacity;
+    bool busy;
+    bool stopping;
+    bool updatePending;
+
+    int maxDepth;
+    qint64 waits;
+    qint64 delivered;
+
+    QElapsedTimer lastUpdate;
+};
+
+#endif // VIEWERPLUGINQUEUE_H
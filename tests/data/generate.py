@@ -0,0 +1,161 @@
+# @licence app begin@
+# Copyright (C) 2011-2012  BMW AG
+#
+# This file is part of GENIVI Project Dlt Viewer.
+#
+# Contributions are licensed to the GENIVI Alliance under one or more
+# Contribution License Agreements.
+#
+# \copyright
+# This Source Code Form is subject to the terms of the
+# Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+# this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# \file generate.py
+# For further information see http://www.genivi.org/.
+# @licence end@
+
+# Writes the golden file messages.dlt and the expected text messages.txt.
+# The expected text is written down by hand for each message and is not
+# derived from the viewer code, so both files only have to be regenerated
+# when a message is added. The times are formatted in UTC.
+#
+# Usage: python generate.py
+
+import os
+import struct
+
+HTYP_UEH = 0x01
+HTYP_MSBF = 0x02
+HTYP_WEID = 0x04
+HTYP_WSID = 0x08
+HTYP_WTMS = 0x10
+HTYP_VERSION1 = 0x20
+
+MSIN_VERB = 0x01
+
+TYPE_BOOL = 0x10
+TYPE_SINT = 0x20
+TYPE_UINT = 0x40
+TYPE_FLOA = 0x80
+TYPE_STRG = 0x200
+TYPE_RAWD = 0x400
+
+TYLE = {1: 1, 2: 2, 4: 3, 8: 4, 16: 5}
+
+
+def ident(text):
+    return text.encode("ascii").ljust(4, b"\0")
+
+
+def argument(bigendian, typeinfo, data, size=None):
+    order = ">" if bigendian else "<"
+    if typeinfo in (TYPE_STRG, TYPE_RAWD):
+        return struct.pack(order + "IH", typeinfo, len(data)) + data
+    if typeinfo != TYPE_BOOL:
+        typeinfo |= TYLE[size]
+    return struct.pack(order + "I", typeinfo) + data
+
+
+def message(seconds, microseconds, ecu, counter, payload, bigendian=False,
+            extended=None, session=None, timestamp=None, headerecu=None):
+    htyp = HTYP_VERSION1
+    extra = b""
+    if bigendian:
+        htyp |= HTYP_MSBF
+    if headerecu is not None:
+        htyp |= HTYP_WEID
+        extra += ident(headerecu)
+    if session is not None:
+        htyp |= HTYP_WSID
+        extra += struct.pack(">I", session)
+    if timestamp is not None:
+        htyp |= HTYP_WTMS
+        extra += struct.pack(">I", timestamp)
+    if extended is not None:
+        htyp |= HTYP_UEH
+        msin, noar, apid, ctid = extended
+        extra += struct.pack("<BB", msin, noar) + ident(apid) + ident(ctid)
+    length = 4 + len(extra) + len(payload)
+    storage = b"DLT\x01" + struct.pack("<Ii", seconds, microseconds) + ident(ecu)
+    standard = struct.pack(">BBH", htyp, counter, length)
+    return storage + standard + extra + payload
+
+
+def verbose(msgtype, subtype, noar, apid, ctid):
+    return (MSIN_VERB | (msgtype << 1) | (subtype << 4), noar, apid, ctid)
+
+
+MESSAGES = [
+    (
+        message(1300000000, 1234, "ECU1", 0,
+                argument(False, TYPE_STRG, b"Hello\0") +
+                argument(False, TYPE_UINT, struct.pack("<I", 42), 4) +
+                argument(False, TYPE_SINT, struct.pack("<i", -7), 4) +
+                argument(False, TYPE_BOOL, b"\x01"),
+                extended=verbose(0, 4, 4, "APP1", "CON1"),
+                session=1, timestamp=123456, headerecu="ECU1"),
+        "2011/03/13 07:06:40.001234 12.3456 0 ECU1 APP1 CON1 log info verbose 4 "
+        "Hello 42 -7 true",
+    ),
+    (
+        message(1300000000, 500000, "ECU1", 1,
+                argument(True, TYPE_UINT, struct.pack(">H", 0x1234), 2) +
+                argument(True, TYPE_STRG, b"big\0") +
+                argument(True, TYPE_SINT, struct.pack(">b", -1), 1) +
+                argument(True, TYPE_BOOL, b"\x00"),
+                bigendian=True, extended=verbose(0, 3, 4, "APP1", "CON2"),
+                session=1, timestamp=10000, headerecu="ECU1"),
+        "2011/03/13 07:06:40.500000 1.0000 1 ECU1 APP1 CON2 log warn verbose 4 "
+        "4660 big -1 false",
+    ),
+    (
+        message(1300000001, 0, "ECU1", 2,
+                argument(False, TYPE_RAWD, b"\x01\x02\xab") +
+                argument(False, TYPE_FLOA, struct.pack("<d", 1.5), 8) +
+                argument(False, TYPE_FLOA, struct.pack("<f", 0.25), 4) +
+                argument(False, TYPE_UINT, struct.pack("<Q", 18446744073709551615), 8) +
+                argument(False, TYPE_SINT, struct.pack("<q", -9000000000), 8),
+                extended=verbose(1, 2, 5, "TRC", "FN"),
+                session=7, timestamp=0, headerecu="ECU1"),
+        "2011/03/13 07:06:41.000000 0.0000 2 ECU1 TRC FN app_trace func_in verbose 5 "
+        "01 02 ab 1.5 0.25 18446744073709551615 -9000000000",
+    ),
+    (
+        message(1300000001, 999999, "ECU2", 3,
+                struct.pack("<I", 16) + b"AB\x01",
+                timestamp=5),
+        "2011/03/13 07:06:41.999999 0.0005 3 ECU2     non-verbose 0 "
+        "[16] AB-|41 42 01",
+    ),
+    (
+        message(1300003600, 10, "ECU1", 4,
+                struct.pack("<I", 3) + b"AB",
+                extended=((3 << 1) | (1 << 4), 0, "DA1", "DC1"),
+                session=0, timestamp=20000, headerecu="ECU1"),
+        "2011/03/13 08:06:40.000010 2.0000 4 ECU1 DA1 DC1 control request non-verbose 0 "
+        "[get_log_info] 41 42",
+    ),
+    (
+        message(1300003600, 20, "ECU1", 255,
+                struct.pack("<I", 4) + b"\x00\x05\x06",
+                extended=((3 << 1) | (2 << 4), 0, "DA1", "DC1"),
+                session=0, timestamp=20001, headerecu="ECU1"),
+        "2011/03/13 08:06:40.000020 2.0001 255 ECU1 DA1 DC1 control response non-verbose 0 "
+        "[get_default_log_level ok] 06",
+    ),
+]
+
+
+def main():
+    directory = os.path.dirname(os.path.abspath(__file__))
+    with open(os.path.join(directory, "messages.dlt"), "wb") as dlt:
+        for data, _ in MESSAGES:
+            dlt.write(data)
+    with open(os.path.join(directory, "messages.txt"), "w") as txt:
+        for _, text in MESSAGES:
+            txt.write(text + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,39 @@
+# libFuzzer harnesses of the qdlt library. They need clang and a qdlt
+# library built with coverage instrumentation, so the whole tree is built
+# with the fuzzer configuration:
+#
+#   qmake -r CONFIG+=fuzzer QMAKE_CC=clang QMAKE_CXX=clang++ QMAKE_LINK=clang++ BuildDltViewer.pro
+#   make
+#   ./release/fuzz_setmsg -max_len=65536 corpus/
+#
+# The golden file tests/data/messages.dlt is a good seed of the corpus.
+
+TEMPLATE  = app
+
+CONFIG   += console
+CONFIG   -= app_bundle
+QT       += network
+
+QMAKE_CXXFLAGS += -fsanitize=fuzzer,address
+QMAKE_LFLAGS   += -fsanitize=fuzzer,address
+
+CONFIG(debug, debug|release) {
+    DESTDIR = ../../debug
+    QMAKE_LIBDIR += ../../debug
+    LIBS += -lqdltd
+}
+else {
+    DESTDIR = ../../release
+    QMAKE_LIBDIR += ../../release
+    LIBS += -lqdlt
+}
+
+unix:QMAKE_RPATHDIR += $$OUT_PWD/$$DESTDIR
+
+OBJECTS_DIR = build/obj_$$TARGET
+
+# Defines and Header Directories
+DEFINES  += QT_VIEWER
+
+INCLUDEPATH += ../../qdlt \
+            ../../qextserialport/src
@@ -0,0 +1,3 @@
+#
+TEMPLATE = subdirs
+SUBDIRS  += fuzz_setmsg.pro fuzz_setargument.pro fuzz_parse.pro
@@ -0,0 +1,50 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file fuzz_parse.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+/* libFuzzer harness of QDltConnection::parse(). The first byte selects
+   if the connection syncs to the serial header, the rest is received at
+   once and parsed until the buffer does not shrink anymore. */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "qdlt.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data,size_t size)
+{
+    if(size < 1)
+        return 0;
+
+    QByteArray bytes((const char*)data+1,(int)size-1);
+    QDltConnection connection;
+    QDltMsg msg;
+    QString text;
+    int left;
+
+    connection.setSyncSerialHeader(data[0] & 1);
+    connection.add(bytes);
+
+    do {
+        left = connection.data.size();
+        if(connection.parse(msg))
+            msg.toStringPayload(text);
+    } while(!connection.data.isEmpty() && connection.data.size() < left);
+
+    return 0;
+}
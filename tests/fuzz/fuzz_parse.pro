@@ -0,0 +1,6 @@
+TARGET    = fuzz_parse
+
+include(fuzz.pri)
+
+# Project files
+SOURCES += fuzz_parse.cpp
@@ -0,0 +1,48 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file fuzz_setargument.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+/* libFuzzer harness of QDltArgument::setArgument(). The first byte selects
+   the byte order, the rest is parsed as verbose payload until an argument
+   is invalid. */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "qdlt.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data,size_t size)
+{
+    if(size < 1)
+        return 0;
+
+    QByteArray payload((const char*)data+1,(int)size-1);
+    QDlt::DltEndiannessDef endianness = (data[0] & 1) ? QDlt::DltEndiannessBigEndian : QDlt::DltEndiannessLittleEndian;
+    QDltArgument argument;
+    QByteArray out;
+    QString text;
+    unsigned int offset = 0;
+
+    while(argument.setArgument(payload,offset,endianness)) {
+        argument.toString(text);
+        argument.getValue();
+        argument.getArgument(out,true);
+    }
+
+    return 0;
+}
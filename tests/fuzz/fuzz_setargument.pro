@@ -0,0 +1,6 @@
+TARGET    = fuzz_setargument
+
+include(fuzz.pri)
+
+# Project files
+SOURCES += fuzz_setargument.cpp
@@ -0,0 +1,45 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file fuzz_setmsg.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+/* libFuzzer harness of QDltMsg::setMsg(). The input is parsed as message
+   with and without storage header, valid messages are formatted as text and
+   written again with getMsg(). */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "qdlt.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data,size_t size)
+{
+    QByteArray buf((const char*)data,(int)size);
+    QByteArray out;
+    QString text;
+    QDltMsg msg;
+
+    for(int withStorageHeader=0;withStorageHeader<2;withStorageHeader++) {
+        if(msg.setMsg(buf,withStorageHeader)) {
+            msg.toStringHeader(text);
+            msg.toStringPayload(text);
+            msg.getMsg(out);
+        }
+    }
+
+    return 0;
+}
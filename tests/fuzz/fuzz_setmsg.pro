@@ -0,0 +1,6 @@
+TARGET    = fuzz_setmsg
+
+include(fuzz.pri)
+
+# Project files
+SOURCES += fuzz_setmsg.cpp
@@ -0,0 +1,32 @@
+TEMPLATE  = app
+TARGET    = qdlt-test
+
+CONFIG   += console testcase
+CONFIG   -= app_bundle
+QT       += network testlib
+
+CONFIG(debug, debug|release) {
+    DESTDIR = ../debug
+    QMAKE_LIBDIR += ../debug
+    LIBS += -lqdltd
+}
+else {
+    DESTDIR = ../release
+    QMAKE_LIBDIR += ../release
+    LIBS += -lqdlt
+}
+
+unix:QMAKE_RPATHDIR += $$OUT_PWD/$$DESTDIR
+
+OBJECTS_DIR = build/obj
+MOC_DIR     = build/moc
+
+# Defines and Header Directories
+DEFINES  += QT_VIEWER
+DEFINES  += TESTDATA_DIR=\\\"$$PWD/data\\\"
+
+INCLUDEPATH += ../qdlt \
+            ../qextserialport/src
+
+# Project files
+SOURCES += tst_qdlt.cpp
@@ -0,0 +1,6 @@
+#
+TEMPLATE = subdirs
+SUBDIRS  += qdlt-test.pro
+
+# the fuzzers are only built with CONFIG+=fuzzer, see fuzz/fuzz.pri
+fuzzer:SUBDIRS += fuzz
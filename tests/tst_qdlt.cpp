@@ -0,0 +1,336 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file tst_qdlt.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+/* Tests of the message parsing and formatting of the qdlt library.
+
+   The golden file data/messages.dlt is read with QDltFile and QDltConnection
+   and compared with the expected text in data/messages.txt, both files are
+   written by data/generate.py. The round trip tests generate random verbose
+   messages, parse them with setMsg(), write them again with getMsg() and
+   check that the bytes and the parsed contents are the same. */
+
+#include <QtTest>
+#include <QFile>
+#include <QStringList>
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "qdlt.h"
+
+extern "C"
+{
+    #include "dlt_common.h"
+}
+
+/* Number of random messages of each round trip test. */
+static const int QDLT_TEST_ROUNDS = 2000;
+
+/* Seed of the random messages, so failures can be reproduced. */
+static const uint QDLT_TEST_SEED = 1;
+
+/* Write integers in the byte order of the message. */
+static void appendUInt16(QByteArray &buf,quint16 value,bool bigEndian)
+{
+    if(bigEndian) {
+        buf += (char)(value >> 8);
+        buf += (char)value;
+    }
+    else {
+        buf += (char)value;
+        buf += (char)(value >> 8);
+    }
+}
+
+static void appendUInt32(QByteArray &buf,quint32 value,bool bigEndian)
+{
+    if(bigEndian) {
+        appendUInt16(buf,value >> 16,true);
+        appendUInt16(buf,value,true);
+    }
+    else {
+        appendUInt16(buf,value,false);
+        appendUInt16(buf,value >> 16,false);
+    }
+}
+
+static QByteArray randomBytes(int size)
+{
+    QByteArray bytes;
+
+    for(int num=0;num<size;num++)
+        bytes += (char)(qrand() & 0xff);
+
+    return bytes;
+}
+
+/* Random ECU, application or context id with one to four characters. */
+static QByteArray randomId()
+{
+    QByteArray id;
+    int size = 1 + qrand()%4;
+
+    for(int num=0;num<4;num++)
+        id += (num < size) ? (char)('A' + qrand()%26) : '\0';
+
+    return id;
+}
+
+/* Argument in the layout written by QDltArgument::getArgument(). */
+static QByteArray randomArgument(int typeInfo,bool bigEndian)
+{
+    static const int integerSizes[] = {1,2,4,8,16};
+    static const int floatSizes[] = {4,8};
+    QByteArray argument;
+    QByteArray data;
+    unsigned int dltType = 0;
+    int size = 0;
+
+    switch(typeInfo) {
+    case QDltArgument::DltTypeInfoStrg:
+        for(int num=qrand()%40;num>0;num--)
+            data += (char)(' ' + qrand()%95);
+        data += '\0';
+        dltType = DLT_TYPE_INFO_STRG;
+        break;
+    case QDltArgument::DltTypeInfoBool:
+        data += (char)(qrand()%2);
+        dltType = DLT_TYPE_INFO_BOOL;
+        break;
+    case QDltArgument::DltTypeInfoSInt:
+    case QDltArgument::DltTypeInfoUInt:
+        size = integerSizes[qrand()%5];
+        dltType = (typeInfo == QDltArgument::DltTypeInfoSInt) ? DLT_TYPE_INFO_SINT : DLT_TYPE_INFO_UINT;
+        break;
+    case QDltArgument::DltTypeInfoFloa:
+        size = floatSizes[qrand()%2];
+        dltType = DLT_TYPE_INFO_FLOA;
+        break;
+    case QDltArgument::DltTypeInfoRawd:
+        data = randomBytes(qrand()%40);
+        dltType = DLT_TYPE_INFO_RAWD;
+        break;
+    }
+
+    if(size) {
+        data = randomBytes(size);
+        switch(size) {
+        case 1:  dltType |= DLT_TYLE_8BIT;   break;
+        case 2:  dltType |= DLT_TYLE_16BIT;  break;
+        case 4:  dltType |= DLT_TYLE_32BIT;  break;
+        case 8:  dltType |= DLT_TYLE_64BIT;  break;
+        case 16: dltType |= DLT_TYLE_128BIT; break;
+        }
+    }
+
+    appendUInt32(argument,dltType,bigEndian);
+    if(typeInfo == QDltArgument::DltTypeInfoStrg || typeInfo == QDltArgument::DltTypeInfoRawd)
+        appendUInt16(argument,data.size(),bigEndian);
+    argument += data;
+
+    return argument;
+}
+
+/* Verbose message with storage header in the layout written by QDltMsg::getMsg(). */
+static QByteArray randomMessage(const QList<int> &types,bool bigEndian)
+{
+    QByteArray ecu = randomId();
+    QByteArray payload;
+    QByteArray buf;
+
+    foreach(int typeInfo,types)
+        payload += randomArgument(typeInfo,bigEndian);
+
+    /* storage header */
+    buf += QByteArray("DLT\x01",4);
+    appendUInt32(buf,qrand(),false);
+    appendUInt32(buf,qrand()%1000000,false);
+    buf += ecu;
+
+    /* standard header and standard header extra */
+    buf += (char)(DLT_HTYP_PROTOCOL_VERSION1 | DLT_HTYP_UEH | DLT_HTYP_WEID | DLT_HTYP_WSID | DLT_HTYP_WTMS |
+                  (bigEndian ? DLT_HTYP_MSBF : 0));
+    buf += (char)(qrand() & 0xff);
+    appendUInt16(buf,4 + DLT_SIZE_WEID + DLT_SIZE_WSID + DLT_SIZE_WTMS + 10 + payload.size(),true);
+    buf += ecu;
+    appendUInt32(buf,qrand(),true);
+    appendUInt32(buf,qrand(),true);
+
+    /* extended header */
+    buf += (char)(DLT_MSIN_VERB | ((qrand()%4) << DLT_MSIN_MSTP_SHIFT) | ((qrand()%16) << DLT_MSIN_MTIN_SHIFT));
+    buf += (char)types.size();
+    buf += randomId();
+    buf += randomId();
+
+    buf += payload;
+
+    return buf;
+}
+
+class TestQDlt : public QObject
+{
+    Q_OBJECT
+
+private:
+    QStringList readExpected();
+
+private slots:
+    void initTestCase();
+    void goldenFile();
+    void goldenConnection();
+    void roundTrip_data();
+    void roundTrip();
+};
+
+QStringList TestQDlt::readExpected()
+{
+    QFile file(QString(TESTDATA_DIR) + "/messages.txt");
+
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return QStringList();
+
+    return QString(file.readAll()).split('\n',QString::SkipEmptyParts);
+}
+
+void TestQDlt::initTestCase()
+{
+    /* the expected times are written in UTC */
+    qputenv("TZ","UTC");
+    tzset();
+}
+
+void TestQDlt::goldenFile()
+{
+    QDltFile file;
+    QDltMsg msg;
+    QStringList expected = readExpected();
+
+    QVERIFY(!expected.isEmpty());
+    QVERIFY(file.open(QString(TESTDATA_DIR) + "/messages.dlt"));
+    QVERIFY(file.createIndex());
+    QCOMPARE(file.size(),expected.size());
+
+    for(int num=0;num<file.size();num++) {
+        QVERIFY(file.getMsg(num,msg));
+        QCOMPARE(msg.toStringHeader() + " " + msg.toStringPayload(),expected[num]);
+    }
+}
+
+void TestQDlt::goldenConnection()
+{
+    QDltFile file;
+    QDltMsg msg;
+    QDltMsg expected;
+    QDltConnection connection;
+    QByteArray garbage("garbage");
+    QByteArray stream = garbage;
+
+    QVERIFY(file.open(QString(TESTDATA_DIR) + "/messages.dlt"));
+    QVERIFY(file.createIndex());
+
+    /* the messages are received with serial header instead of storage header */
+    for(int num=0;num<file.size();num++) {
+        stream += QByteArray("DLS\x01",4);
+        stream += file.getMsg(num).mid(sizeof(DltStorageHeader));
+    }
+
+    connection.setSyncSerialHeader(true);
+    connection.add(stream);
+
+    for(int num=0;num<file.size();num++) {
+        QVERIFY(connection.parse(msg));
+        QVERIFY(file.getMsg(num,expected));
+        QCOMPARE(msg.getMessageCounter(),expected.getMessageCounter());
+        QCOMPARE(msg.getApid(),expected.getApid());
+        QCOMPARE(msg.getCtid(),expected.getCtid());
+        QCOMPARE(msg.toStringPayload(),expected.toStringPayload());
+    }
+
+    QVERIFY(!connection.parse(msg));
+    QVERIFY(connection.data.isEmpty());
+    QCOMPARE(connection.bytesError,(unsigned long)garbage.size());
+}
+
+void TestQDlt::roundTrip_data()
+{
+    QTest::addColumn<int>("typeInfo");
+    QTest::addColumn<bool>("bigEndian");
+
+    static const int types[] = {QDltArgument::DltTypeInfoStrg,QDltArgument::DltTypeInfoBool,
+                                QDltArgument::DltTypeInfoSInt,QDltArgument::DltTypeInfoUInt,
+                                QDltArgument::DltTypeInfoFloa,QDltArgument::DltTypeInfoRawd};
+    static const char *names[] = {"String","Bool","SignedInteger","UnsignedInteger","Float","RawData"};
+
+    for(int num=0;num<6;num++) {
+        QTest::newRow(QByteArray(names[num]) + " little-endian") << types[num] << false;
+        QTest::newRow(QByteArray(names[num]) + " big-endian") << types[num] << true;
+    }
+
+    /* -1 mixes all types in one message */
+    QTest::newRow("mixed little-endian") << -1 << false;
+    QTest::newRow("mixed big-endian") << -1 << true;
+}
+
+void TestQDlt::roundTrip()
+{
+    QFETCH(int,typeInfo);
+    QFETCH(bool,bigEndian);
+
+    static const int types[] = {QDltArgument::DltTypeInfoStrg,QDltArgument::DltTypeInfoBool,
+                                QDltArgument::DltTypeInfoSInt,QDltArgument::DltTypeInfoUInt,
+                                QDltArgument::DltTypeInfoFloa,QDltArgument::DltTypeInfoRawd};
+
+    qsrand(QDLT_TEST_SEED);
+
+    for(int round=0;round<QDLT_TEST_ROUNDS;round++) {
+        QList<int> argumentTypes;
+        for(int num=1+qrand()%8;num>0;num--)
+            argumentTypes.append((typeInfo == -1) ? types[qrand()%6] : typeInfo);
+
+        QByteArray buf = randomMessage(argumentTypes,bigEndian);
+        QByteArray buf2;
+        QDltMsg msg;
+        QDltMsg msg2;
+
+        QVERIFY(msg.setMsg(buf));
+        QCOMPARE((int)msg.getNumberOfArguments(),argumentTypes.size());
+        QVERIFY(msg.getMsg(buf2));
+        QCOMPARE(buf2.toHex(),buf.toHex());
+
+        QVERIFY(msg2.setMsg(buf2));
+        QCOMPARE(msg2.toStringHeader(),msg.toStringHeader());
+        QCOMPARE(msg2.toStringPayload(),msg.toStringPayload());
+        QCOMPARE(msg2.getNumberOfArguments(),msg.getNumberOfArguments());
+
+        for(int num=0;num<argumentTypes.size();num++) {
+            QDltArgument argument;
+            QDltArgument argument2;
+            QVERIFY(msg.getArgument(num,argument));
+            QVERIFY(msg2.getArgument(num,argument2));
+            QCOMPARE((int)argument.getTypeInfo(),argumentTypes[num]);
+            QCOMPARE((int)argument2.getTypeInfo(),argumentTypes[num]);
+            QCOMPARE(argument2.getData(),argument.getData());
+            QCOMPARE(argument2.toString(),argument.toString());
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(TestQDlt)
+
+#include "tst_qdlt.moc"